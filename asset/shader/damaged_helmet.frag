@@ -10,12 +10,27 @@ in vec3 v_color;
 
 out vec4 FragColor;
 
+#ifdef MATERIAL_TEXTURE_ARRAYS
+// Packed material textures, the layer comes from the material UBO and a
+// negative layer means the material has no such texture
+layout(binding = 0) uniform sampler2DArray u_baseColorTexture;
+layout(binding = 1) uniform sampler2DArray u_metallicRoughnessTexture;
+layout(binding = 2) uniform sampler2DArray u_normalTexture;
+layout(binding = 3) uniform sampler2DArray u_emissiveTexture;
+layout(binding = 4) uniform sampler2DArray u_occlusionTexture;
+
+#define SAMPLE_MATERIAL(tex, layer) \
+  ((layer) >= 0 ? texture(tex, vec3(v_texcoord, float(layer))) : vec4(1.0))
+#else
 layout(binding = 0) uniform sampler2D u_baseColorTexture;
 layout(binding = 1) uniform sampler2D u_metallicRoughnessTexture;
 layout(binding = 2) uniform sampler2D u_normalTexture;
 layout(binding = 3) uniform sampler2D u_emissiveTexture;
 layout(binding = 4) uniform sampler2D u_occlusionTexture;
 
+#define SAMPLE_MATERIAL(tex, layer) texture(tex, v_texcoord)
+#endif
+
 // IBL textures
 layout(binding = 5) uniform samplerCube u_irradianceMap;
 layout(binding = 6) uniform samplerCube u_prefilteredMap;
@@ -36,6 +51,12 @@ layout(std140, binding = 2) uniform MaterialUBO
   vec3 emissiveFactor;
   float metallicFactor;
   float roughnessFactor;
+  // Texture array layers, only used with MATERIAL_TEXTURE_ARRAYS
+  int baseColorLayer;
+  int metallicRoughnessLayer;
+  int normalLayer;
+  int emissiveLayer;
+  int occlusionLayer;
 } u_material;
 
 // UBO for all lighting (fixed maximum size)
@@ -54,13 +75,28 @@ layout(std140, binding = 4) uniform EnvironmentUBO
 
 void main()
 {
-  // Sample textures
-  vec4 baseColor = texture(u_baseColorTexture, v_texcoord) * u_material.baseColorFactor;
-  vec4 metallicRoughness = texture(u_metallicRoughnessTexture, v_texcoord);
-  float metallic = metallicRoughness.b * u_material.metallicFactor;
-  float roughness = metallicRoughness.g * u_material.roughnessFactor;
-  vec3 emissive = texture(u_emissiveTexture, v_texcoord).rgb * u_material.emissiveFactor;
-  float ao = texture(u_occlusionTexture, v_texcoord).r;
+  // Sample the textures the material has, each HAS_*_TEXTURE variant only
+  // pays for its own fetches
+  vec4 baseColor = u_material.baseColorFactor;
+#ifdef HAS_BASE_COLOR_TEXTURE
+  baseColor *= SAMPLE_MATERIAL(u_baseColorTexture, u_material.baseColorLayer);
+#endif
+  float metallic = u_material.metallicFactor;
+  float roughness = u_material.roughnessFactor;
+#ifdef HAS_METALLIC_ROUGHNESS_TEXTURE
+  vec4 metallicRoughness = SAMPLE_MATERIAL(u_metallicRoughnessTexture,
+                                           u_material.metallicRoughnessLayer);
+  metallic *= metallicRoughness.b;
+  roughness *= metallicRoughness.g;
+#endif
+  vec3 emissive = u_material.emissiveFactor;
+#ifdef HAS_EMISSIVE_TEXTURE
+  emissive *= SAMPLE_MATERIAL(u_emissiveTexture, u_material.emissiveLayer).rgb;
+#endif
+  float ao = 1.0;
+#ifdef HAS_OCCLUSION_TEXTURE
+  ao = SAMPLE_MATERIAL(u_occlusionTexture, u_material.occlusionLayer).r;
+#endif
 
   // Normal from normal map
   vec3 N = normalize(v_normal);
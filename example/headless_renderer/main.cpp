@@ -0,0 +1,312 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <glad/gl.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <nlohmann/json.hpp>
+#include <stb_image_write.h>
+
+#include "paimon/app/application.h"
+#include "paimon/core/ecs/components.h"
+#include "paimon/core/log_system.h"
+
+using namespace paimon;
+
+namespace {
+
+struct Options {
+  std::filesystem::path model;
+  std::filesystem::path output = "headless_output";
+  std::filesystem::path poses; // optional JSON list of camera poses
+  int width = 512;
+  int height = 512;
+  int frames = 36;       // orbit poses when no pose file is given
+  int warmup = 4;        // frames rendered before measuring
+  float radius = 3.0f;   // orbit radius
+  float elevation = 0.5f;
+  bool writeImages = true;
+  bool packTextures = false; // sample material textures from arrays
+};
+
+struct CameraPose {
+  glm::vec3 position;
+  glm::vec3 target;
+};
+
+void printUsage() {
+  LOG_INFO("Usage: headless_renderer <model.gltf> [--output dir] "
+           "[--width N] [--height N] [--frames N] [--warmup N] "
+           "[--radius R] [--elevation Y] [--poses poses.json] [--no-images] "
+           "[--pack-textures]");
+}
+
+std::optional<Options> parseOptions(int argc, char **argv) {
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    auto next = [&]() -> const char * {
+      return i + 1 < argc ? argv[++i] : nullptr;
+    };
+
+    const char *value = nullptr;
+    if (arg == "--no-images") {
+      options.writeImages = false;
+    } else if (arg == "--pack-textures") {
+      options.packTextures = true;
+    } else if (arg.starts_with("--")) {
+      value = next();
+      if (!value) {
+        LOG_ERROR("Missing value for {}", arg);
+        return std::nullopt;
+      }
+      if (arg == "--output") {
+        options.output = value;
+      } else if (arg == "--poses") {
+        options.poses = value;
+      } else if (arg == "--width") {
+        options.width = std::stoi(value);
+      } else if (arg == "--height") {
+        options.height = std::stoi(value);
+      } else if (arg == "--frames") {
+        options.frames = std::stoi(value);
+      } else if (arg == "--warmup") {
+        options.warmup = std::stoi(value);
+      } else if (arg == "--radius") {
+        options.radius = std::stof(value);
+      } else if (arg == "--elevation") {
+        options.elevation = std::stof(value);
+      } else {
+        LOG_ERROR("Unknown option {}", arg);
+        return std::nullopt;
+      }
+    } else {
+      options.model = arg;
+    }
+  }
+
+  if (options.model.empty() || options.width <= 0 || options.height <= 0) {
+    return std::nullopt;
+  }
+  return options;
+}
+
+// Poses from a JSON file: [{"position": [x, y, z], "target": [x, y, z]}, ...]
+// or evenly spaced around an orbit of the origin
+std::vector<CameraPose> loadPoses(const Options &options) {
+  std::vector<CameraPose> poses;
+
+  if (!options.poses.empty()) {
+    std::ifstream file(options.poses);
+    auto json = nlohmann::json::parse(file, nullptr, false);
+    if (json.is_discarded() || !json.is_array()) {
+      LOG_ERROR("Failed to parse pose file: {}", options.poses.string());
+      return poses;
+    }
+    for (const auto &pose : json) {
+      auto position = pose.value("position", std::array<float, 3>{0, 0, 3});
+      auto target = pose.value("target", std::array<float, 3>{0, 0, 0});
+      poses.push_back({{position[0], position[1], position[2]},
+                       {target[0], target[1], target[2]}});
+    }
+    return poses;
+  }
+
+  for (int i = 0; i < options.frames; ++i) {
+    float angle = glm::two_pi<float>() * static_cast<float>(i) /
+                  static_cast<float>(options.frames);
+    poses.push_back({{options.radius * std::sin(angle), options.elevation,
+                      options.radius * std::cos(angle)},
+                     glm::vec3(0.0f)});
+  }
+  return poses;
+}
+
+void setCamera(ecs::Scene &scene, const CameraPose &pose, float aspect) {
+  auto &camera = scene.getMainCamera().getComponent<ecs::Camera>();
+  camera.view = glm::lookAt(pose.position, pose.target, glm::vec3(0, 1, 0));
+  camera.inverseView = glm::inverse(camera.view);
+  camera.projection =
+      glm::perspective(glm::radians(45.0f), aspect, 0.05f, 100.0f);
+
+  auto &transform = scene.getMainCamera().getComponent<ecs::Transform>();
+  transform.translation = pose.position;
+}
+
+double percentile(std::vector<double> values, double p) {
+  if (values.empty()) {
+    return 0.0;
+  }
+  std::sort(values.begin(), values.end());
+  auto index = static_cast<size_t>(p * static_cast<double>(values.size() - 1));
+  return values[index];
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  LogSystem::init();
+
+  auto options = parseOptions(argc, argv);
+  if (!options) {
+    printUsage();
+    return EXIT_FAILURE;
+  }
+
+  Application app(ApplicationConfig{
+      .windowConfig = {.headless = true},
+      .contextFormat = {.majorVersion = 4,
+                        .minorVersion = 6,
+                        .profile = ContextProfile::Core},
+  });
+
+  LOG_INFO("Renderer: {}",
+           reinterpret_cast<const char *>(glGetString(GL_RENDERER)));
+
+  auto &scene = app.getScene();
+  scene.load(options->model);
+
+  // Finish the background texture uploads before measuring
+  auto &uploadQueue = app.getTextureUploadQueue();
+  while (uploadQueue.getPendingCount() > 0) {
+    uploadQueue.update();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  auto poses = loadPoses(*options);
+  if (poses.empty()) {
+    LOG_ERROR("No camera poses to render");
+    return EXIT_FAILURE;
+  }
+
+  std::filesystem::create_directories(options->output);
+
+  auto &renderer = app.getRenderer();
+  auto &ctx = renderer.getRenderContext();
+  auto &colorPass = renderer.getColorPass();
+  colorPass.setTexturePacking(options->packTextures);
+  // Variants compile in the background, wait so every frame uses them
+  app.getShaderManager().finish();
+
+  glm::ivec2 resolution{options->width, options->height};
+  float aspect = static_cast<float>(resolution.x) / resolution.y;
+
+  // Frames are read back through fenced pixel pack buffers and encoded on
+  // the readback worker thread
+  auto &readbackQueue = app.getReadbackQueue();
+  stbi_flip_vertically_on_write(1);
+  auto capture = [&](size_t frame) {
+    ReadbackRequest request{
+        .texture = colorPass.getColorTexture(),
+        .width = resolution.x,
+        .height = resolution.y,
+        .format = GL_RGBA,
+        .type = GL_UNSIGNED_BYTE,
+    };
+    auto path = options->output / std::format("frame_{:04}.png", frame);
+    bool writeImages = options->writeImages;
+    readbackQueue.enqueue(request, [path, resolution, writeImages](
+                                       const void *data, size_t) {
+      if (writeImages) {
+        stbi_write_png(path.string().c_str(), resolution.x, resolution.y, 4,
+                       data, resolution.x * 4);
+      }
+    });
+  };
+
+  // Warm up shader compilation, framebuffer and vertex array caches
+  for (int i = 0; i < options->warmup; ++i) {
+    ctx.beginFrame();
+    setCamera(scene, poses[i % poses.size()], aspect);
+    colorPass.draw(ctx, resolution, scene);
+  }
+  glFinish();
+  // Drop GPU timings of the warmup frames, they include first-use costs
+  ctx.getGpuTimerPool().reset();
+
+  // CPU time to submit each frame, there is no per-frame GPU sync so it does
+  // not include GPU completion. GPU time is reported per pass.
+  using Clock = std::chrono::steady_clock;
+  std::vector<double> frameTimes;
+  frameTimes.reserve(poses.size());
+
+  auto start = Clock::now();
+  auto frameStart = start;
+  for (size_t i = 0; i < poses.size(); ++i) {
+    ctx.beginFrame();
+    setCamera(scene, poses[i], aspect);
+    colorPass.draw(ctx, resolution, scene);
+    capture(i);
+    readbackQueue.update();
+
+    auto now = Clock::now();
+    frameTimes.push_back(
+        std::chrono::duration<double, std::milli>(now - frameStart).count());
+    frameStart = now;
+  }
+  readbackQueue.flush();
+  auto totalSeconds =
+      std::chrono::duration<double>(Clock::now() - start).count();
+
+  // Resolve the GPU timers of the last frames
+  glFinish();
+  for (uint32_t i = 0; i <= GpuTimerPool::FrameLatency; ++i) {
+    ctx.beginFrame();
+  }
+
+  nlohmann::json passes = nlohmann::json::array();
+  for (const auto &stats : ctx.getGpuTimerPool().getStats()) {
+    passes.push_back({
+        {"name", stats.name},
+        {"samples", stats.sampleCount},
+        {"min_ms", stats.minMs},
+        {"avg_ms", stats.avgMs},
+        {"p99_ms", stats.p99Ms},
+    });
+  }
+
+  double sum = 0.0;
+  for (auto time : frameTimes) {
+    sum += time;
+  }
+
+  nlohmann::json report = {
+      {"model", options->model.string()},
+      {"renderer", reinterpret_cast<const char *>(glGetString(GL_RENDERER))},
+      {"width", resolution.x},
+      {"height", resolution.y},
+      {"frames", frameTimes.size()},
+      {"total_seconds", totalSeconds},
+      {"frames_per_second",
+       static_cast<double>(frameTimes.size()) / totalSeconds},
+      {"cpu_submit_ms_per_frame",
+       {
+           {"min", percentile(frameTimes, 0.0)},
+           {"avg", sum / static_cast<double>(frameTimes.size())},
+           {"p50", percentile(frameTimes, 0.5)},
+           {"p90", percentile(frameTimes, 0.9)},
+           {"p99", percentile(frameTimes, 0.99)},
+           {"max", percentile(frameTimes, 1.0)},
+       }},
+      {"gpu_passes", std::move(passes)},
+  };
+
+  auto reportPath = options->output / "stats.json";
+  std::ofstream(reportPath) << report.dump(2) << '\n';
+
+  LOG_INFO("Rendered {} frames in {:.3f} s ({:.1f} fps), stats written to {}",
+           frameTimes.size(), totalSeconds,
+           static_cast<double>(frameTimes.size()) / totalSeconds,
+           reportPath.string());
+
+  return EXIT_SUCCESS;
+}
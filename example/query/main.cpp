@@ -2,7 +2,7 @@
 
 #include "paimon/app/window.h"
 #include "paimon/core/log_system.h"
-#include "paimon/opengl/query.h"
+#include "paimon/rendering/gpu_timer_pool.h"
 #include "paimon/platform/context.h"
 
 using namespace paimon;
@@ -27,23 +27,33 @@ int main() {
           .debug = false,
       });
 
-  Query query(GL_TIME_ELAPSED);
-  if (!query.is_valid()) {
-    LOG_ERROR("Failed to create query object");
-    return -1;
+  // 计时结果在若干帧之后才读取，不会阻塞管线
+  GpuTimerPool timerPool;
+
+  uint64_t frame = 0;
+  while (!window->shouldClose()) {
+    timerPool.beginFrame();
+
+    // 执行一段 OpenGL 操作，比如清屏
+    timerPool.beginScope("Clear");
+    glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    timerPool.endScope();
+
+    window->swapBuffers();
+    window->pollEvents();
+
+    // 定期输出统计结果
+    if (++frame % 120 == 0) {
+      for (const auto &stats : timerPool.getStats()) {
+        LOG_INFO("{}: last {:.3f} ms, min {:.3f} ms, avg {:.3f} ms, p99 "
+                 "{:.3f} ms ({} samples)",
+                 stats.name, stats.lastMs, stats.minMs, stats.avgMs,
+                 stats.p99Ms, stats.sampleCount);
+      }
+    }
   }
 
-  // 演示一次 OpenGL 查询过程
-  query.begin();
-  // 执行一段 OpenGL 操作，比如清屏
-  glClearColor(0.2f, 0.3f, 0.3f, 1.0f);
-  glClear(GL_COLOR_BUFFER_BIT);
-  query.end();
-
-  // 获取查询结果（阻塞直到结果可用）
-  GLuint64 elapsed = query.get<GLuint64>(GL_QUERY_RESULT);
-  LOG_INFO("GL_TIME_ELAPSED: {} ns", elapsed);
-
   window->destroy();
 
   return 0;
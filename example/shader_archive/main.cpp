@@ -0,0 +1,25 @@
+#include <cstdlib>
+#include <filesystem>
+
+#include "paimon/core/log_system.h"
+#include "paimon/rendering/shader_manager.h"
+
+using namespace paimon;
+
+// Packs a shader directory into the archive release builds map at startup:
+//   shader_archive <shader directory> <archive>
+int main(int argc, char **argv) {
+  LogSystem::init();
+
+  if (argc != 3) {
+    LOG_ERROR("Usage: shader_archive <shader directory> <archive>");
+    return EXIT_FAILURE;
+  }
+
+  ShaderManager shaderManager;
+  shaderManager.load(argv[1]);
+  if (!shaderManager.writeArchive(argv[2])) {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
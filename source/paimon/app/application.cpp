@@ -1,8 +1,14 @@
 #include "paimon/app/application.h"
 
+#include <filesystem>
+#include <stdexcept>
+
 #include "paimon/app/panel/editor_layer.h"
 #include "paimon/app/panel/interaction_layer.h"
 #include "paimon/config.h"
+#include "paimon/core/log_system.h"
+#include "paimon/opengl/debug_message.h"
+#include "paimon/rendering/shader_report.h"
 
 namespace paimon {
 
@@ -12,22 +18,57 @@ Application::Application(const ApplicationConfig& config) {
 
   s_instance = this;
 
-  // Create window
-  m_window = Window::create(config.windowConfig, config.contextFormat);
+  if (config.windowConfig.headless) {
+    // Offscreen context only, EGL on machines without a display
+    m_context = Context::create(config.contextFormat);
+    if (!m_context || !m_context->valid() || !m_context->makeCurrent()) {
+      // Nothing below works without a current context
+      throw std::runtime_error("Failed to create headless context");
+    }
+  } else {
+    // Create window
+    m_window = Window::create(config.windowConfig, config.contextFormat);
+    if (!m_window) {
+      throw std::runtime_error("Failed to create window");
+    }
+  }
 
   m_scene = ecs::Scene::create();
 
+#ifdef NDEBUG
+  // Release builds map the packed shaders, the directory is the fallback
+  if (!std::filesystem::exists(PAIMON_SHADER_ARCHIVE) ||
+      !m_shaderManager.loadArchive(PAIMON_SHADER_ARCHIVE)) {
+    m_shaderManager.load(PAIMON_SHADER_DIR);
+  }
+#else
   m_shaderManager.load(PAIMON_SHADER_DIR);
+  m_shaderManager.enableHotReload();
+#endif
+  m_shaderManager.enableProgramBinaryCache(PAIMON_PROGRAM_CACHE_DIR);
 
-  m_imguiLayer = pushLayer(std::make_unique<ImGuiLayer>());
+  if (!isHeadless()) {
+    m_imguiLayer = pushLayer(std::make_unique<ImGuiLayer>());
 
-  pushLayer(std::make_unique<EditorLayer>());
+    pushLayer(std::make_unique<EditorLayer>());
 
-  pushLayer(std::make_unique<InteractionLayer>());
+    pushLayer(std::make_unique<InteractionLayer>());
+  }
 
   m_renderer = pushLayer(std::make_unique<Renderer>());
 }
 
+Application::~Application() {
+  // Written at teardown so headless runs produce a report as well
+  writeShaderReport(m_shaderManager, PAIMON_SHADER_REPORT);
+
+  // Windows drain debug messages when they are destroyed, the headless
+  // context is torn down with the members
+  if (isHeadless()) {
+    DebugMessage::shutdown();
+  }
+}
+
 void Application::onEvent(Event& event) {
   // Dispatch to layers
   for (auto& layer : m_layers) {
@@ -37,11 +78,25 @@ void Application::onEvent(Event& event) {
 }
 
 void Application::run() {
+  if (isHeadless()) {
+    LOG_ERROR("Application::run is not available in headless mode");
+    return;
+  }
+
   while (!m_window->shouldClose()) {
 
     // Poll events
     m_window->pollEvents();
 
+    // Finish and start texture uploads, deliver completed readbacks and
+    // shader programs compiled in the background
+    m_textureUploadQueue.update();
+    m_readbackQueue.update();
+    m_shaderManager.update();
+
+    // Compact sparse buffer blocks before any pass binds a range
+    m_bufferAllocator.defragment();
+
     // Render layers
     m_imguiLayer->begin();
     for (auto &layer : m_layers) {
@@ -9,8 +9,13 @@
 #include "paimon/app/window.h"
 #include "paimon/core/ecs/scene.h"
 #include "paimon/platform/context.h"
+#include "paimon/rendering/buffer_allocator.h"
+#include "paimon/rendering/geometry_pool.h"
+#include "paimon/rendering/readback_queue.h"
 #include "paimon/rendering/renderer.h"
+#include "paimon/rendering/sampler_cache.h"
 #include "paimon/rendering/shader_manager.h"
+#include "paimon/rendering/texture_upload_queue.h"
 
 namespace paimon {
 
@@ -24,7 +29,7 @@ public:
   static Application &getInstance() { return *s_instance; }
 
   Application(const ApplicationConfig &config = {});
-  virtual ~Application() = default;
+  virtual ~Application();
 
   Application(const Application &) = delete;
   Application &operator=(const Application &) = delete;
@@ -39,13 +44,37 @@ public:
 
   void onEvent(Event &event);
 
+  // Main loop, not available in headless mode
   void run();
 
+  // Headless applications render offscreen without a window, ImGui or editor
+  // layers, driving the renderer themselves
+  bool isHeadless() const { return m_window == nullptr; }
+
   Window *getWindow() const { return m_window.get(); }
 
   ShaderManager &getShaderManager() { return m_shaderManager; }
   const ShaderManager &getShaderManager() const { return m_shaderManager; }
 
+  GeometryPool &getGeometryPool() { return m_geometryPool; }
+  const GeometryPool &getGeometryPool() const { return m_geometryPool; }
+
+  BufferAllocator &getBufferAllocator() { return m_bufferAllocator; }
+  const BufferAllocator &getBufferAllocator() const {
+    return m_bufferAllocator;
+  }
+
+  SamplerCache &getSamplerCache() { return m_samplerCache; }
+  const SamplerCache &getSamplerCache() const { return m_samplerCache; }
+
+  TextureUploadQueue &getTextureUploadQueue() { return m_textureUploadQueue; }
+  const TextureUploadQueue &getTextureUploadQueue() const {
+    return m_textureUploadQueue;
+  }
+
+  ReadbackQueue &getReadbackQueue() { return m_readbackQueue; }
+  const ReadbackQueue &getReadbackQueue() const { return m_readbackQueue; }
+
   // Scene management
   ecs::Scene &getScene() { return *m_scene; }
   const ecs::Scene &getScene() const { return *m_scene; }
@@ -60,14 +89,32 @@ public:
 private:
   static Application *s_instance;
 
+  // Offscreen context of a headless application, destroyed last
+  std::unique_ptr<Context> m_context;
+
   std::unique_ptr<Window> m_window;
 
+  // Declared before the scene and layers so primitives release into it first
+  GeometryPool m_geometryPool;
+
+  // Uniform and storage ranges, defragmented a little every frame
+  BufferAllocator m_bufferAllocator;
+
+  // Shared by every render context and loader
+  SamplerCache m_samplerCache;
+
+  // Streams glTF images to the GPU, updated once per frame
+  TextureUploadQueue m_textureUploadQueue;
+
+  // Delivers texture readbacks on a worker thread, updated once per frame
+  ReadbackQueue m_readbackQueue;
+
   std::unique_ptr<ecs::Scene> m_scene;
 
   ShaderManager m_shaderManager;
 
   std::vector<std::unique_ptr<Layer>> m_layers;
-  ImGuiLayer *m_imguiLayer;
+  ImGuiLayer *m_imguiLayer = nullptr;
   Renderer *m_renderer;
 };
 
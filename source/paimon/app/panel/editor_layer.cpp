@@ -30,6 +30,7 @@ void EditorLayer::onImGuiRender() {
   m_menuPanel.onImGuiRender();
   m_viewportPanel.onImGuiRender();
   m_scenePanel.onImGuiRender();
+  m_profilerPanel.onImGuiRender();
 }
 
 void EditorLayer::setupDockingLayout() {
@@ -57,6 +58,7 @@ void EditorLayer::setupDockingLayout() {
   ImGui::DockBuilderDockWindow("Scene Hierarchy", dock_left_top);
   ImGui::DockBuilderDockWindow("Viewport",        dock_center);
   ImGui::DockBuilderDockWindow("Properties",      dock_bottom_right);
+  ImGui::DockBuilderDockWindow("Profiler",        dock_left_bottom);
   
   // Finish building
   ImGui::DockBuilderFinish(dockspace_id);
@@ -2,6 +2,7 @@
 
 #include "paimon/app/layer.h"
 #include "paimon/app/panel/menu_panel.h"
+#include "paimon/app/panel/profiler_panel.h"
 #include "paimon/app/panel/scene_panel.h"
 #include "paimon/app/panel/viewport_panel.h"
 
@@ -22,6 +23,7 @@ private:
   
 private:
   MenuPanel m_menuPanel;
+  ProfilerPanel m_profilerPanel;
   ScenePanel m_scenePanel;
   ViewportPanel m_viewportPanel;
   bool m_firstTime = true;
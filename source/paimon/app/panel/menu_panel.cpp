@@ -35,9 +35,10 @@ void MenuPanel::showMainMenuBar() {
 void MenuPanel::showFileMenu() {
   if (ImGui::BeginMenu("File")) {
     if (ImGui::MenuItem("New Scene", "Ctrl+N")) {
-      auto& scene = Application::getInstance().getScene();
-      // Clear current scene
-      scene.clear();
+      auto& app = Application::getInstance();
+      // Clear current scene, frames in flight may still draw it
+      app.getScene().clear(
+          app.getRenderer().getRenderContext().getDeletionQueue());
     }
     
     if (ImGui::MenuItem("Load Model...", "Ctrl+O")) {
@@ -0,0 +1,111 @@
+#include "paimon/app/panel/profiler_panel.h"
+
+#include <imgui.h>
+
+#include "paimon/app/application.h"
+#include "paimon/rendering/profile_report.h"
+
+namespace paimon {
+
+ProfilerPanel::ProfilerPanel() {}
+
+ProfilerPanel::~ProfilerPanel() {}
+
+void ProfilerPanel::onImGuiRender() {
+  ImGui::Begin("Profiler");
+
+  drawGpuTimers();
+  ImGui::Separator();
+  drawPipelineStatistics();
+  ImGui::Separator();
+
+  if (ImGui::Button("Dump JSON")) {
+    auto &ctx = Application::getInstance().getRenderer().getRenderContext();
+    writeProfileReport(ctx, "profile.json");
+  }
+
+  ImGui::End();
+}
+
+void ProfilerPanel::drawGpuTimers() {
+  auto &timerPool = Application::getInstance()
+                        .getRenderer()
+                        .getRenderContext()
+                        .getGpuTimerPool();
+
+  bool enabled = timerPool.isEnabled();
+  if (ImGui::Checkbox("GPU Timers", &enabled)) {
+    timerPool.setEnabled(enabled);
+  }
+
+  if (ImGui::BeginTable("GpuTimers", 5,
+                        ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+    ImGui::TableSetupColumn("Scope");
+    ImGui::TableSetupColumn("Last (ms)");
+    ImGui::TableSetupColumn("Min (ms)");
+    ImGui::TableSetupColumn("Avg (ms)");
+    ImGui::TableSetupColumn("P99 (ms)");
+    ImGui::TableHeadersRow();
+
+    for (const auto &stats : timerPool.getStats()) {
+      ImGui::TableNextRow();
+      ImGui::TableNextColumn();
+      ImGui::TextUnformatted(stats.name.c_str());
+      ImGui::TableNextColumn();
+      ImGui::Text("%.3f", stats.lastMs);
+      ImGui::TableNextColumn();
+      ImGui::Text("%.3f", stats.minMs);
+      ImGui::TableNextColumn();
+      ImGui::Text("%.3f", stats.avgMs);
+      ImGui::TableNextColumn();
+      ImGui::Text("%.3f", stats.p99Ms);
+    }
+    ImGui::EndTable();
+  }
+}
+
+void ProfilerPanel::drawPipelineStatistics() {
+  auto &statisticsPool = Application::getInstance()
+                             .getRenderer()
+                             .getRenderContext()
+                             .getPipelineStatisticsPool();
+
+  bool enabled = statisticsPool.isEnabled();
+  if (ImGui::Checkbox("Pipeline Statistics", &enabled)) {
+    statisticsPool.setEnabled(enabled);
+  }
+
+  if (!enabled) {
+    return;
+  }
+
+  if (ImGui::BeginTable("PipelineStatistics", 6,
+                        ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+    ImGui::TableSetupColumn("Scope");
+    ImGui::TableSetupColumn("Vertices");
+    ImGui::TableSetupColumn("Primitives");
+    ImGui::TableSetupColumn("Clipped Prims");
+    ImGui::TableSetupColumn("Fragments");
+    ImGui::TableSetupColumn("Compute");
+    ImGui::TableHeadersRow();
+
+    for (const auto &stats : statisticsPool.getStats()) {
+      ImGui::TableNextRow();
+      ImGui::TableNextColumn();
+      ImGui::TextUnformatted(stats.name.c_str());
+      ImGui::TableNextColumn();
+      ImGui::Text("%llu", static_cast<unsigned long long>(stats.verticesSubmitted));
+      ImGui::TableNextColumn();
+      ImGui::Text("%llu", static_cast<unsigned long long>(stats.primitivesSubmitted));
+      ImGui::TableNextColumn();
+      ImGui::Text("%llu", static_cast<unsigned long long>(stats.clippingOutputPrimitives));
+      ImGui::TableNextColumn();
+      ImGui::Text("%llu", static_cast<unsigned long long>(stats.fragmentShaderInvocations));
+      ImGui::TableNextColumn();
+      ImGui::Text("%llu", static_cast<unsigned long long>(stats.computeShaderInvocations));
+    }
+    ImGui::EndTable();
+  }
+}
+
+} // namespace paimon
@@ -0,0 +1,17 @@
+#pragma once
+
+namespace paimon {
+
+class ProfilerPanel {
+public:
+  ProfilerPanel();
+  ~ProfilerPanel();
+
+  void onImGuiRender();
+
+private:
+  void drawGpuTimers();
+  void drawPipelineStatistics();
+};
+
+} // namespace paimon
@@ -241,13 +241,15 @@ void ScenePanel::drawComponents(ecs::Entity entity) {
         
         // Vertex data
         ImGui::Text("Vertex Count: %zu", primitive.vertexCount);
+        ImGui::Text("Geometry Page: %u", primitive.page);
+        ImGui::Text("Base Vertex: %d", primitive.baseVertex);
         
         ImGui::Text("Attributes:");
         ImGui::Indent();
-        ImGui::Text("Positions: %s", primitive.positions ? "✓" : "✗");
-        ImGui::Text("Normals: %s", primitive.normals ? "✓" : "✗");
-        ImGui::Text("Texcoords: %s", primitive.texcoords ? "✓" : "✗");
-        ImGui::Text("Colors: %s", primitive.colors ? "✓" : "✗");
+        ImGui::Text("Positions: %s", primitive.vertexCount > 0 ? "✓" : "✗");
+        ImGui::Text("Normals: %s", primitive.hasNormals ? "✓" : "✗");
+        ImGui::Text("Texcoords: %s", primitive.hasTexcoords ? "✓" : "✗");
+        ImGui::Text("Colors: %s", primitive.hasColors ? "✓" : "✗");
         ImGui::Unindent();
         
         ImGui::Separator();
@@ -255,20 +257,7 @@ void ScenePanel::drawComponents(ecs::Entity entity) {
         // Index data
         if (primitive.hasIndices()) {
           ImGui::Text("Index Count: %zu", primitive.indexCount);
-          
-          // Map DataType enum to display string
-          const char* indexTypeName = "Unknown";
-          switch (primitive.indexType) {
-            case DataType::Byte: indexTypeName = "Byte"; break;
-            case DataType::UByte: indexTypeName = "UByte"; break;
-            case DataType::Short: indexTypeName = "Short"; break;
-            case DataType::UShort: indexTypeName = "UShort"; break;
-            case DataType::Int: indexTypeName = "Int"; break;
-            case DataType::UInt: indexTypeName = "UInt"; break;
-            case DataType::Float: indexTypeName = "Float"; break;
-            case DataType::Double: indexTypeName = "Double"; break;
-          }
-          ImGui::Text("Index Type: %s", indexTypeName);
+          ImGui::Text("First Index: %u", primitive.firstIndex);
         } else {
           ImGui::Text("No Indices (Non-indexed rendering)");
         }
@@ -6,6 +6,7 @@
 #include "paimon/app/event/key_event.h"
 #include "paimon/app/event/mouse_event.h"
 #include "paimon/core/log_system.h"
+#include "paimon/opengl/debug_message.h"
 
 using namespace paimon;
 
@@ -98,6 +99,10 @@ void Window::swapBuffers() { glfwSwapBuffers(m_window); }
 bool Window::shouldClose() const { return glfwWindowShouldClose(m_window); }
 
 void Window::destroy() {
+  if (m_window) {
+    // Messages of this context are delivered before it goes away
+    DebugMessage::shutdown();
+  }
   glfwDestroyWindow(m_window);
   m_window = nullptr;
 }
@@ -2,6 +2,7 @@
 
 #include "paimon/core/ecs/components.h"
 #include "paimon/core/io/gltf.h"
+#include "paimon/rendering/deletion_queue.h"
 
 namespace paimon {
 namespace ecs {
@@ -33,6 +34,27 @@ const entt::registry &Scene::getRegistry() const { return m_registry; }
 
 void Scene::clear() { m_registry.clear(); }
 
+void Scene::clear(DeletionQueue &deletionQueue) {
+  // Hand GPU resources to the deletion queue in one batch, in-flight frames
+  // may still read them and their geometry ranges must not be reused yet
+  std::vector<std::shared_ptr<void>> resources;
+  for (auto [entity, primitive] : m_registry.view<Primitive>().each()) {
+    resources.push_back(primitive.primitive);
+  }
+  for (auto [entity, material] : m_registry.view<Material>().each()) {
+    resources.push_back(material.material);
+  }
+  for (auto [entity, environment] : m_registry.view<Environment>().each()) {
+    resources.push_back(environment.equirectangularMap);
+    resources.push_back(environment.irradianceMap);
+    resources.push_back(environment.prefilteredMap);
+    resources.push_back(environment.brdfLUT);
+  }
+  deletionQueue.retire(std::move(resources));
+
+  m_registry.clear();
+}
+
 bool Scene::valid(entt::entity entity) const {
   return m_registry.valid(entity);
 }
@@ -9,6 +9,9 @@
 #include "paimon/core/ecs/system.h"
 
 namespace paimon {
+
+class DeletionQueue;
+
 namespace ecs {
 
 class Entity;
@@ -61,9 +64,13 @@ public:
     return m_registry.group<Owned...>(entt::get<Get...>, entt::exclude<Exclude...>);
   }
 
-  // Clear all entities
+  // Clear all entities, their GPU resources are released right away
   void clear();
 
+  // Clear all entities, retiring their GPU resources to the deletion queue
+  // of the renderer still drawing them
+  void clear(DeletionQueue &deletionQueue);
+
   // Check if entity is valid
   bool valid(entt::entity entity) const;
 
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstdint>
 #include <functional>
+#include <string_view>
 
 namespace paimon {
 template <class T, class... Args>
@@ -12,4 +14,15 @@ void hashCombine(std::size_t &seed, const T &value,
     hashCombine(seed, args...);
   }
 }
+
+// FNV-1a, stable across runs and platforms unlike std::hash, for keys that
+// are persisted or compared between processes
+constexpr uint64_t hashFnv1a(std::string_view data,
+                             uint64_t seed = 14695981039346656037ull) noexcept {
+  uint64_t hash = seed;
+  for (char c : data) {
+    hash = (hash ^ static_cast<uint8_t>(c)) * 1099511628211ull;
+  }
+  return hash;
+}
 } // namespace paimon
\ No newline at end of file
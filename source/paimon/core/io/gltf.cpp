@@ -1,5 +1,6 @@
 #include "paimon/core/io/gltf.h"
 
+#include <algorithm>
 #include <memory>
 
 #include <glm/gtc/matrix_transform.hpp>
@@ -7,6 +8,7 @@
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtx/matrix_decompose.hpp>
 
+#include "paimon/app/application.h"
 #include "paimon/core/ecs/components.h"
 #include "paimon/core/ecs/entity.h"
 #include "paimon/core/log_system.h"
@@ -15,6 +17,8 @@
 #include "paimon/opengl/sampler.h"
 #include "paimon/opengl/texture.h"
 #include "paimon/opengl/type.h"
+#include "paimon/rendering/sampler_cache.h"
+#include "paimon/rendering/texture_upload_queue.h"
 
 using namespace paimon;
 
@@ -40,29 +44,6 @@ PrimitiveTopology parsePrimitiveMode(int primitiveMode) {
   }
 }
 
-DataType parseCompnentType(int componentType) {
-  switch (componentType) {
-  case TINYGLTF_COMPONENT_TYPE_BYTE:
-    return DataType::Byte;
-  case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
-    return DataType::UByte;
-  case TINYGLTF_COMPONENT_TYPE_SHORT:
-    return DataType::Short;
-  case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
-    return DataType::UShort;
-  case TINYGLTF_COMPONENT_TYPE_INT:
-    return DataType::Int;
-  case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT:
-    return DataType::UInt;
-  case TINYGLTF_COMPONENT_TYPE_FLOAT:
-    return DataType::Float;
-  case TINYGLTF_COMPONENT_TYPE_DOUBLE:
-    return DataType::Double;
-  default:
-    return DataType::Float;
-  }
-}
-
 TextureFilterMode parseFilterMode(int filter) {
   switch (filter) {
   case TINYGLTF_TEXTURE_FILTER_NEAREST:
@@ -95,69 +76,27 @@ TextureWrapMode parseWrapMode(int wrap) {
   }
 }
 
-std::shared_ptr<Sampler> parse(const tinygltf::Sampler& sampler) {
-  auto gl_sampler = std::make_shared<Sampler>();
+std::shared_ptr<const Sampler> parse(const tinygltf::Sampler& sampler) {
+  SamplerDescriptor descriptor;
 
-  // Set min filter
+  // Unspecified filters keep the descriptor defaults
   if (sampler.minFilter >= 0) {
-    gl_sampler->set<GLenum>(GL_TEXTURE_MIN_FILTER,
-                            static_cast<GLenum>(sampler.minFilter));
-  } else {
-    gl_sampler->set<GLenum>(GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    descriptor.minFilter = static_cast<GLenum>(sampler.minFilter);
   }
-
-  // Set mag filter
   if (sampler.magFilter >= 0) {
-    gl_sampler->set<GLenum>(GL_TEXTURE_MAG_FILTER,
-                            static_cast<GLenum>(sampler.magFilter));
-  } else {
-    gl_sampler->set<GLenum>(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    descriptor.magFilter = static_cast<GLenum>(sampler.magFilter);
   }
 
   // Set wrap modes
-  gl_sampler->set<GLenum>(GL_TEXTURE_WRAP_S,
-                          static_cast<GLenum>(sampler.wrapS));
-  gl_sampler->set<GLenum>(GL_TEXTURE_WRAP_T,
-                          static_cast<GLenum>(sampler.wrapT));
+  descriptor.wrapS = static_cast<GLenum>(sampler.wrapS);
+  descriptor.wrapT = static_cast<GLenum>(sampler.wrapT);
 
-  return gl_sampler;
+  return Application::getInstance().getSamplerCache().get(descriptor);
 }
 
-std::shared_ptr<Sampler> getDefaultSampler() {
-  auto gl_sampler = std::make_shared<Sampler>();
-  // Default sampler settings
-  gl_sampler->set<GLenum>(GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-  gl_sampler->set<GLenum>(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-  gl_sampler->set<GLenum>(GL_TEXTURE_WRAP_S, GL_REPEAT);
-  gl_sampler->set<GLenum>(GL_TEXTURE_WRAP_T, GL_REPEAT);
-  return gl_sampler;
-}
-
-std::shared_ptr<Texture> parse(const tinygltf::Image& image) {
-  auto gl_texture = std::make_shared<Texture>(GL_TEXTURE_2D);
-
-  // Determine format
-  GLenum internalFormat = GL_RGBA8;
-  GLenum format = GL_RGBA;
-
-  if (image.component == 1) {
-    internalFormat = GL_R8;
-    format = GL_RED;
-  } else if (image.component == 2) {
-    internalFormat = GL_RG8;
-    format = GL_RG;
-  } else if (image.component == 3) {
-    internalFormat = GL_RGB8;
-    format = GL_RGB;
-  }
-
-  // Upload to GPU
-  gl_texture->set_storage_2d(1, internalFormat, image.width, image.height);
-  gl_texture->set_sub_image_2d(0, 0, 0, image.width, image.height,
-                               format, GL_UNSIGNED_BYTE, image.image.data());
-  gl_texture->generate_mipmap();
-
-  return gl_texture;
+std::shared_ptr<const Sampler> getDefaultSampler() {
+  // Trilinear filtering with repeat wrapping
+  return Application::getInstance().getSamplerCache().get({});
 }
 
 glm::vec4 parseVec4(const std::vector<double> data) {
@@ -185,6 +124,85 @@ sg::AlphaMode parseAlphaMode(const std::string &modeStr) {
   }
 }
 
+// Component types readComponent can convert
+bool isSupportedComponentType(int componentType) {
+  switch (componentType) {
+  case TINYGLTF_COMPONENT_TYPE_BYTE:
+  case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
+  case TINYGLTF_COMPONENT_TYPE_SHORT:
+  case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
+  case TINYGLTF_COMPONENT_TYPE_FLOAT:
+    return true;
+  default:
+    return false;
+  }
+}
+
+// Read one component, normalizing integer types as glTF requires for
+// TEXCOORD and COLOR accessors. Signed types are allowed for TEXCOORD by
+// KHR_mesh_quantization.
+float readComponent(const uint8_t *data, int componentType) {
+  switch (componentType) {
+  case TINYGLTF_COMPONENT_TYPE_BYTE:
+    return std::max(*reinterpret_cast<const int8_t *>(data) / 127.0f, -1.0f);
+  case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
+    return *data / 255.0f;
+  case TINYGLTF_COMPONENT_TYPE_SHORT:
+    return std::max(*reinterpret_cast<const int16_t *>(data) / 32767.0f,
+                    -1.0f);
+  case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
+    return *reinterpret_cast<const uint16_t *>(data) / 65535.0f;
+  case TINYGLTF_COMPONENT_TYPE_FLOAT:
+    return *reinterpret_cast<const float *>(data);
+  default:
+    return 0.0f; // rejected by readVectors
+  }
+}
+
+// Convert tightly packed accessor data to N float components per element,
+// dropping extra components (e.g. the alpha of a vec4 COLOR)
+template <glm::length_t N>
+std::vector<glm::vec<N, float>> readVectors(const tinygltf::Accessor &accessor,
+                                            const std::vector<uint8_t> &data) {
+  auto componentSize = tinygltf::GetComponentSizeInBytes(accessor.componentType);
+  auto numComponents = tinygltf::GetNumComponentsInType(accessor.type);
+
+  std::vector<glm::vec<N, float>> result(accessor.count, glm::vec<N, float>(0.0f));
+  if (!isSupportedComponentType(accessor.componentType)) {
+    LOG_WARN("Unsupported accessor component type {}, attribute left zero",
+             accessor.componentType);
+    return result;
+  }
+  for (size_t i = 0; i < accessor.count; ++i) {
+    const auto *element = data.data() + i * componentSize * numComponents;
+    for (glm::length_t c = 0; c < N && c < numComponents; ++c) {
+      result[i][c] = readComponent(element + c * componentSize,
+                                   accessor.componentType);
+    }
+  }
+  return result;
+}
+
+// Widen indices to 32 bits, the geometry pool uses a single index type
+std::vector<uint32_t> readIndices(const tinygltf::Accessor &accessor,
+                                  const std::vector<uint8_t> &data) {
+  std::vector<uint32_t> result(accessor.count);
+  for (size_t i = 0; i < accessor.count; ++i) {
+    switch (accessor.componentType) {
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
+      result[i] = data[i];
+      break;
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
+      result[i] = reinterpret_cast<const uint16_t *>(data.data())[i];
+      break;
+    default:
+      result[i] = reinterpret_cast<const uint32_t *>(data.data())[i];
+      break;
+    }
+  }
+  return result;
+}
+
 glm::mat4 parseMat4(const std::vector<double> data) {
   glm::mat4 mat{data[0],  data[1],  data[2],  data[3], data[4],  data[5],
                 data[6],  data[7],  data[8],  data[9], data[10], data[11],
@@ -225,10 +243,10 @@ GltfLoader::GltfLoader(const std::filesystem::path &filepath) {
 void GltfLoader::load(ecs::Scene &scene) {
   parseBuffers();      // Step 1: buffer -> memory
   parseBufferViews();  // Step 2: bufferView -> memory (access buffer memory)
-  parseAccessors();    // Step 3: accessor -> OpenGL Buffer (access bufferView memory)
+  parseAccessors();    // Step 3: accessor -> memory (access bufferView memory)
   parseTextures();
   parseMaterials();
-  parseMeshes();       // Step 4: mesh primitives reference accessor Buffers
+  parseMeshes();       // Step 4: mesh primitives upload accessors to the geometry pool
 
   int sceneIndex = m_model.defaultScene >= 0 ? m_model.defaultScene : 0;
   parseScene(m_model.scenes[sceneIndex], scene);
@@ -280,18 +298,21 @@ void GltfLoader::parseAccessors() {
       auto begin = sourceBufferView.begin() + offset;
       accessorData.insert(accessorData.end(), begin, begin + elementSize);
     }
-    
-    // Create OpenGL Buffer with tightly packed data
-    auto gl_buffer = std::make_shared<Buffer>();
-    gl_buffer->set_storage(accessorData.size(), accessorData.data(), 0);    
-    m_accessors.push_back(std::move(gl_buffer));
+
+    m_accessors.push_back(std::move(accessorData));
   }
 }
 
 void GltfLoader::parseTextures() {
+  auto &uploadQueue = Application::getInstance().getTextureUploadQueue();
+
+  // Textures sharing an image are resolved by the same upload
+  std::vector<std::vector<std::shared_ptr<sg::Texture>>> imageUsers(
+      m_model.images.size());
+
   for (const auto &texture : m_model.textures) {
     auto sg_texture = std::make_shared<sg::Texture>();
-    sg_texture->image = parse(m_model.images[texture.source]);
+    sg_texture->image = uploadQueue.getFallbackTexture();
     
     // Check if sampler is valid, use default if not
     if (texture.sampler >= 0) {
@@ -299,9 +320,40 @@ void GltfLoader::parseTextures() {
     } else {
       sg_texture->sampler = getDefaultSampler();
     }
+
+    if (texture.source >= 0) {
+      imageUsers[texture.source].push_back(sg_texture);
+    }
     
     m_textures.push_back(std::move(sg_texture));
   }
+
+  // Upload images in the background, the fallback is shown until then
+  for (size_t i = 0; i < m_model.images.size(); ++i) {
+    if (imageUsers[i].empty()) {
+      continue;
+    }
+
+    auto &image = m_model.images[i];
+    if (image.bits != 8) {
+      LOG_WARN("Image {} has {} bits per channel, only 8 is supported", i,
+               image.bits);
+      continue;
+    }
+
+    uploadQueue.enqueue(
+        TextureUploadRequest{
+            .width = image.width,
+            .height = image.height,
+            .components = image.component,
+            .pixels = std::move(image.image),
+        },
+        [users = std::move(imageUsers[i])](std::shared_ptr<Texture> texture) {
+          for (const auto &user : users) {
+            user->image = texture;
+          }
+        });
+  }
 }
 
 void GltfLoader::parseMaterials() {
@@ -350,32 +402,32 @@ void GltfLoader::parseMaterials() {
 }
 
 void GltfLoader::parseMeshes() {
+  auto &geometryPool = Application::getInstance().getGeometryPool();
+
   for (const auto &mesh : m_model.meshes) {
     auto sg_mesh = std::make_shared<sg::Mesh>();
 
     for (const auto &primitive : mesh.primitives) {
-      auto &sg_primitive = sg_mesh->primitives.emplace_back();
-      // Primitive topology
-      sg_primitive.mode = parsePrimitiveMode(primitive.mode);
+      std::vector<glm::vec3> positions;
+      std::vector<glm::vec3> normals;
+      std::vector<glm::vec2> texcoords;
+      std::vector<glm::vec3> colors;
+      std::vector<uint32_t> indices;
 
       // First handle attributes (vertex data)
       for (const auto &[attributeName, accessorIndex] : primitive.attributes) {
         const auto &accessor = m_model.accessors[accessorIndex];
+        const auto &data = m_accessors[accessorIndex];
 
-        sg_primitive.vertexCount = accessor.count;
-
-        // Assign the OpenGL buffer from accessor (independent buffer layout)
         if (attributeName == "POSITION") {
-          sg_primitive.positions = m_accessors[accessorIndex];
+          positions = readVectors<3>(accessor, data);
         } else if (attributeName == "NORMAL") {
-          sg_primitive.normals = m_accessors[accessorIndex];
-        } else if (attributeName.rfind("TEXCOORD", 0) == 0) {
-          // assign first texcoord into texcoords (TEXCOORD_0)
-          if (attributeName == "TEXCOORD_0") {
-            sg_primitive.texcoords = m_accessors[accessorIndex];
-          }
-        } else if (attributeName.rfind("COLOR", 0) == 0) {
-          sg_primitive.colors = m_accessors[accessorIndex];
+          normals = readVectors<3>(accessor, data);
+        } else if (attributeName == "TEXCOORD_0") {
+          // only the first texcoord set is used
+          texcoords = readVectors<2>(accessor, data);
+        } else if (attributeName == "COLOR_0") {
+          colors = readVectors<3>(accessor, data);
         } else {
           // other attributes can be ignored for now or handled later
         }
@@ -383,11 +435,25 @@ void GltfLoader::parseMeshes() {
 
       // Then handle indices (element buffer) if present
       if (primitive.indices >= 0) {
-        const auto &accessor = m_model.accessors[primitive.indices];
-        sg_primitive.indexCount = accessor.count;
-        sg_primitive.indexType = parseCompnentType(accessor.componentType);
-        sg_primitive.indices = m_accessors[primitive.indices];
+        indices = readIndices(m_model.accessors[primitive.indices],
+                              m_accessors[primitive.indices]);
       }
+
+      auto sg_primitive = sg::Primitive::create(
+          geometryPool, {.vertexCount = positions.size(),
+                         .positions = positions,
+                         .normals = normals,
+                         .texcoords = texcoords,
+                         .colors = colors,
+                         .indices = indices});
+      if (!sg_primitive) {
+        LOG_ERROR("Failed to upload primitive of mesh '{}'", mesh.name);
+        sg_primitive = std::make_unique<sg::Primitive>();
+      }
+
+      // Primitive topology
+      sg_primitive->mode = parsePrimitiveMode(primitive.mode);
+      sg_mesh->primitives.push_back(std::move(*sg_primitive));
     }
     m_meshes.push_back(std::move(sg_mesh));
   }
@@ -12,7 +12,6 @@
 #include "paimon/core/sg/material.h"
 #include "paimon/core/sg/mesh.h"
 #include "paimon/core/sg/texture.h"
-#include "paimon/opengl/buffer.h"
 #include "paimon/opengl/sampler.h"
 #include "paimon/opengl/texture.h"
 
@@ -51,13 +50,13 @@ private:
 
   ecs::Entity m_rootEntity;
 
-  std::vector<std::shared_ptr<Sampler>> m_samplers;
+  std::vector<std::shared_ptr<const Sampler>> m_samplers;
   std::vector<std::shared_ptr<Texture>> m_images;
   
   // Raw memory storage
   std::vector<std::vector<uint8_t>> m_buffers;      // Buffer data in memory
   std::vector<std::vector<uint8_t>> m_bufferViews; // BufferView data in memory
-  std::vector<std::shared_ptr<Buffer>> m_accessors; // Accessor -> OpenGL Buffer
+  std::vector<std::vector<uint8_t>> m_accessors;   // Accessor data, tightly packed
 
   std::vector<std::shared_ptr<sg::Texture>> m_textures;
   std::vector<std::shared_ptr<sg::Material>> m_materials;
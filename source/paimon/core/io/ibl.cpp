@@ -4,8 +4,10 @@
 #include <stb_image.h>
 #include <stb_image_write.h>
 
+#include "paimon/app/application.h"
 #include "paimon/core/ecs/components.h"
 #include "paimon/core/log_system.h"
+#include "paimon/rendering/readback_queue.h"
 #include "paimon/rendering/render_context.h"
 #include "paimon/utility/brdf_lut_pass.h"
 #include "paimon/utility/equirectangular_to_cubemap_pass.h"
@@ -136,24 +138,9 @@ void IBLLoader::saveCubemap(const Texture &cubemap, const std::filesystem::path
       "pz", "nz"  // +Z, -Z
   };
 
-  std::vector<float> pixels(size * size * 3);
+  auto &readbackQueue = Application::getInstance().getReadbackQueue();
 
   for (int face = 0; face < 6; ++face) {
-    // For cubemap textures, glGetTextureSubImage treats them as an array of 6
-    // slices zoffset is the face index (0-5), depth is the number of faces to
-    // access (1)
-    glGetTextureSubImage(cubemap.get_name(),
-                         mipLevel, // level
-                         0, 0,
-                         face, // xoffset, yoffset, zoffset (face index: 0-5)
-                         size, size, 1, // width, height, depth (1 face)
-                         GL_RGB,        // format
-                         GL_FLOAT,      // type
-                         pixels.size() * sizeof(float), // bufSize
-                         pixels.data()                  // pixels
-    );
-
-    // Save to HDR file (no tone mapping, preserve full HDR range)
     std::string filename = basePath.string();
     if (mipLevel > 0) {
       filename += "_mip" + std::to_string(mipLevel);
@@ -162,45 +149,47 @@ void IBLLoader::saveCubemap(const Texture &cubemap, const std::filesystem::path
     filename += faceNames[face];
     filename += ".hdr";
 
-    stbi_flip_vertically_on_write(1);
-    if (!stbi_write_hdr(filename.c_str(), size, size, 3, pixels.data())) {
-      LOG_ERROR("  Failed to save: {}", filename);
-    }
+    // For cubemap textures, glGetTextureSubImage treats them as an array of 6
+    // slices, z is the face index (0-5)
+    ReadbackRequest request{
+        .texture = &cubemap,
+        .level = mipLevel,
+        .z = face,
+        .width = size,
+        .height = size,
+        .format = GL_RGB,
+        .type = GL_FLOAT,
+    };
+
+    // Save to HDR file (no tone mapping, preserve full HDR range), encoded on
+    // the readback worker
+    readbackQueue.enqueue(request, [filename, size](const void *data, size_t) {
+      stbi_flip_vertically_on_write(1);
+      if (!stbi_write_hdr(filename.c_str(), size, size, 3,
+                          static_cast<const float *>(data))) {
+        LOG_ERROR("  Failed to save: {}", filename);
+      }
+    });
   }
 }
 
 void IBLLoader::save2DTexture(const Texture &texture, const std::filesystem::path &filepath,
                                int width, int height) {
-  std::vector<float> pixels(width * height * 2); // RG format
-
-  // Read texture data
-  glGetTextureSubImage(texture.get_name(),
-                       0,                // level
-                       0, 0, 0,          // xoffset, yoffset, zoffset
-                       width, height, 1, // width, height, depth
-                       GL_RG,            // format (BRDF LUT is RG16F)
-                       GL_FLOAT,         // type
-                       pixels.size() * sizeof(float), // bufSize
-                       pixels.data()                  // pixels
-  );
-
-   // Convert RG to RGB for HDR file (add blue channel = 0)
-  std::vector<float> pixelsRGB(width * height * 3);
-  for (int i = 0; i < width * height; ++i) {
-    pixelsRGB[i * 3 + 0] = pixels[i * 2 + 0]; // R
-    pixelsRGB[i * 3 + 1] = pixels[i * 2 + 1]; // G
-    pixelsRGB[i * 3 + 2] = 0.0f;              // B = 0
-  }
-
-  // Check data range
-  float maxR = 0.0f, maxG = 0.0f;
-  for (int i = 0; i < width * height; ++i) {
-    maxR = std::max(maxR, pixels[i * 2 + 0]);
-    maxG = std::max(maxG, pixels[i * 2 + 1]);
-  }
+  // Reading the RG16F LUT as RGB fills the blue channel with 0
+  ReadbackRequest request{
+      .texture = &texture,
+      .width = width,
+      .height = height,
+      .format = GL_RGB,
+      .type = GL_FLOAT,
+  };
 
-  stbi_flip_vertically_on_write(1);
-  if (!stbi_write_hdr(filepath.string().c_str(), width, height, 3, pixelsRGB.data())) {
-    LOG_ERROR("  Failed to save: {}", filepath.string());
-  }
+  Application::getInstance().getReadbackQueue().enqueue(
+      request, [filepath, width, height](const void *data, size_t) {
+        stbi_flip_vertically_on_write(1);
+        if (!stbi_write_hdr(filepath.string().c_str(), width, height, 3,
+                            static_cast<const float *>(data))) {
+          LOG_ERROR("  Failed to save: {}", filepath.string());
+        }
+      });
 }
@@ -0,0 +1,109 @@
+#include "paimon/core/io/mapped_file.h"
+
+#include "paimon/core/log_system.h"
+#include "paimon/core/macro.h"
+
+#ifdef PAIMON_OS_WINDOWS
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace paimon;
+
+MappedFile::~MappedFile() { close(); }
+
+#ifdef PAIMON_OS_WINDOWS
+
+bool MappedFile::open(const std::filesystem::path &path) {
+  close();
+
+  m_file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                       OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (m_file == INVALID_HANDLE_VALUE) {
+    m_file = nullptr;
+    LOG_ERROR("Failed to open file: {}", path.string());
+    return false;
+  }
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0) {
+    LOG_ERROR("Failed to map empty file: {}", path.string());
+    close();
+    return false;
+  }
+
+  m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (m_mapping != nullptr) {
+    m_data = static_cast<const uint8_t *>(
+        MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+  }
+  if (m_data == nullptr) {
+    LOG_ERROR("Failed to map file: {}", path.string());
+    close();
+    return false;
+  }
+  m_size = static_cast<size_t>(size.QuadPart);
+  return true;
+}
+
+void MappedFile::close() {
+  if (m_data != nullptr) {
+    UnmapViewOfFile(m_data);
+  }
+  if (m_mapping != nullptr) {
+    CloseHandle(m_mapping);
+  }
+  if (m_file != nullptr) {
+    CloseHandle(m_file);
+  }
+  m_data = nullptr;
+  m_size = 0;
+  m_mapping = nullptr;
+  m_file = nullptr;
+}
+
+#else
+
+bool MappedFile::open(const std::filesystem::path &path) {
+  close();
+
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    LOG_ERROR("Failed to open file: {}", path.string());
+    return false;
+  }
+
+  struct stat info;
+  if (fstat(fd, &info) != 0 || info.st_size == 0) {
+    LOG_ERROR("Failed to map empty file: {}", path.string());
+    ::close(fd);
+    return false;
+  }
+
+  // The mapping keeps the file referenced, the descriptor is not needed
+  void *data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ,
+                    MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    LOG_ERROR("Failed to map file: {}", path.string());
+    return false;
+  }
+
+  m_data = static_cast<const uint8_t *>(data);
+  m_size = static_cast<size_t>(info.st_size);
+  return true;
+}
+
+void MappedFile::close() {
+  if (m_data != nullptr) {
+    munmap(const_cast<uint8_t *>(m_data), m_size);
+  }
+  m_data = nullptr;
+  m_size = 0;
+}
+
+#endif
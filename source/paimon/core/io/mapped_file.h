@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+#include "paimon/core/macro.h"
+
+namespace paimon {
+
+// Read-only memory mapping of a whole file, pages are loaded on first access
+class MappedFile {
+public:
+  MappedFile() = default;
+  ~MappedFile();
+
+  // Delete copy constructor and assignment
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  bool open(const std::filesystem::path &path);
+
+  void close();
+
+  bool isOpen() const { return m_data != nullptr; }
+
+  const uint8_t *data() const { return m_data; }
+
+  size_t size() const { return m_size; }
+
+private:
+  const uint8_t *m_data = nullptr;
+  size_t m_size = 0;
+#ifdef PAIMON_OS_WINDOWS
+  void *m_file = nullptr;
+  void *m_mapping = nullptr;
+#endif
+};
+
+} // namespace paimon
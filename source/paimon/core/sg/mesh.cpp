@@ -1,4 +1,5 @@
 #include "paimon/core/sg/mesh.h"
+#include <iterator>
 #include <memory>
 
 using namespace paimon;
@@ -46,9 +47,27 @@ std::vector<VertexInputState::Attribute> Primitive::attributes() {
   };
 }
 
-std::unique_ptr<Primitive> Primitive::createCube() {
-    auto primitive = std::make_unique<Primitive>();
-    
+std::unique_ptr<Primitive> Primitive::create(GeometryPool &pool,
+                                             const GeometryData &data) {
+  auto allocation = pool.upload(data);
+  if (!allocation) {
+    return nullptr;
+  }
+
+  auto primitive = std::make_unique<Primitive>();
+  primitive->page = allocation->page;
+  primitive->baseVertex = static_cast<int32_t>(allocation->baseVertex);
+  primitive->vertexCount = allocation->vertexCount;
+  primitive->hasNormals = !data.normals.empty();
+  primitive->hasTexcoords = !data.texcoords.empty();
+  primitive->hasColors = !data.colors.empty();
+  primitive->firstIndex = allocation->firstIndex;
+  primitive->indexCount = allocation->indexCount;
+  primitive->allocation = std::move(allocation);
+  return primitive;
+}
+
+std::unique_ptr<Primitive> Primitive::createCube(GeometryPool &pool) {
     float halfSize = 1.f;
     
     // Define cube vertices
@@ -95,20 +114,12 @@ std::unique_ptr<Primitive> Primitive::createCube() {
        20,21,22,22,23,20        // Bottom face
     };
 
-    primitive->positions = std::make_unique<Buffer>();
-    primitive->positions->set_storage(sizeof(positions), positions, 0);
-
-    primitive->indexCount = sizeof(indices) / sizeof(indices[0]);
-    primitive->indexType = DataType::UInt;
-    primitive->indices = std::make_unique<Buffer>();
-    primitive->indices->set_storage(sizeof(indices), indices, 0);
-    
-    return primitive;
+    return create(pool, {.vertexCount = std::size(positions),
+                         .positions = positions,
+                         .indices = indices});
 }
 
-std::unique_ptr<Primitive> Primitive::createQuad() {
-    auto primitive = std::make_unique<Primitive>();
-    
+std::unique_ptr<Primitive> Primitive::createQuad(GeometryPool &pool) {
     float halfSize = 1.f;
     
     // Define quad vertices
@@ -132,16 +143,8 @@ std::unique_ptr<Primitive> Primitive::createQuad() {
         2, 3, 0
     };
 
-    primitive->positions = std::make_unique<Buffer>();
-    primitive->positions->set_storage(sizeof(positions), positions, 0);
-
-    primitive->texcoords = std::make_unique<Buffer>();
-    primitive->texcoords->set_storage(sizeof(texCoords), texCoords, 0);
-
-    primitive->indexCount = sizeof(indices) / sizeof(indices[0]);
-    primitive->indexType = DataType::UInt;
-    primitive->indices = std::make_unique<Buffer>();
-    primitive->indices->set_storage(sizeof(indices), indices, 0);
-    
-    return primitive;
+    return create(pool, {.vertexCount = std::size(positions),
+                         .positions = positions,
+                         .texcoords = texCoords,
+                         .indices = indices});
 }
\ No newline at end of file
@@ -4,35 +4,44 @@
 
 #include <glm/glm.hpp>
 
-#include "paimon/opengl/buffer.h"
 #include "paimon/opengl/state/vertex_input.h"
 #include "paimon/opengl/type.h"
+#include "paimon/rendering/geometry_pool.h"
 
 namespace paimon {
 namespace sg {
 /// Mesh primitive (single draw call unit)
+/// Vertex and index data live in the GeometryPool, the primitive only keeps
+/// its ranges so that draws can use a single vertex array binding
 struct Primitive {
   PrimitiveTopology mode = PrimitiveTopology::Triangles;
 
+  uint32_t page = 0;
+  int32_t baseVertex = 0;
   size_t vertexCount = 0;
-  std::shared_ptr<Buffer> positions;
-  std::shared_ptr<Buffer> normals;
-  std::shared_ptr<Buffer> texcoords;
-  std::shared_ptr<Buffer> colors;
+  bool hasNormals = false;
+  bool hasTexcoords = false;
+  bool hasColors = false;
 
+  uint32_t firstIndex = 0;
   size_t indexCount = 0;
-  DataType indexType = DataType::UInt;
-  std::shared_ptr<Buffer> indices;
 
-  bool hasIndices() const { return indices != nullptr; }
+  /// Shared by copies, releases the ranges when the last one goes away
+  std::shared_ptr<GeometryAllocation> allocation;
+
+  bool hasIndices() const { return indexCount > 0; }
+
+  /// Upload the data to the pool and fill in the ranges, returns nullptr on failure
+  static std::unique_ptr<Primitive> create(GeometryPool &pool,
+                                           const GeometryData &data);
 
   static std::vector<VertexInputState::Binding> bindings();
 
   static std::vector<VertexInputState::Attribute> attributes();
 
-  static std::unique_ptr<Primitive> createCube();
+  static std::unique_ptr<Primitive> createCube(GeometryPool &pool);
 
-  static std::unique_ptr<Primitive> createQuad();
+  static std::unique_ptr<Primitive> createQuad(GeometryPool &pool);
 };
 
 struct Mesh {
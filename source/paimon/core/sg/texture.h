@@ -12,7 +12,7 @@ namespace sg {
 struct Texture {
   // OpenGL texture and sampler objects
   std::shared_ptr<paimon::Texture> image = nullptr;
-  std::shared_ptr<paimon::Sampler> sampler = nullptr;
+  std::shared_ptr<const paimon::Sampler> sampler = nullptr;
 
 };
 
@@ -30,6 +30,29 @@ void NamedObject::set_label(const std::string &label) {
 
 GLuint NamedObject::get_name() const { return m_name; }
 
+SyncObject::SyncObject()
+    : m_sync(glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0)) {}
+
+SyncObject::~SyncObject() {
+  if (m_sync != nullptr) {
+    glDeleteSync(m_sync);
+  }
+}
+
+bool SyncObject::is_valid() const { return glIsSync(m_sync) == GL_TRUE; }
+
+GLenum SyncObject::client_wait(GLbitfield flags, GLuint64 timeout) const {
+  return glClientWaitSync(m_sync, flags, timeout);
+}
+
+void SyncObject::wait() const { glWaitSync(m_sync, 0, GL_TIMEOUT_IGNORED); }
+
+bool SyncObject::is_signaled() const {
+  GLint status = GL_UNSIGNALED;
+  glGetSynciv(m_sync, GL_SYNC_STATUS, 1, nullptr, &status);
+  return status == GL_SIGNALED;
+}
+
 SyncObject::SyncObject(SyncObject &&other) noexcept
     : Object(std::move(other)), m_sync(other.m_sync) {
   other.m_sync = nullptr;
@@ -46,18 +46,30 @@ protected:
 
 class SyncObject : public Object {
 public:
-  SyncObject() = default;
+  // Inserts a fence into the command stream
+  SyncObject();
 
-  virtual ~SyncObject() = default;
+  virtual ~SyncObject();
 
   SyncObject(const SyncObject &other) = delete;
   SyncObject &operator=(const SyncObject &other) = delete;
 
   SyncObject(SyncObject &&other) noexcept;
 
+  bool is_valid() const override;
+
   std::string get_label() const override;
   void set_label(const std::string &label) override;
 
+  // Returns GL_ALREADY_SIGNALED, GL_CONDITION_SATISFIED, GL_TIMEOUT_EXPIRED or
+  // GL_WAIT_FAILED, a timeout of 0 never blocks
+  GLenum client_wait(GLbitfield flags, GLuint64 timeout) const;
+
+  // Make the server wait for the fence without blocking the client
+  void wait() const;
+
+  bool is_signaled() const;
+
 private:
   GLsync m_sync;
 };
@@ -33,6 +33,9 @@ public:
   void clear_data(GLenum internalformat, GLenum format, GLenum type,
                   const void *data) const;
 
+  void clear_sub_data(GLenum internalformat, GLintptr offset, GLsizeiptr size,
+                      GLenum format, GLenum type, const void *data) const;
+
   void map(GLenum access) const;
 
   void *map_range(GLintptr offset, GLsizeiptr length, GLbitfield access) const;
@@ -1,39 +1,332 @@
 #include "paimon/opengl/debug_message.h"
 
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <thread>
+
 #include "paimon/core/log_system.h"
 
 using namespace paimon;
 
-DebugMessage::Callback DebugMessage::s_callback =
-    [](const DebugMessage &message) {
-      LOG_ERROR("OpenGL Debug Message: [{}] (source: {}, type: {}, id: {}) {}",
-                message.severityString(), message.sourceString(),
-                message.typeString(), message.m_id, message.m_message);
-    };
+namespace {
+
+// StringInterner stores every distinct message text once in a fixed arena.
+// Drivers repeat the same few messages, so after the first occurrence a
+// message costs a hash and a table probe. Lock-free, slots are claimed with a
+// CAS and published by a release store of the arena offset.
+class StringInterner {
+public:
+  static constexpr uint32_t SlotCount = 4096;
+  static constexpr size_t ArenaSize = 1u << 20;
+  static constexpr uint32_t Invalid = ~0u;
+
+  StringInterner() : m_arena(std::make_unique<char[]>(ArenaSize)) {}
+
+  // Slot of the text, Invalid when the table is full
+  uint32_t intern(std::string_view text) {
+    uint64_t hash = 14695981039346656037ull;
+    for (char c : text) {
+      hash = (hash ^ static_cast<uint8_t>(c)) * 1099511628211ull;
+    }
+    hash |= 1; // zero marks an empty slot
+
+    for (uint32_t probe = 0; probe < SlotCount; ++probe) {
+      auto index = static_cast<uint32_t>(hash + probe) & (SlotCount - 1);
+      auto &slot = m_slots[index];
+
+      uint64_t expected = 0;
+      if (slot.hash.compare_exchange_strong(expected, hash,
+                                            std::memory_order_acq_rel)) {
+        // Claimed, copy the text and publish it
+        auto offset = m_arenaHead.fetch_add(text.size());
+        if (offset + text.size() > ArenaSize) {
+          slot.offset.store(Overflow, std::memory_order_release);
+          return index;
+        }
+        std::memcpy(m_arena.get() + offset, text.data(), text.size());
+        slot.length = static_cast<uint32_t>(text.size());
+        slot.offset.store(static_cast<uint32_t>(offset),
+                          std::memory_order_release);
+        return index;
+      }
+      // Equal hashes of different texts take separate slots
+      if (expected == hash && matches(slot, text)) {
+        return index;
+      }
+    }
+    return Invalid;
+  }
+
+  // Text of a slot, std::nullopt while its writer is still copying it
+  std::optional<std::string_view> lookup(uint32_t index) const {
+    if (index == Invalid) {
+      return "(debug message table full)";
+    }
+    const auto &slot = m_slots[index];
+    auto offset = slot.offset.load(std::memory_order_acquire);
+    if (offset == Pending) {
+      return std::nullopt;
+    }
+    if (offset == Overflow) {
+      return "(debug message arena full)";
+    }
+    return std::string_view(m_arena.get() + offset, slot.length);
+  }
+
+private:
+  static constexpr uint32_t Pending = ~0u;
+  static constexpr uint32_t Overflow = ~0u - 1;
+
+  struct Slot {
+    std::atomic<uint64_t> hash{0};
+    std::atomic<uint32_t> offset{Pending};
+    uint32_t length = 0;
+  };
+
+  // True when a claimed slot holds the text, waits for its writer to
+  // publish it. Overflowed slots have no text and match nothing.
+  bool matches(const Slot &slot, std::string_view text) const {
+    auto offset = slot.offset.load(std::memory_order_acquire);
+    while (offset == Pending) {
+      offset = slot.offset.load(std::memory_order_acquire);
+    }
+    return offset != Overflow && slot.length == text.size() &&
+           std::memcmp(m_arena.get() + offset, text.data(), text.size()) == 0;
+  }
+
+  std::array<Slot, SlotCount> m_slots;
+  std::unique_ptr<char[]> m_arena;
+  std::atomic<size_t> m_arenaHead{0};
+};
+
+struct MessageRecord {
+  GLenum source = 0;
+  GLenum type = 0;
+  GLuint id = 0;
+  GLenum severity = 0;
+  uint32_t text = StringInterner::Invalid;
+};
+
+// Bounded multi-producer ring, each cell carries a sequence number telling
+// producers and the consumer whose turn it is
+class MessageRing {
+public:
+  static constexpr size_t Capacity = 1024;
+
+  MessageRing() {
+    for (size_t i = 0; i < Capacity; ++i) {
+      m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  // Returns false when the ring is full
+  bool push(const MessageRecord &record) {
+    auto position = m_head.load(std::memory_order_relaxed);
+    for (;;) {
+      auto &cell = m_cells[position & (Capacity - 1)];
+      auto sequence = cell.sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<intptr_t>(sequence) -
+                  static_cast<intptr_t>(position);
+      if (diff == 0) {
+        if (m_head.compare_exchange_weak(position, position + 1,
+                                         std::memory_order_relaxed)) {
+          cell.record = record;
+          cell.sequence.store(position + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        position = m_head.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Single consumer
+  bool pop(MessageRecord &record) {
+    auto &cell = m_cells[m_tail & (Capacity - 1)];
+    if (cell.sequence.load(std::memory_order_acquire) != m_tail + 1) {
+      return false;
+    }
+    record = cell.record;
+    cell.sequence.store(m_tail + Capacity, std::memory_order_release);
+    ++m_tail;
+    return true;
+  }
+
+private:
+  struct Cell {
+    std::atomic<size_t> sequence;
+    MessageRecord record;
+  };
+
+  std::array<Cell, Capacity> m_cells;
+  alignas(64) std::atomic<size_t> m_head{0};
+  alignas(64) size_t m_tail = 0;
+};
+
+// Captured messages and the thread that formats and delivers them
+class DebugMessageQueue {
+public:
+  static DebugMessageQueue &get() {
+    static DebugMessageQueue queue;
+    return queue;
+  }
+
+  // The logger may be gone during static destruction, the thread is only
+  // joined here. Messages are delivered by shutdown() at context teardown.
+  ~DebugMessageQueue() {
+    std::lock_guard lock(m_threadMutex);
+    if (m_thread.joinable()) {
+      m_stop.store(true, std::memory_order_release);
+      m_signal.fetch_add(1, std::memory_order_release);
+      m_signal.notify_one();
+      m_thread.join();
+    }
+  }
+
+  void push(GLenum source, GLenum type, GLuint id, GLenum severity,
+            std::string_view text) {
+    MessageRecord record{source, type, id, severity, m_interner.intern(text)};
+    if (!m_ring.push(record)) {
+      m_dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    m_signal.fetch_add(1, std::memory_order_release);
+    m_signal.notify_one();
+  }
+
+  void start() {
+    std::lock_guard lock(m_threadMutex);
+    if (m_thread.joinable()) {
+      return;
+    }
+    m_stop.store(false);
+    m_thread = std::thread([this]() {
+      while (!m_stop.load(std::memory_order_acquire)) {
+        auto signal = m_signal.load(std::memory_order_acquire);
+        drain();
+        m_signal.wait(signal, std::memory_order_acquire);
+      }
+    });
+  }
+
+  void stop() {
+    {
+      std::lock_guard lock(m_threadMutex);
+      if (!m_thread.joinable()) {
+        return;
+      }
+      m_stop.store(true, std::memory_order_release);
+      m_signal.fetch_add(1, std::memory_order_release);
+      m_signal.notify_one();
+      m_thread.join();
+    }
+    drain();
+  }
+
+  void drain() {
+    std::lock_guard lock(m_drainMutex);
+
+    MessageRecord record;
+    while (m_ring.pop(record)) {
+      // A producer may have published the record while another one is
+      // still copying the text of the same slot
+      auto text = m_interner.lookup(record.text);
+      while (!text) {
+        std::this_thread::yield();
+        text = m_interner.lookup(record.text);
+      }
+      m_callback(DebugMessage(record.source, record.type, record.id,
+                              record.severity, std::string(*text)));
+    }
+
+    if (auto dropped = m_dropped.exchange(0, std::memory_order_relaxed)) {
+      m_droppedTotal += dropped;
+      LOG_WARN("OpenGL Debug Message: dropped {} messages", dropped);
+    }
+  }
+
+  void setCallback(DebugMessage::Callback callback) {
+    std::lock_guard lock(m_drainMutex);
+    m_callback = std::move(callback);
+  }
+
+  size_t getDroppedCount() {
+    std::lock_guard lock(m_drainMutex);
+    return m_droppedTotal + m_dropped.load(std::memory_order_relaxed);
+  }
+
+private:
+  DebugMessageQueue() = default;
+
+  StringInterner m_interner;
+  MessageRing m_ring;
+  std::atomic<size_t> m_dropped{0};
+  std::atomic<uint32_t> m_signal{0};
+
+  std::mutex m_drainMutex; // serializes drain() and guards the callback
+  DebugMessage::Callback m_callback = [](const DebugMessage &message) {
+    LOG_ERROR("OpenGL Debug Message: [{}] (source: {}, type: {}, id: {}) {}",
+              message.severityString(), message.sourceString(),
+              message.typeString(), message.idString(), message.message());
+  };
+  size_t m_droppedTotal = 0;
+
+  std::mutex m_threadMutex;
+  std::atomic<bool> m_stop{false};
+  std::thread m_thread;
+};
+
+} // namespace
 
 DebugMessage::DebugMessage(const GLenum source, const GLenum type,
                            const GLuint id, const GLenum severity,
                            const std::string &message)
     : m_source(source), m_type(type), m_id(id), m_severity(severity),
-      m_message(message), m_callback(s_callback) {
-  glDebugMessageCallback(debugMessageCallback, reinterpret_cast<void *>(this));
-}
+      m_message(message) {}
 
-void DebugMessage::enable() { glEnable(GL_DEBUG_OUTPUT); }
+void DebugMessage::enable() {
+  DebugMessageQueue::get().start();
+  glDebugMessageCallback(debugMessageCallback, nullptr);
+  glEnable(GL_DEBUG_OUTPUT);
+}
 
-void DebugMessage::disable() { glDisable(GL_DEBUG_OUTPUT); }
+void DebugMessage::disable() {
+  glDisable(GL_DEBUG_OUTPUT);
+  DebugMessageQueue::get().stop();
+}
 
 bool DebugMessage::isEnabled() { return glIsEnabled(GL_DEBUG_OUTPUT); }
 
 void DebugMessage::setSynchronous(bool synchronous) {
-  glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+  if (synchronous) {
+    glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+  } else {
+    glDisable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+  }
 }
 
 bool DebugMessage::isSynchronous() {
   return glIsEnabled(GL_DEBUG_OUTPUT_SYNCHRONOUS);
 }
 
-void DebugMessage::setCallback(Callback callback) { m_callback = callback; }
+void DebugMessage::setCallback(Callback callback) {
+  DebugMessageQueue::get().setCallback(std::move(callback));
+}
+
+void DebugMessage::flush() { DebugMessageQueue::get().drain(); }
+
+void DebugMessage::shutdown() { DebugMessageQueue::get().stop(); }
+
+size_t DebugMessage::getDroppedCount() {
+  return DebugMessageQueue::get().getDroppedCount();
+}
 
 void DebugMessage::insert(const DebugMessage &message) {
   glDebugMessageInsert(message.m_source, message.m_type, message.m_id,
@@ -113,8 +406,7 @@ void GLAPIENTRY DebugMessage::debugMessageCallback(GLenum source, GLenum type,
                                                    GLsizei length,
                                                    const GLchar *message,
                                                    const void *userParam) {
-  DebugMessage msg(source, type, id, severity, std::string(message, length));
-
-  const auto *debugMessage = reinterpret_cast<const DebugMessage *>(userParam);
-  debugMessage->m_callback(msg);
-}
\ No newline at end of file
+  auto size = length >= 0 ? static_cast<size_t>(length) : std::strlen(message);
+  DebugMessageQueue::get().push(source, type, id, severity,
+                                std::string_view(message, size));
+}
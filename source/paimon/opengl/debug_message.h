@@ -11,8 +11,6 @@ class DebugMessage {
 public:
   using Callback = std::function<void(const DebugMessage &)>;
 
-  static Callback s_callback;
-
 public:
   DebugMessage(GLenum source, GLenum type, GLuint id, GLenum severity,
                const std::string &message);
@@ -29,8 +27,10 @@ public:
 
   std::string message() const;
 
+  // Enable debug output and start the thread that drains captured messages
   static void enable();
 
+  // Disable debug output, messages captured so far are still delivered
   static void disable();
 
   static bool isEnabled();
@@ -39,7 +39,18 @@ public:
 
   static bool isSynchronous();
 
-  void setCallback(Callback callback);
+  // Runs on the drain thread for every captured message, logs by default
+  static void setCallback(Callback callback);
+
+  // Deliver every captured message now
+  static void flush();
+
+  // Stop the drain thread and deliver the remaining messages, call at context
+  // teardown while logging still works. Makes no GL calls.
+  static void shutdown();
+
+  // Messages lost because the capture ring was full
+  static size_t getDroppedCount();
 
   static void insert(const DebugMessage &message);
 
@@ -47,6 +58,8 @@ public:
                       GLsizei count, const GLuint *ids, GLboolean enabled);
 
 private:
+  // Only copies the message into a lock-free ring, it may run on a driver
+  // thread and must not allocate, lock or log
   static void GLAPIENTRY debugMessageCallback(GLenum source, GLenum type,
                                               GLuint id, GLenum severity,
                                               GLsizei length,
@@ -59,7 +72,5 @@ protected:
   GLuint m_id;
   GLenum m_severity;
   std::string m_message;
-
-  Callback m_callback;
 };
-} // namespace paimon
\ No newline at end of file
+} // namespace paimon
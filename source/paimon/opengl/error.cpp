@@ -1,5 +1,7 @@
 #include "paimon/opengl/error.h"
 
+#include "paimon/core/log_system.h"
+
 using namespace paimon;
 
 Error::Error(GLenum errorCode) : m_errorCode(errorCode) {}
@@ -37,3 +39,20 @@ void Error::clear() {
   while (Error::get())
     ;
 }
+
+bool Error::check(const char *what, const char *file, int line) {
+  // glGetError returns one flag per call and several may be recorded, the
+  // bound guards against a lost context that keeps reporting an error
+  constexpr int MaxErrors = 8;
+  bool failed = false;
+  for (int i = 0; i < MaxErrors; ++i) {
+    auto error = Error::get();
+    if (!error) {
+      break;
+    }
+    LOG_ERROR("OpenGL error {} after {} ({}:{})", error.code_string(), what,
+              file, line);
+    failed = true;
+  }
+  return failed;
+}
@@ -4,6 +4,32 @@
 
 #include <glad/gl.h>
 
+// GL error checking level, set by the build (see source/CMakeLists.txt):
+//   0 - no checks, every macro below compiles to the bare call or nothing
+//   1 - PAIMON_GL_CHECKPOINT drains glGetError at coarse points such as the
+//       end of a render scope
+//   2 - PAIMON_GL_CHECK additionally checks after every wrapper call
+#ifndef PAIMON_GL_CHECK_LEVEL
+#define PAIMON_GL_CHECK_LEVEL 0
+#endif
+
+#if PAIMON_GL_CHECK_LEVEL >= 2
+#define PAIMON_GL_CHECK(call)                                                 \
+  do {                                                                        \
+    call;                                                                     \
+    ::paimon::Error::check(#call, __FILE__, __LINE__);                        \
+  } while (0)
+#else
+#define PAIMON_GL_CHECK(call) call
+#endif
+
+#if PAIMON_GL_CHECK_LEVEL >= 1
+#define PAIMON_GL_CHECKPOINT(label)                                           \
+  ::paimon::Error::check(label, __FILE__, __LINE__)
+#else
+#define PAIMON_GL_CHECKPOINT(label) ((void)0)
+#endif
+
 namespace paimon {
 
 class Error {
@@ -22,6 +48,9 @@ public:
 
   static void clear();
 
+  // Drain and log every pending error, returns true when there was one
+  static bool check(const char *what, const char *file, int line);
+
 protected:
   GLenum m_errorCode;
 };
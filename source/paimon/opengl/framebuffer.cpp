@@ -1,5 +1,6 @@
 #include "paimon/opengl/framebuffer.h"
 #include "framebuffer.h"
+#include "paimon/opengl/error.h"
 #include "paimon/opengl/texture.h"
 #include "render_buffer.h"
 
@@ -27,13 +28,13 @@ Framebuffer::Framebuffer(bool isDefault) : NamedObject(GL_FRAMEBUFFER) {
   if (isDefault) {
     m_name = 0;
   } else {
-    glCreateFramebuffers(1, &m_name);
+    PAIMON_GL_CHECK(glCreateFramebuffers(1, &m_name));
   }
 }
 
 Framebuffer::~Framebuffer() {
   if (m_name != 0) {
-    glDeleteFramebuffers(1, &m_name);
+    PAIMON_GL_CHECK(glDeleteFramebuffers(1, &m_name));
   }
 }
 
@@ -45,7 +46,8 @@ void Framebuffer::unbind() { glBindFramebuffer(GL_FRAMEBUFFER, 0); }
 
 void Framebuffer::attachTexture(GLenum attachment, Texture *texture,
                                 GLint level) {
-  glNamedFramebufferTexture(m_name, attachment, texture->get_name(), level);
+  PAIMON_GL_CHECK(glNamedFramebufferTexture(m_name, attachment,
+                                            texture->get_name(), level));
 
   addAttachment(
       std::make_unique<TextureAttachment>(this, attachment, texture, level));
@@ -53,8 +55,9 @@ void Framebuffer::attachTexture(GLenum attachment, Texture *texture,
 
 void Framebuffer::attachTextureLayer(GLenum attachment, Texture *texture,
                                      GLint level, GLint layer) {
-  glNamedFramebufferTextureLayer(m_name, attachment, texture->get_name(), level,
-                                 layer);
+  PAIMON_GL_CHECK(glNamedFramebufferTextureLayer(m_name, attachment,
+                                                 texture->get_name(), level,
+                                                 layer));
 
   addAttachment(std::make_unique<TextureAttachment>(this, attachment, texture,
                                                     level, layer));
@@ -62,29 +65,30 @@ void Framebuffer::attachTextureLayer(GLenum attachment, Texture *texture,
 
 void Framebuffer::attachRenderbuffer(GLenum attachment,
                                      Renderbuffer *renderbuffer) {
-  glNamedFramebufferRenderbuffer(m_name, attachment, GL_RENDERBUFFER,
-                                 renderbuffer->get_name());
+  PAIMON_GL_CHECK(glNamedFramebufferRenderbuffer(m_name, attachment,
+                                                 GL_RENDERBUFFER,
+                                                 renderbuffer->get_name()));
 
   addAttachment(
       std::make_unique<RenderbufferAttachment>(this, attachment, renderbuffer));
 }
 
 void Framebuffer::setDrawBuffers(GLsizei n, const GLenum *bufs) const {
-  glNamedFramebufferDrawBuffers(m_name, n, bufs);
+  PAIMON_GL_CHECK(glNamedFramebufferDrawBuffers(m_name, n, bufs));
 }
 
 void Framebuffer::setReadBuffer(GLenum src) const {
-  glNamedFramebufferDrawBuffer(m_name, src);
+  PAIMON_GL_CHECK(glNamedFramebufferDrawBuffer(m_name, src));
 }
 
 void Framebuffer::invalidate(GLsizei n, const GLenum *attachments) const {
-  glInvalidateNamedFramebufferData(m_name, n, attachments);
+  PAIMON_GL_CHECK(glInvalidateNamedFramebufferData(m_name, n, attachments));
 }
 
 void Framebuffer::invalidateSub(GLsizei n, const GLenum *attachments, GLint x,
                                 GLint y, GLsizei width, GLsizei height) const {
-  glInvalidateNamedFramebufferSubData(m_name, n, attachments, x, y, width,
-                                      height);
+  PAIMON_GL_CHECK(glInvalidateNamedFramebufferSubData(m_name, n, attachments, x,
+                                                      y, width, height));
 }
 
 bool Framebuffer::isComplete(GLenum target) const {
@@ -93,28 +97,32 @@ bool Framebuffer::isComplete(GLenum target) const {
 }
 
 void Framebuffer::set(GLenum param, GLint value) const {
-  glNamedFramebufferParameteri(m_name, param, value);
+  PAIMON_GL_CHECK(glNamedFramebufferParameteri(m_name, param, value));
 }
 
 template <>
 void Framebuffer::clear(GLenum buffer, GLint draw_buffer,
                         const GLfloat *value) {
-  glClearNamedFramebufferfv(m_name, buffer, draw_buffer, value);
+  PAIMON_GL_CHECK(glClearNamedFramebufferfv(m_name, buffer, draw_buffer,
+                                            value));
 }
 
 template <>
 void Framebuffer::clear(GLenum buffer, GLint draw_buffer, const GLint *value) {
-  glClearNamedFramebufferiv(m_name, buffer, draw_buffer, value);
+  PAIMON_GL_CHECK(glClearNamedFramebufferiv(m_name, buffer, draw_buffer,
+                                            value));
 }
 
 template <>
 void Framebuffer::clear(GLenum buffer, GLint draw_buffer, const GLuint *value) {
-  glClearNamedFramebufferuiv(m_name, buffer, draw_buffer, value);
+  PAIMON_GL_CHECK(glClearNamedFramebufferuiv(m_name, buffer, draw_buffer,
+                                             value));
 }
 
 void Framebuffer::clear(GLenum buffer, GLint draw_buffer, GLfloat depth,
                         GLint stencil) {
-  glClearNamedFramebufferfi(m_name, buffer, draw_buffer, depth, stencil);
+  PAIMON_GL_CHECK(glClearNamedFramebufferfi(m_name, buffer, draw_buffer, depth,
+                                            stencil));
 }
 
 void Framebuffer::addAttachment(
@@ -2,20 +2,22 @@
 
 #include <vector>
 
+#include "paimon/opengl/error.h"
+
 using namespace paimon;
 
 Program::Program() : NamedObject(GL_PROGRAM) { m_name = glCreateProgram(); }
 
 Program::~Program() {
   if (m_name != 0) {
-    glDeleteProgram(m_name);
+    PAIMON_GL_CHECK(glDeleteProgram(m_name));
   }
 }
 
 bool Program::is_valid() const { return glIsProgram(m_name) == GL_TRUE; }
 
 void Program::get(GLenum pname, GLint *params) const {
-  glGetProgramiv(m_name, pname, params);
+  PAIMON_GL_CHECK(glGetProgramiv(m_name, pname, params));
 }
 
 GLint Program::get(GLenum pname) const {
@@ -29,7 +31,7 @@ void Program::set(GLenum pname, GLint param) const {
   // if pname is GL_PROGRAM_SEPARABLE, must be set to GL_TRUE before
   // glLinkProgram is called if pname is GL_PROGRAM_BINARY_RETRIEVABLE_HINT,
   // recommended to be set to GL_TRUE before glLinkProgram is called
-  glProgramParameteri(m_name, pname, param);
+  PAIMON_GL_CHECK(glProgramParameteri(m_name, pname, param));
 }
 
 std::string Program::get_info_log() const {
@@ -39,20 +41,20 @@ std::string Program::get_info_log() const {
   }
 
   std::vector<GLchar> info_log(length);
-  glGetProgramInfoLog(m_name, length, 0, info_log.data());
+  PAIMON_GL_CHECK(glGetProgramInfoLog(m_name, length, 0, info_log.data()));
   return std::string(info_log.data(), length);
 }
 
 void Program::attach(const Shader &shader) const {
-  glAttachShader(m_name, shader.get_name());
+  PAIMON_GL_CHECK(glAttachShader(m_name, shader.get_name()));
 }
 
 void Program::detach(const Shader &shader) const {
-  glDetachShader(m_name, shader.get_name());
+  PAIMON_GL_CHECK(glDetachShader(m_name, shader.get_name()));
 }
 
 bool Program::link() const {
-  glLinkProgram(m_name);
+  PAIMON_GL_CHECK(glLinkProgram(m_name));
   return get(GL_LINK_STATUS) == GL_TRUE;
 }
 
@@ -0,0 +1,176 @@
+#include "paimon/opengl/program_interface.h"
+
+#include <algorithm>
+#include <array>
+
+#include "paimon/core/log_system.h"
+#include "paimon/opengl/error.h"
+
+using namespace paimon;
+
+namespace {
+
+std::string getResourceName(GLuint program, GLenum programInterface,
+                            GLuint index, GLint length) {
+  std::string name(static_cast<size_t>(std::max(length, 1)), '\0');
+  GLsizei written = 0;
+  PAIMON_GL_CHECK(glGetProgramResourceName(program, programInterface, index,
+                                           length, &written, name.data()));
+  name.resize(static_cast<size_t>(written));
+  return name;
+}
+
+// Blocks with an instance name report members as "Block.member"
+std::string stripBlockName(std::string name, const std::string &block) {
+  if (name.size() > block.size() && name.starts_with(block) &&
+      name[block.size()] == '.') {
+    name.erase(0, block.size() + 1);
+  }
+  return name;
+}
+
+std::vector<ProgramInterface::Block> reflectBlocks(GLuint program,
+                                                   GLenum blockInterface,
+                                                   GLenum memberInterface) {
+  GLint count = 0;
+  PAIMON_GL_CHECK(glGetProgramInterfaceiv(program, blockInterface,
+                                          GL_ACTIVE_RESOURCES, &count));
+
+  std::vector<ProgramInterface::Block> blocks(static_cast<size_t>(count));
+  for (GLint i = 0; i < count; ++i) {
+    auto &block = blocks[i];
+    constexpr std::array<GLenum, 4> props = {
+        GL_NAME_LENGTH, GL_BUFFER_BINDING, GL_BUFFER_DATA_SIZE,
+        GL_NUM_ACTIVE_VARIABLES};
+    std::array<GLint, props.size()> values{};
+    PAIMON_GL_CHECK(glGetProgramResourceiv(
+        program, blockInterface, i, props.size(), props.data(), values.size(),
+        nullptr, values.data()));
+    block.name = getResourceName(program, blockInterface, i, values[0]);
+    block.binding = values[1];
+    block.dataSize = values[2];
+
+    std::vector<GLint> variables(static_cast<size_t>(values[3]));
+    if (variables.empty()) {
+      continue;
+    }
+    constexpr GLenum activeVariables = GL_ACTIVE_VARIABLES;
+    PAIMON_GL_CHECK(glGetProgramResourceiv(
+        program, blockInterface, i, 1, &activeVariables,
+        static_cast<GLsizei>(variables.size()), nullptr, variables.data()));
+
+    block.members.reserve(variables.size());
+    for (auto variable : variables) {
+      constexpr std::array<GLenum, 6> memberProps = {
+          GL_NAME_LENGTH,  GL_TYPE,         GL_OFFSET,
+          GL_ARRAY_SIZE,   GL_ARRAY_STRIDE, GL_MATRIX_STRIDE};
+      std::array<GLint, memberProps.size()> memberValues{};
+      PAIMON_GL_CHECK(glGetProgramResourceiv(
+          program, memberInterface, static_cast<GLuint>(variable),
+          memberProps.size(), memberProps.data(), memberValues.size(), nullptr,
+          memberValues.data()));
+
+      ProgramInterface::Member member;
+      member.name = stripBlockName(
+          getResourceName(program, memberInterface,
+                          static_cast<GLuint>(variable), memberValues[0]),
+          block.name);
+      member.type = static_cast<GLenum>(memberValues[1]);
+      member.offset = memberValues[2];
+      member.arraySize = memberValues[3];
+      member.arrayStride = memberValues[4];
+      member.matrixStride = memberValues[5];
+      block.members.push_back(std::move(member));
+    }
+
+    std::sort(block.members.begin(), block.members.end(),
+              [](const auto &a, const auto &b) { return a.offset < b.offset; });
+  }
+  return blocks;
+}
+
+template <typename T>
+const T *findByName(const std::vector<T> &resources, std::string_view name) {
+  auto it = std::find_if(resources.begin(), resources.end(),
+                         [name](const T &resource) {
+                           return resource.name == name;
+                         });
+  return it != resources.end() ? &*it : nullptr;
+}
+
+} // namespace
+
+ProgramInterface ProgramInterface::reflect(GLuint program) {
+  // Not named interface, a macro on Windows
+  ProgramInterface reflected;
+  reflected.uniformBlocks =
+      reflectBlocks(program, GL_UNIFORM_BLOCK, GL_UNIFORM);
+  reflected.storageBlocks =
+      reflectBlocks(program, GL_SHADER_STORAGE_BLOCK, GL_BUFFER_VARIABLE);
+
+  GLint count = 0;
+  PAIMON_GL_CHECK(glGetProgramInterfaceiv(program, GL_UNIFORM,
+                                          GL_ACTIVE_RESOURCES, &count));
+  for (GLint i = 0; i < count; ++i) {
+    constexpr std::array<GLenum, 5> props = {
+        GL_NAME_LENGTH, GL_TYPE, GL_LOCATION, GL_ARRAY_SIZE, GL_BLOCK_INDEX};
+    std::array<GLint, props.size()> values{};
+    PAIMON_GL_CHECK(glGetProgramResourceiv(program, GL_UNIFORM, i,
+                                           props.size(), props.data(),
+                                           values.size(), nullptr,
+                                           values.data()));
+    if (values[4] != -1) {
+      continue; // member of a uniform block
+    }
+
+    Uniform uniform;
+    uniform.name = getResourceName(program, GL_UNIFORM, i, values[0]);
+    uniform.type = static_cast<GLenum>(values[1]);
+    uniform.location = values[2];
+    uniform.arraySize = values[3];
+    reflected.uniforms.push_back(std::move(uniform));
+  }
+  return reflected;
+}
+
+const ProgramInterface::Member *
+ProgramInterface::Block::find_member(std::string_view name) const {
+  return findByName(members, name);
+}
+
+const ProgramInterface::Block *
+ProgramInterface::find_uniform_block(std::string_view name) const {
+  return findByName(uniformBlocks, name);
+}
+
+const ProgramInterface::Block *
+ProgramInterface::find_storage_block(std::string_view name) const {
+  return findByName(storageBlocks, name);
+}
+
+const ProgramInterface::Uniform *
+ProgramInterface::find_uniform(std::string_view name) const {
+  return findByName(uniforms, name);
+}
+
+bool ProgramInterface::check_block_layout(
+    const Block &block, size_t size,
+    std::span<const BlockMemberLayout> members) {
+  bool matches = true;
+  if (static_cast<size_t>(block.dataSize) > size) {
+    LOG_ERROR("Block {} is {} bytes in the shader but {} bytes in C++",
+              block.name, block.dataSize, size);
+    matches = false;
+  }
+
+  for (const auto &layout : members) {
+    const auto *member = block.find_member(layout.name);
+    if (member && static_cast<size_t>(member->offset) != layout.offset) {
+      LOG_ERROR("Block {} member {} is at offset {} in the shader but {} in "
+                "C++",
+                block.name, layout.name, member->offset, layout.offset);
+      matches = false;
+    }
+  }
+  return matches;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <glad/gl.h>
+
+namespace paimon {
+
+// Offset of a member in a C++ mirror of a GLSL block, named as in GLSL
+// relative to the block, e.g. {"lights[0].color", offsetof(...)}
+struct BlockMemberLayout {
+  std::string_view name;
+  size_t offset = 0;
+};
+
+// Active resources of a linked program as reported by the driver, queried
+// once through the program interface API
+struct ProgramInterface {
+  struct Member {
+    std::string name; // relative to the block
+    GLenum type = GL_NONE;
+    GLint offset = 0;
+    GLint arraySize = 1;
+    GLint arrayStride = 0;
+    GLint matrixStride = 0;
+  };
+
+  struct Block {
+    std::string name;
+    GLint binding = 0;
+    GLint dataSize = 0;
+    std::vector<Member> members;
+
+    const Member *find_member(std::string_view name) const;
+  };
+
+  // Uniform outside of any block
+  struct Uniform {
+    std::string name;
+    GLenum type = GL_NONE;
+    GLint location = -1;
+    GLint arraySize = 1;
+  };
+
+  std::vector<Block> uniformBlocks;
+  std::vector<Block> storageBlocks;
+  std::vector<Uniform> uniforms;
+
+  static ProgramInterface reflect(GLuint program);
+
+  const Block *find_uniform_block(std::string_view name) const;
+  const Block *find_storage_block(std::string_view name) const;
+  const Uniform *find_uniform(std::string_view name) const;
+
+  // Compare a C++ mirror of a block with the driver layout, logging every
+  // mismatch. Blocks and members the program does not use pass.
+  static bool check_block_layout(const Block &block, size_t size,
+                                 std::span<const BlockMemberLayout> members);
+};
+
+} // namespace paimon
@@ -3,16 +3,17 @@
 #include <glad/gl.h>
 
 #include "paimon/opengl/base/object.h"
+#include "paimon/opengl/error.h"
 
 using namespace paimon;
 
 Query::Query(GLenum type) : NamedObject(GL_QUERY), m_type(type) {
-  glCreateQueries(m_type, 1, &m_name);
+  PAIMON_GL_CHECK(glCreateQueries(m_type, 1, &m_name));
 }
 
 Query::~Query() {
   if (m_name != 0) {
-    glDeleteQueries(1, &m_name);
+    PAIMON_GL_CHECK(glDeleteQueries(1, &m_name));
     m_name = 0;
   }
 }
@@ -24,50 +25,52 @@ void Query::begin() { glBeginQuery(m_type, m_name); }
 
 void Query::end() { glEndQuery(m_type); }
 
+void Query::query_counter() { glQueryCounter(m_name, GL_TIMESTAMP); }
+
 template <>
 void Query::get<GLint>(GLenum property, GLint *rslt) {
-  glGetQueryObjectiv(m_name, property, rslt);
+  PAIMON_GL_CHECK(glGetQueryObjectiv(m_name, property, rslt));
 }
 
 template <>
 void Query::get<GLuint>(GLenum property, GLuint *rslt) {
-  glGetQueryObjectuiv(m_name, property, rslt);
+  PAIMON_GL_CHECK(glGetQueryObjectuiv(m_name, property, rslt));
 }
 
 template <>
 void Query::get<GLint64>(GLenum property, GLint64 *rslt) {
-  glGetQueryObjecti64v(m_name, property, rslt);
+  PAIMON_GL_CHECK(glGetQueryObjecti64v(m_name, property, rslt));
 }
 
 template <>
 void Query::get<GLuint64>(GLenum property, GLuint64 *rslt) {
-  glGetQueryObjectui64v(m_name, property, rslt);
+  PAIMON_GL_CHECK(glGetQueryObjectui64v(m_name, property, rslt));
 }
 
 template <>
 GLint Query::get<GLint>(GLenum property) {
   GLint rslt;
-  glGetQueryObjectiv(m_name, property, &rslt);
+  PAIMON_GL_CHECK(glGetQueryObjectiv(m_name, property, &rslt));
   return rslt;
 }
 
 template <>
 GLuint Query::get<GLuint>(GLenum property) {
   GLuint rslt;
-  glGetQueryObjectuiv(m_name, property, &rslt);
+  PAIMON_GL_CHECK(glGetQueryObjectuiv(m_name, property, &rslt));
   return rslt;
 }
 
 template <>
 GLint64 Query::get<GLint64>(GLenum property) {
   GLint64 rslt;
-  glGetQueryObjecti64v(m_name, property, &rslt);
+  PAIMON_GL_CHECK(glGetQueryObjecti64v(m_name, property, &rslt));
   return rslt;
 }
 
 template <>
 GLuint64 Query::get<GLuint64>(GLenum property) {
   GLuint64 rslt;
-  glGetQueryObjectui64v(m_name, property, &rslt);
+  PAIMON_GL_CHECK(glGetQueryObjectui64v(m_name, property, &rslt));
   return rslt;
 }
\ No newline at end of file
@@ -23,6 +23,10 @@ public:
 
   void end();
 
+  // Record the GPU time once all previous commands have completed, only valid
+  // for GL_TIMESTAMP queries
+  void query_counter();
+
   template <class T>
   void get(GLenum property, T *value);
 
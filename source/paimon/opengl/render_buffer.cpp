@@ -2,15 +2,17 @@
 
 #include <glad/gl.h>
 
+#include "paimon/opengl/error.h"
+
 using namespace paimon;
 
 Renderbuffer::Renderbuffer() : NamedObject(GL_RENDERBUFFER) {
-  glCreateRenderbuffers(1, &m_name);
+  PAIMON_GL_CHECK(glCreateRenderbuffers(1, &m_name));
 }
 
 Renderbuffer::~Renderbuffer() {
   if (m_name != 0) {
-    glDeleteRenderbuffers(1, &m_name);
+    PAIMON_GL_CHECK(glDeleteRenderbuffers(1, &m_name));
   }
 }
 
@@ -20,17 +22,21 @@ void Renderbuffer::bind() const { glBindRenderbuffer(GL_RENDERBUFFER, m_name); }
 
 void Renderbuffer::storage(GLenum internalformat, GLsizei width,
                            GLsizei height) {
-  glNamedRenderbufferStorage(m_name, internalformat, width, height);
+  PAIMON_GL_CHECK(glNamedRenderbufferStorage(m_name, internalformat, width,
+                                             height));
 }
 
 void Renderbuffer::storage_multisample(GLsizei samples, GLenum internalformat,
                                        GLsizei width, GLsizei height) {
-  glNamedRenderbufferStorageMultisample(m_name, samples, internalformat,
-                                       width, height);
+  PAIMON_GL_CHECK(glNamedRenderbufferStorageMultisample(m_name, samples,
+                                                        internalformat, width,
+                                                        height));
 }
 
 void Renderbuffer::get(GLint &value) const {
-  glGetNamedRenderbufferParameteriv(m_name, GL_RENDERBUFFER_WIDTH, &value);
+  PAIMON_GL_CHECK(glGetNamedRenderbufferParameteriv(m_name,
+                                                    GL_RENDERBUFFER_WIDTH,
+                                                    &value));
 }
 
 GLint Renderbuffer::get() const {
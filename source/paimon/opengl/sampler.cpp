@@ -2,13 +2,15 @@
 
 #include <glad/gl.h>
 
+#include "paimon/opengl/error.h"
+
 using namespace paimon;
 
 Sampler::Sampler() : NamedObject(GL_SAMPLER) { glCreateSamplers(1, &m_name); }
 
 Sampler::~Sampler() {
   if (m_name != 0) {
-    glDeleteSamplers(1, &m_name);
+    PAIMON_GL_CHECK(glDeleteSamplers(1, &m_name));
   }
 }
 
@@ -18,12 +20,12 @@ void Sampler::bind(GLuint unit) const { glBindSampler(unit, m_name); }
 
 template <>
 void Sampler::get<GLint>(GLenum property, GLint *value) {
-  glGetSamplerParameteriv(m_name, property, value);
+  PAIMON_GL_CHECK(glGetSamplerParameteriv(m_name, property, value));
 }
 
 template <>
 void Sampler::get<GLfloat>(GLenum property, GLfloat *value) {
-  glGetSamplerParameterfv(m_name, property, value);
+  PAIMON_GL_CHECK(glGetSamplerParameterfv(m_name, property, value));
 }
 
 template <>
@@ -42,35 +44,36 @@ GLfloat Sampler::get<GLfloat>(GLenum property) {
 
 template <>
 void Sampler::set<GLint>(GLenum property, GLint value) {
-  glSamplerParameteri(m_name, property, value);
+  PAIMON_GL_CHECK(glSamplerParameteri(m_name, property, value));
 }
 
 template <>
 void Sampler::set<GLenum>(GLenum property, GLenum value) {
-  glSamplerParameteri(m_name, property, static_cast<GLint>(value));
+  PAIMON_GL_CHECK(glSamplerParameteri(m_name, property,
+                                      static_cast<GLint>(value)));
 }
 
 template <>
 void Sampler::set<GLfloat>(GLenum property, GLfloat value) {
-  glSamplerParameterf(m_name, property, value);
+  PAIMON_GL_CHECK(glSamplerParameterf(m_name, property, value));
 }
 
 template <>
 void Sampler::set<GLint *>(GLenum property, GLint *value) {
-  glSamplerParameteriv(m_name, property, value);
+  PAIMON_GL_CHECK(glSamplerParameteriv(m_name, property, value));
 }
 
 template <>
 void Sampler::set<GLfloat *>(GLenum property, GLfloat *value) {
-  glSamplerParameterfv(m_name, property, value);
+  PAIMON_GL_CHECK(glSamplerParameterfv(m_name, property, value));
 }
 
 template <>
 void Sampler::set<const GLint *>(GLenum property, const GLint *value) {
-  glSamplerParameteriv(m_name, property, value);
+  PAIMON_GL_CHECK(glSamplerParameteriv(m_name, property, value));
 }
 
 template <>
 void Sampler::set<const GLfloat *>(GLenum property, const GLfloat *value) {
-  glSamplerParameterfv(m_name, property, value);
+  PAIMON_GL_CHECK(glSamplerParameterfv(m_name, property, value));
 }
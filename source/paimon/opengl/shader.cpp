@@ -2,6 +2,8 @@
 
 #include <vector>
 
+#include "paimon/opengl/error.h"
+
 using namespace paimon;
 
 Shader::Shader(GLenum type) : NamedObject(GL_SHADER), m_type(type) {
@@ -10,14 +12,14 @@ Shader::Shader(GLenum type) : NamedObject(GL_SHADER), m_type(type) {
 
 Shader::~Shader() {
   if (m_name != 0) {
-    glDeleteShader(m_name);
+    PAIMON_GL_CHECK(glDeleteShader(m_name));
   }
 }
 
 bool Shader::is_valid() const { return glIsShader(m_name) == GL_TRUE; }
 
 void Shader::get(GLenum pname, GLint *params) const {
-  glGetShaderiv(m_name, pname, params);
+  PAIMON_GL_CHECK(glGetShaderiv(m_name, pname, params));
 }
 
 GLint Shader::get(GLenum pname) const {
@@ -33,7 +35,7 @@ std::string Shader::get_info_log() const {
   }
 
   std::vector<GLchar> info_log(length);
-  glGetShaderInfoLog(m_name, length, 0, info_log.data());
+  PAIMON_GL_CHECK(glGetShaderInfoLog(m_name, length, 0, info_log.data()));
   return std::string(info_log.data(), length);
 }
 
@@ -44,7 +46,7 @@ std::string Shader::get_source() const {
   }
 
   std::vector<GLchar> source(length);
-  glGetShaderSource(m_name, length, 0, source.data());
+  PAIMON_GL_CHECK(glGetShaderSource(m_name, length, 0, source.data()));
   return std::string(source.data(), length);
 }
 
@@ -52,8 +54,8 @@ GLenum Shader::get_type() const { return m_type; }
 
 bool Shader::compile(const std::string &source) {
   const GLchar *sources = source.c_str();
-  glShaderSource(m_name, 1, &sources, 0);
-  glCompileShader(m_name);
+  PAIMON_GL_CHECK(glShaderSource(m_name, 1, &sources, 0));
+  PAIMON_GL_CHECK(glCompileShader(m_name));
 
   return get(GL_COMPILE_STATUS) == GL_TRUE;
 }
\ No newline at end of file
@@ -1,20 +1,75 @@
 #include "paimon/opengl/shader_program.h"
 
+#include <chrono>
 #include <vector>
 
 #include <glad/gl.h>
 
+#include "paimon/opengl/error.h"
+
 using namespace paimon;
 
-ShaderProgram::ShaderProgram(GLenum type, const std::string &source)
+ShaderProgram::ShaderProgram(GLenum type, const std::string &source,
+                             bool retrievable, ShaderBuildTimes *times)
     : NamedObject(GL_PROGRAM) {
   const GLchar *sources = source.c_str();
-  m_name = glCreateShaderProgramv(type, 1, &sources);
+  if (!retrievable && !times) {
+    m_name = glCreateShaderProgramv(type, 1, &sources);
+    return;
+  }
+
+  // Same steps as glCreateShaderProgramv, with the retrievable hint set
+  // before linking when asked for. Nothing is queried here unless the steps
+  // are timed, with GL_KHR_parallel_shader_compile the driver keeps compiling
+  // in the background until is_completed() reports it is done.
+  using Clock = std::chrono::steady_clock;
+  auto start = Clock::now();
+  auto step = start;
+  auto elapsedMs = [](Clock::time_point since) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - since)
+        .count();
+  };
+
+  m_shader = glCreateShader(type);
+  PAIMON_GL_CHECK(glShaderSource(m_shader, 1, &sources, nullptr));
+  PAIMON_GL_CHECK(glCompileShader(m_shader));
+  if (times) {
+    GLint status = GL_FALSE;
+    PAIMON_GL_CHECK(glGetShaderiv(m_shader, GL_COMPILE_STATUS, &status));
+    times->compileMs = elapsedMs(step);
+    step = Clock::now();
+  }
+
+  m_name = glCreateProgram();
+  PAIMON_GL_CHECK(glProgramParameteri(m_name, GL_PROGRAM_SEPARABLE, GL_TRUE));
+  if (retrievable) {
+    PAIMON_GL_CHECK(glProgramParameteri(
+        m_name, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+  }
+  PAIMON_GL_CHECK(glAttachShader(m_name, m_shader));
+  PAIMON_GL_CHECK(glLinkProgram(m_name));
+  if (times) {
+    get(GL_LINK_STATUS);
+    times->linkMs = elapsedMs(step);
+    times->totalMs = elapsedMs(start);
+  }
+}
+
+ShaderProgram::ShaderProgram(GLenum binary_format, const void *binary,
+                             GLsizei length)
+    : NamedObject(GL_PROGRAM) {
+  m_name = glCreateProgram();
+  PAIMON_GL_CHECK(glProgramParameteri(m_name, GL_PROGRAM_SEPARABLE, GL_TRUE));
+  // A rejected binary is reported through the link status, not an error
+  glProgramBinary(m_name, binary_format, binary, length);
 }
 
 ShaderProgram::~ShaderProgram() {
+  if (m_shader != 0) {
+    PAIMON_GL_CHECK(glDeleteShader(m_shader));
+  }
   if (m_name != 0) {
-    glDeleteProgram(m_name);
+    PAIMON_GL_CHECK(glDeleteProgram(m_name));
   }
 }
 
@@ -23,7 +78,19 @@ bool ShaderProgram::is_valid() const {
 }
 
 void ShaderProgram::get(GLenum pname, GLint *params) const {
-  glGetProgramiv(m_name, pname, params);
+  PAIMON_GL_CHECK(glGetProgramiv(m_name, pname, params));
+}
+
+bool ShaderProgram::is_linked() const {
+  release_shader();
+  return m_name != 0 && get(GL_LINK_STATUS) == GL_TRUE;
+}
+
+bool ShaderProgram::is_completed() const {
+  if (m_name == 0 || !GLAD_GL_KHR_parallel_shader_compile) {
+    return true;
+  }
+  return get(GL_COMPLETION_STATUS_KHR) == GL_TRUE;
 }
 
 GLint ShaderProgram::get(GLenum pname) const {
@@ -33,12 +100,54 @@ GLint ShaderProgram::get(GLenum pname) const {
 }
 
 std::string ShaderProgram::get_info_log() const {
+  release_shader();
   GLint length = get(GL_INFO_LOG_LENGTH);
   if (length == 0) {
-    return std::string();
+    return m_compile_log;
   }
 
   std::vector<GLchar> info_log(length);
-  glGetProgramInfoLog(m_name, length, 0, info_log.data());
-  return std::string(info_log.data(), length);
+  PAIMON_GL_CHECK(glGetProgramInfoLog(m_name, length, 0, info_log.data()));
+  return m_compile_log + std::string(info_log.data(), length);
+}
+
+std::vector<uint8_t> ShaderProgram::get_binary(GLenum &binary_format) const {
+  release_shader();
+  GLint length = get(GL_PROGRAM_BINARY_LENGTH);
+  if (length <= 0) {
+    return {};
+  }
+
+  std::vector<uint8_t> binary(length);
+  GLsizei written = 0;
+  PAIMON_GL_CHECK(glGetProgramBinary(m_name, length, &written, &binary_format,
+                                     binary.data()));
+  binary.resize(written);
+  return binary;
+}
+
+const ProgramInterface &ShaderProgram::get_interface() const {
+  if (!m_interface) {
+    m_interface = std::make_unique<ProgramInterface>(
+        is_linked() ? ProgramInterface::reflect(m_name) : ProgramInterface{});
+  }
+  return *m_interface;
+}
+
+void ShaderProgram::release_shader() const {
+  if (m_shader == 0) {
+    return;
+  }
+
+  GLint length = 0;
+  PAIMON_GL_CHECK(glGetShaderiv(m_shader, GL_INFO_LOG_LENGTH, &length));
+  if (length > 0) {
+    std::vector<GLchar> compile_log(length);
+    PAIMON_GL_CHECK(
+        glGetShaderInfoLog(m_shader, length, nullptr, compile_log.data()));
+    m_compile_log.assign(compile_log.data());
+  }
+  PAIMON_GL_CHECK(glDetachShader(m_name, m_shader));
+  PAIMON_GL_CHECK(glDeleteShader(m_shader));
+  m_shader = 0;
 }
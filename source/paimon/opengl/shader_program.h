@@ -1,11 +1,35 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "paimon/opengl/base/object.h"
+#include "paimon/opengl/program_interface.h"
 
 namespace paimon {
+
+// Wall times of building a program. Compile and link are only timed apart
+// when the build blocks on each step, they stay zero otherwise.
+struct ShaderBuildTimes {
+  double totalMs = 0.0;
+  double compileMs = 0.0;
+  double linkMs = 0.0;
+};
+
 class ShaderProgram : public NamedObject {
 public:
-  ShaderProgram(GLenum type, const std::string &source);
+  // Compile and link a separable program from source. Retrievable programs
+  // are linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT so get_binary works.
+  // With times the constructor waits for the compile before linking and for
+  // the link, and records how long each step took.
+  ShaderProgram(GLenum type, const std::string &source,
+                bool retrievable = false, ShaderBuildTimes *times = nullptr);
+
+  // Load a separable program from a binary returned by get_binary, check
+  // is_linked() since drivers reject binaries from other versions
+  ShaderProgram(GLenum binary_format, const void *binary, GLsizei length);
 
   ~ShaderProgram() override;
 
@@ -14,6 +38,13 @@ public:
 
   bool is_valid() const override;
 
+  bool is_linked() const;
+
+  // False while the driver is still compiling or linking in the background,
+  // status queries block until then. Always true without
+  // GL_KHR_parallel_shader_compile.
+  bool is_completed() const;
+
 public:
   void get(GLenum pname, GLint *params) const;
   GLint get(GLenum pname) const;
@@ -22,7 +53,26 @@ public:
 
   std::string get_info_log() const;
 
+  std::vector<uint8_t> get_binary(GLenum &binary_format) const;
+
+  // Blocks and uniforms of the linked program, reflected on first use and
+  // cached, empty when the program failed to link
+  const ProgramInterface &get_interface() const;
+
+private:
+  // Collect the compile log and delete the shader of the retrievable path
+  void release_shader() const;
+
 private:
+  // Shader of the retrievable path, kept until the first status query so the
+  // compile is not waited on in the constructor
+  mutable GLuint m_shader = 0;
+
+  // Compile log of the retrievable path, glCreateShaderProgramv appends it to
+  // the program log itself
+  mutable std::string m_compile_log;
+
+  mutable std::unique_ptr<ProgramInterface> m_interface;
 };
 
 } // namespace paimon
\ No newline at end of file
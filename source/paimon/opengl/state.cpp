@@ -1,16 +1,61 @@
 #include "paimon/opengl/state.h"
 
+#include "paimon/opengl/error.h"
+
 using namespace paimon;
 
-void PipelineState::apply(const PipelineState &state) {
-  apply(state.colorBlend);
-  apply(state.depthStencil);
-  apply(state.inputAssembly);
-  apply(state.multisample);
-  apply(state.rasterization);
-  apply(state.tessellation);
+void PipelineState::apply(const PipelineState &state, uint32_t groups) {
+  if (groups & ColorBlendGroup) {
+    apply(state.colorBlend);
+  }
+  if (groups & DepthStencilGroup) {
+    apply(state.depthStencil);
+  }
+  if (groups & InputAssemblyGroup) {
+    apply(state.inputAssembly);
+  }
+  if (groups & MultisampleGroup) {
+    apply(state.multisample);
+  }
+  if (groups & RasterizationGroup) {
+    apply(state.rasterization);
+  }
+  if (groups & TessellationGroup) {
+    apply(state.tessellation);
+  }
+  // Vertex input state is applied via Vertex Array Objects
   apply(state.vertexInput);
-  apply(state.viewport);
+  if (groups & ViewportGroup) {
+    apply(state.viewport);
+  }
+}
+
+bool PipelineState::equals(const PipelineState &state,
+                           uint32_t groups) const {
+  if ((groups & ColorBlendGroup) && !(colorBlend == state.colorBlend)) {
+    return false;
+  }
+  if ((groups & DepthStencilGroup) && !(depthStencil == state.depthStencil)) {
+    return false;
+  }
+  if ((groups & InputAssemblyGroup) &&
+      !(inputAssembly == state.inputAssembly)) {
+    return false;
+  }
+  if ((groups & MultisampleGroup) && !(multisample == state.multisample)) {
+    return false;
+  }
+  if ((groups & RasterizationGroup) &&
+      !(rasterization == state.rasterization)) {
+    return false;
+  }
+  if ((groups & TessellationGroup) && !(tessellation == state.tessellation)) {
+    return false;
+  }
+  if ((groups & ViewportGroup) && !(viewport == state.viewport)) {
+    return false;
+  }
+  return true;
 }
 
 void PipelineState::apply(const ColorBlendState &state) {
@@ -18,15 +63,15 @@ void PipelineState::apply(const ColorBlendState &state) {
   if (colorBlend.logicOpEnable != state.logicOpEnable) {
     colorBlend.logicOpEnable = state.logicOpEnable;
     if (state.logicOpEnable) {
-      glEnable(GL_COLOR_LOGIC_OP);
+      PAIMON_GL_CHECK(glEnable(GL_COLOR_LOGIC_OP));
     } else {
-      glDisable(GL_COLOR_LOGIC_OP);
+      PAIMON_GL_CHECK(glDisable(GL_COLOR_LOGIC_OP));
     }
   }
 
   if (colorBlend.logicOp != state.logicOp) {
     colorBlend.logicOp = state.logicOp;
-    glLogicOp(state.logicOp);
+    PAIMON_GL_CHECK(glLogicOp(state.logicOp));
   }
 
   // Blend constants
@@ -40,8 +85,10 @@ void PipelineState::apply(const ColorBlendState &state) {
   if (constantsChanged) {
     std::copy(std::begin(state.blendConstants), std::end(state.blendConstants),
               std::begin(colorBlend.blendConstants));
-    glBlendColor(state.blendConstants[0], state.blendConstants[1],
-                 state.blendConstants[2], state.blendConstants[3]);
+    PAIMON_GL_CHECK(glBlendColor(state.blendConstants[0],
+                                 state.blendConstants[1],
+                                 state.blendConstants[2],
+                                 state.blendConstants[3]));
   }
 
   // Per-attachment blend state
@@ -53,9 +100,9 @@ void PipelineState::apply(const ColorBlendState &state) {
     if (dst.blendEnable != src.blendEnable) {
       dst.blendEnable = src.blendEnable;
       if (src.blendEnable) {
-        glEnablei(GL_BLEND, static_cast<GLuint>(i));
+        PAIMON_GL_CHECK(glEnablei(GL_BLEND, static_cast<GLuint>(i)));
       } else {
-        glDisablei(GL_BLEND, static_cast<GLuint>(i));
+        PAIMON_GL_CHECK(glDisablei(GL_BLEND, static_cast<GLuint>(i)));
       }
     }
 
@@ -68,9 +115,11 @@ void PipelineState::apply(const ColorBlendState &state) {
       dst.dstColorBlendFactor = src.dstColorBlendFactor;
       dst.srcAlphaBlendFactor = src.srcAlphaBlendFactor;
       dst.dstAlphaBlendFactor = src.dstAlphaBlendFactor;
-      glBlendFuncSeparatei(static_cast<GLuint>(i), 
-                           src.srcColorBlendFactor, src.dstColorBlendFactor,
-                           src.srcAlphaBlendFactor, src.dstAlphaBlendFactor);
+      PAIMON_GL_CHECK(glBlendFuncSeparatei(static_cast<GLuint>(i),
+                                           src.srcColorBlendFactor,
+                                           src.dstColorBlendFactor,
+                                           src.srcAlphaBlendFactor,
+                                           src.dstAlphaBlendFactor));
     }
 
     // Blend equations
@@ -78,8 +127,9 @@ void PipelineState::apply(const ColorBlendState &state) {
         dst.alphaBlendOp != src.alphaBlendOp) {
       dst.colorBlendOp = src.colorBlendOp;
       dst.alphaBlendOp = src.alphaBlendOp;
-      glBlendEquationSeparatei(static_cast<GLuint>(i),
-                               src.colorBlendOp, src.alphaBlendOp);
+      PAIMON_GL_CHECK(glBlendEquationSeparatei(static_cast<GLuint>(i),
+                                               src.colorBlendOp,
+                                               src.alphaBlendOp));
     }
 
     // Color write mask
@@ -93,9 +143,10 @@ void PipelineState::apply(const ColorBlendState &state) {
     if (maskChanged) {
       std::copy(std::begin(src.colorWriteMask), std::end(src.colorWriteMask),
                 std::begin(dst.colorWriteMask));
-      glColorMaski(static_cast<GLuint>(i), 
-                   src.colorWriteMask[0], src.colorWriteMask[1],
-                   src.colorWriteMask[2], src.colorWriteMask[3]);
+      PAIMON_GL_CHECK(glColorMaski(static_cast<GLuint>(i),
+                                   src.colorWriteMask[0], src.colorWriteMask[1],
+                                   src.colorWriteMask[2],
+                                   src.colorWriteMask[3]));
     }
   }
 }
@@ -105,52 +156,56 @@ void PipelineState::apply(const DepthStencilState &state) {
   if (depthStencil.depthTestEnable != state.depthTestEnable) {
     depthStencil.depthTestEnable = state.depthTestEnable;
     if (state.depthTestEnable) {
-      glEnable(GL_DEPTH_TEST);
+      PAIMON_GL_CHECK(glEnable(GL_DEPTH_TEST));
     } else {
-      glDisable(GL_DEPTH_TEST);
+      PAIMON_GL_CHECK(glDisable(GL_DEPTH_TEST));
     }
   }
 
   // Depth write
   if (depthStencil.depthWriteEnable != state.depthWriteEnable) {
     depthStencil.depthWriteEnable = state.depthWriteEnable;
-    glDepthMask(state.depthWriteEnable ? GL_TRUE : GL_FALSE);
+    PAIMON_GL_CHECK(glDepthMask(state.depthWriteEnable ? GL_TRUE : GL_FALSE));
   }
 
   // Depth compare operation
   if (depthStencil.depthCompareOp != state.depthCompareOp) {
     depthStencil.depthCompareOp = state.depthCompareOp;
-    glDepthFunc(state.depthCompareOp);
+    PAIMON_GL_CHECK(glDepthFunc(state.depthCompareOp));
   }
 
   // Stencil test
   if (depthStencil.stencilTestEnable != state.stencilTestEnable) {
     depthStencil.stencilTestEnable = state.stencilTestEnable;
     if (state.stencilTestEnable) {
-      glEnable(GL_STENCIL_TEST);
+      PAIMON_GL_CHECK(glEnable(GL_STENCIL_TEST));
     } else {
-      glDisable(GL_STENCIL_TEST);
+      PAIMON_GL_CHECK(glDisable(GL_STENCIL_TEST));
     }
   }
 
   // Front face stencil
   if (depthStencil.front != state.front) {
     depthStencil.front = state.front;
-    glStencilFuncSeparate(GL_FRONT, state.front.compareOp, 
-                         state.front.reference, state.front.compareMask);
-    glStencilOpSeparate(GL_FRONT, state.front.failOp, 
-                       state.front.depthFailOp, state.front.passOp);
-    glStencilMaskSeparate(GL_FRONT, state.front.writeMask);
+    PAIMON_GL_CHECK(glStencilFuncSeparate(GL_FRONT, state.front.compareOp,
+                                          state.front.reference,
+                                          state.front.compareMask));
+    PAIMON_GL_CHECK(glStencilOpSeparate(GL_FRONT, state.front.failOp,
+                                        state.front.depthFailOp,
+                                        state.front.passOp));
+    PAIMON_GL_CHECK(glStencilMaskSeparate(GL_FRONT, state.front.writeMask));
   }
 
   // Back face stencil
   if (depthStencil.back != state.back) {
     depthStencil.back = state.back;
-    glStencilFuncSeparate(GL_BACK, state.back.compareOp,
-                         state.back.reference, state.back.compareMask);
-    glStencilOpSeparate(GL_BACK, state.back.failOp,
-                       state.back.depthFailOp, state.back.passOp);
-    glStencilMaskSeparate(GL_BACK, state.back.writeMask);
+    PAIMON_GL_CHECK(glStencilFuncSeparate(GL_BACK, state.back.compareOp,
+                                          state.back.reference,
+                                          state.back.compareMask));
+    PAIMON_GL_CHECK(glStencilOpSeparate(GL_BACK, state.back.failOp,
+                                        state.back.depthFailOp,
+                                        state.back.passOp));
+    PAIMON_GL_CHECK(glStencilMaskSeparate(GL_BACK, state.back.writeMask));
   }
 }
 
@@ -164,9 +219,9 @@ void PipelineState::apply(const InputAssemblyState &state) {
   if (inputAssembly.primitiveRestartEnable != state.primitiveRestartEnable) {
     inputAssembly.primitiveRestartEnable = state.primitiveRestartEnable;
     if (state.primitiveRestartEnable) {
-      glEnable(GL_PRIMITIVE_RESTART);
+      PAIMON_GL_CHECK(glEnable(GL_PRIMITIVE_RESTART));
     } else {
-      glDisable(GL_PRIMITIVE_RESTART);
+      PAIMON_GL_CHECK(glDisable(GL_PRIMITIVE_RESTART));
     }
   }
 }
@@ -176,22 +231,23 @@ void PipelineState::apply(const MultisampleState &state) {
   if (multisample.sampleShadingEnable != state.sampleShadingEnable) {
     multisample.sampleShadingEnable = state.sampleShadingEnable;
     if (state.sampleShadingEnable) {
-      glEnable(GL_SAMPLE_SHADING);
+      PAIMON_GL_CHECK(glEnable(GL_SAMPLE_SHADING));
     } else {
-      glDisable(GL_SAMPLE_SHADING);
+      PAIMON_GL_CHECK(glDisable(GL_SAMPLE_SHADING));
     }
   }
 
   if (multisample.minSampleShading != state.minSampleShading) {
     multisample.minSampleShading = state.minSampleShading;
-    glMinSampleShading(state.minSampleShading);
+    PAIMON_GL_CHECK(glMinSampleShading(state.minSampleShading));
   }
 
   // Sample mask
   for (size_t i = 0; i < state.sampleMask.size(); ++i) {
     if (multisample.sampleMask[i] != state.sampleMask[i]) {
       multisample.sampleMask[i] = state.sampleMask[i];
-      glSampleMaski(static_cast<GLuint>(i), state.sampleMask[i]);
+      PAIMON_GL_CHECK(glSampleMaski(static_cast<GLuint>(i),
+                                    state.sampleMask[i]));
     }
   }
 
@@ -199,9 +255,9 @@ void PipelineState::apply(const MultisampleState &state) {
   if (multisample.alphaToCoverageEnable != state.alphaToCoverageEnable) {
     multisample.alphaToCoverageEnable = state.alphaToCoverageEnable;
     if (state.alphaToCoverageEnable) {
-      glEnable(GL_SAMPLE_ALPHA_TO_COVERAGE);
+      PAIMON_GL_CHECK(glEnable(GL_SAMPLE_ALPHA_TO_COVERAGE));
     } else {
-      glDisable(GL_SAMPLE_ALPHA_TO_COVERAGE);
+      PAIMON_GL_CHECK(glDisable(GL_SAMPLE_ALPHA_TO_COVERAGE));
     }
   }
 
@@ -209,9 +265,9 @@ void PipelineState::apply(const MultisampleState &state) {
   if (multisample.alphaToOneEnable != state.alphaToOneEnable) {
     multisample.alphaToOneEnable = state.alphaToOneEnable;
     if (state.alphaToOneEnable) {
-      glEnable(GL_SAMPLE_ALPHA_TO_ONE);
+      PAIMON_GL_CHECK(glEnable(GL_SAMPLE_ALPHA_TO_ONE));
     } else {
-      glDisable(GL_SAMPLE_ALPHA_TO_ONE);
+      PAIMON_GL_CHECK(glDisable(GL_SAMPLE_ALPHA_TO_ONE));
     }
   }
 }
@@ -221,9 +277,9 @@ void PipelineState::apply(const RasterizationState &state) {
   if (rasterization.depthClampEnable != state.depthClampEnable) {
     rasterization.depthClampEnable = state.depthClampEnable;
     if (state.depthClampEnable) {
-      glEnable(GL_DEPTH_CLAMP);
+      PAIMON_GL_CHECK(glEnable(GL_DEPTH_CLAMP));
     } else {
-      glDisable(GL_DEPTH_CLAMP);
+      PAIMON_GL_CHECK(glDisable(GL_DEPTH_CLAMP));
     }
   }
 
@@ -231,46 +287,46 @@ void PipelineState::apply(const RasterizationState &state) {
   if (rasterization.rasterizerDiscardEnable != state.rasterizerDiscardEnable) {
     rasterization.rasterizerDiscardEnable = state.rasterizerDiscardEnable;
     if (state.rasterizerDiscardEnable) {
-      glEnable(GL_RASTERIZER_DISCARD);
+      PAIMON_GL_CHECK(glEnable(GL_RASTERIZER_DISCARD));
     } else {
-      glDisable(GL_RASTERIZER_DISCARD);
+      PAIMON_GL_CHECK(glDisable(GL_RASTERIZER_DISCARD));
     }
   }
 
   // Polygon mode
   if (rasterization.polygonMode != state.polygonMode) {
     rasterization.polygonMode = state.polygonMode;
-    glPolygonMode(GL_FRONT_AND_BACK, state.polygonMode);
+    PAIMON_GL_CHECK(glPolygonMode(GL_FRONT_AND_BACK, state.polygonMode));
   }
 
   // Cull mode
   if (rasterization.cullMode != state.cullMode) {
     rasterization.cullMode = state.cullMode;
     if (state.cullMode == GL_NONE) {
-      glDisable(GL_CULL_FACE);
+      PAIMON_GL_CHECK(glDisable(GL_CULL_FACE));
     } else {
-      glEnable(GL_CULL_FACE);
-      glCullFace(state.cullMode);
+      PAIMON_GL_CHECK(glEnable(GL_CULL_FACE));
+      PAIMON_GL_CHECK(glCullFace(state.cullMode));
     }
   }
 
   // Front face
   if (rasterization.frontFace != state.frontFace) {
     rasterization.frontFace = state.frontFace;
-    glFrontFace(state.frontFace);
+    PAIMON_GL_CHECK(glFrontFace(state.frontFace));
   }
 
   // Depth bias
   if (rasterization.depthBiasEnable != state.depthBiasEnable) {
     rasterization.depthBiasEnable = state.depthBiasEnable;
     if (state.depthBiasEnable) {
-      glEnable(GL_POLYGON_OFFSET_FILL);
-      glEnable(GL_POLYGON_OFFSET_LINE);
-      glEnable(GL_POLYGON_OFFSET_POINT);
+      PAIMON_GL_CHECK(glEnable(GL_POLYGON_OFFSET_FILL));
+      PAIMON_GL_CHECK(glEnable(GL_POLYGON_OFFSET_LINE));
+      PAIMON_GL_CHECK(glEnable(GL_POLYGON_OFFSET_POINT));
     } else {
-      glDisable(GL_POLYGON_OFFSET_FILL);
-      glDisable(GL_POLYGON_OFFSET_LINE);
-      glDisable(GL_POLYGON_OFFSET_POINT);
+      PAIMON_GL_CHECK(glDisable(GL_POLYGON_OFFSET_FILL));
+      PAIMON_GL_CHECK(glDisable(GL_POLYGON_OFFSET_LINE));
+      PAIMON_GL_CHECK(glDisable(GL_POLYGON_OFFSET_POINT));
     }
   }
 
@@ -278,28 +334,29 @@ void PipelineState::apply(const RasterizationState &state) {
       rasterization.depthBiasSlopeFactor != state.depthBiasSlopeFactor) {
     rasterization.depthBiasConstantFactor = state.depthBiasConstantFactor;
     rasterization.depthBiasSlopeFactor = state.depthBiasSlopeFactor;
-    glPolygonOffset(state.depthBiasSlopeFactor, state.depthBiasConstantFactor);
+    PAIMON_GL_CHECK(glPolygonOffset(state.depthBiasSlopeFactor,
+                                    state.depthBiasConstantFactor));
   }
 
   // Line width
   if (rasterization.lineWidth != state.lineWidth) {
     rasterization.lineWidth = state.lineWidth;
-    glLineWidth(state.lineWidth);
+    PAIMON_GL_CHECK(glLineWidth(state.lineWidth));
   }
 
   // Point size
   if (rasterization.pointSize != state.pointSize) {
     rasterization.pointSize = state.pointSize;
-    glPointSize(state.pointSize);
+    PAIMON_GL_CHECK(glPointSize(state.pointSize));
   }
 
   // Program point size
   if (rasterization.programPointSize != state.programPointSize) {
     rasterization.programPointSize = state.programPointSize;
     if (state.programPointSize) {
-      glEnable(GL_PROGRAM_POINT_SIZE);
+      PAIMON_GL_CHECK(glEnable(GL_PROGRAM_POINT_SIZE));
     } else {
-      glDisable(GL_PROGRAM_POINT_SIZE);
+      PAIMON_GL_CHECK(glDisable(GL_PROGRAM_POINT_SIZE));
     }
   }
 }
@@ -307,7 +364,8 @@ void PipelineState::apply(const RasterizationState &state) {
 void PipelineState::apply(const TessellationState &state) {
   if (tessellation.patchControlPoints != state.patchControlPoints) {
     tessellation.patchControlPoints = state.patchControlPoints;
-    glPatchParameteri(GL_PATCH_VERTICES, state.patchControlPoints);
+    PAIMON_GL_CHECK(glPatchParameteri(GL_PATCH_VERTICES,
+                                      state.patchControlPoints));
   }
 }
 
@@ -324,9 +382,10 @@ void PipelineState::apply(const ViewportState &state) {
 
     if (dst != src) {
       dst = src;
-      glViewportIndexedf(static_cast<GLuint>(i), src.x, src.y,
-                         src.width, src.height);
-      glDepthRangeIndexed(static_cast<GLuint>(i), src.minDepth, src.maxDepth);
+      PAIMON_GL_CHECK(glViewportIndexedf(static_cast<GLuint>(i), src.x, src.y,
+                                         src.width, src.height));
+      PAIMON_GL_CHECK(glDepthRangeIndexed(static_cast<GLuint>(i), src.minDepth,
+                                          src.maxDepth));
     }
   }
 
@@ -337,8 +396,8 @@ void PipelineState::apply(const ViewportState &state) {
 
     if (dst != src) {
       dst = src;
-      glScissorIndexed(static_cast<GLuint>(i), src.x, src.y,
-                       src.width, src.height);
+      PAIMON_GL_CHECK(glScissorIndexed(static_cast<GLuint>(i), src.x, src.y,
+                                       src.width, src.height));
     }
   }
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 #include "paimon/opengl/state/color_blend.h"
 #include "paimon/opengl/state/depth_stencil.h"
 #include "paimon/opengl/state/input_assembly.h"
@@ -12,6 +14,19 @@
 namespace paimon {
 
 struct PipelineState {
+  // State groups, used to apply only the groups that changed between pipelines
+  enum Group : uint32_t {
+    ColorBlendGroup = 1u << 0,
+    DepthStencilGroup = 1u << 1,
+    InputAssemblyGroup = 1u << 2,
+    MultisampleGroup = 1u << 3,
+    RasterizationGroup = 1u << 4,
+    TessellationGroup = 1u << 5,
+    ViewportGroup = 1u << 6,
+    AllGroups = (1u << 7) - 1,
+  };
+  static constexpr size_t GroupCount = 7;
+
   ColorBlendState colorBlend;
   DepthStencilState depthStencil;
   InputAssemblyState inputAssembly;
@@ -21,7 +36,11 @@ struct PipelineState {
   VertexInputState vertexInput;
   ViewportState viewport;
 
-  void apply(const PipelineState &state);
+  void apply(const PipelineState &state, uint32_t groups = AllGroups);
+
+  // Field by field comparison of the given groups, vertex input is not part
+  // of any group
+  bool equals(const PipelineState &state, uint32_t groups = AllGroups) const;
 
 private:
   void apply(const ColorBlendState &state);
@@ -29,19 +29,10 @@ struct VertexInputState {
     bool operator==(const Attribute &other) const = default;
   };
 
+  // Only the bindings and attributes in use, not sized to the GL limits
   std::vector<Binding> bindings;
   std::vector<Attribute> attributes;
 
-  VertexInputState() {
-    int maxBindings = 0;
-    glGetIntegerv(GL_MAX_VERTEX_ATTRIB_BINDINGS, &maxBindings);
-    bindings.resize(static_cast<size_t>(maxBindings));
-
-    int maxAttributes = 0;
-    glGetIntegerv(GL_MAX_VERTEX_ATTRIBS, &maxAttributes);
-    attributes.resize(static_cast<size_t>(maxAttributes));
-  }
-  
   bool operator==(const VertexInputState &other) const = default;
 };
 } // namespace paimon
@@ -1,93 +1,142 @@
 #include "paimon/opengl/texture.h"
+
+#include <unordered_map>
+#include <vector>
+
 #include <glad/gl.h>
 #include "texture.h"
 
+#include "paimon/opengl/error.h"
+
 using namespace paimon;
 
-Texture::Texture(GLenum target) : NamedObject(GL_TEXTURE), m_target(target) {
-  glCreateTextures(target, 1, &m_name);
+namespace {
+uint64_t s_nextGeneration = 1;
+
+size_t s_nextCallbackId = 0;
+std::unordered_map<size_t, Texture::DestroyCallback> s_destroyCallbacks;
+} // namespace
+
+Texture::Texture(GLenum target)
+    : NamedObject(GL_TEXTURE), m_target(target),
+      m_generation(s_nextGeneration++) {
+  PAIMON_GL_CHECK(glCreateTextures(target, 1, &m_name));
 }
 
 Texture::~Texture() {
   if (m_name != 0) {
-    glDeleteTextures(1, &m_name);
+    // Callbacks may change the registry, iterate over a snapshot of the ids
+    // and skip the ones removed meanwhile
+    std::vector<size_t> ids;
+    ids.reserve(s_destroyCallbacks.size());
+    for (const auto &[id, callback] : s_destroyCallbacks) {
+      ids.push_back(id);
+    }
+    for (auto id : ids) {
+      auto it = s_destroyCallbacks.find(id);
+      if (it == s_destroyCallbacks.end()) {
+        continue;
+      }
+      // Copied, the callback may remove itself
+      auto callback = it->second;
+      callback(*this);
+    }
+    PAIMON_GL_CHECK(glDeleteTextures(1, &m_name));
   }
 }
 
+size_t Texture::add_destroy_callback(DestroyCallback callback) {
+  auto id = s_nextCallbackId++;
+  s_destroyCallbacks.emplace(id, std::move(callback));
+  return id;
+}
+
+void Texture::remove_destroy_callback(size_t id) {
+  s_destroyCallbacks.erase(id);
+}
+
 bool Texture::is_valid() const { return glIsTexture(m_name) == GL_TRUE; }
 
 void Texture::bind(GLuint unit) const { glBindTextureUnit(unit, m_name); }
 
 void Texture::bind(GLuint unit, GLenum access, GLenum format, GLuint level,
                    GLboolean layered, GLuint layer) const {
-  glBindImageTexture(unit, m_name, level, layered, layer, access, format);
+  PAIMON_GL_CHECK(glBindImageTexture(unit, m_name, level, layered, layer,
+                                     access, format));
 }
 
 void Texture::set_buffer_data(GLenum internalformat, GLuint buffer) {
-  glTextureBuffer(m_name, internalformat, buffer);
+  PAIMON_GL_CHECK(glTextureBuffer(m_name, internalformat, buffer));
 }
 
 void Texture::set_buffer_range(GLenum internalformat, GLuint buffer,
                                GLintptr offset, GLsizeiptr size) {
-  glTextureBufferRange(m_name, internalformat, buffer, offset, size);
+  PAIMON_GL_CHECK(glTextureBufferRange(m_name, internalformat, buffer, offset,
+                                       size));
 }
 
 void Texture::set_storage_1d(GLsizei levels, GLenum internalformat,
                              GLsizei width) {
-  glTextureStorage1D(m_name, levels, internalformat, width);
+  PAIMON_GL_CHECK(glTextureStorage1D(m_name, levels, internalformat, width));
 }
 
 void Texture::set_storage_2d(GLsizei levels, GLenum internalformat,
                              GLsizei width, GLsizei height) {
-  glTextureStorage2D(m_name, levels, internalformat, width, height);
+  PAIMON_GL_CHECK(glTextureStorage2D(m_name, levels, internalformat, width,
+                                     height));
 }
 
 void Texture::set_storage_3d(GLsizei levels, GLenum internalformat,
                              GLsizei width, GLsizei height, GLsizei depth) {
-  glTextureStorage3D(m_name, levels, internalformat, width, height, depth);
+  PAIMON_GL_CHECK(glTextureStorage3D(m_name, levels, internalformat, width,
+                                     height, depth));
 }
 
 void Texture::set_storage_2d_multisample(GLsizei samples, GLenum internalformat,
                                          GLsizei width, GLsizei height,
                                          GLboolean fixedsamplelocations) {
-  glTextureStorage2DMultisample(m_name, samples, internalformat, width, height,
-                                fixedsamplelocations);
+  PAIMON_GL_CHECK(glTextureStorage2DMultisample(m_name, samples, internalformat,
+                                                width, height,
+                                                fixedsamplelocations));
 }
 
 void Texture::set_storage_3d_multisample(GLsizei samples, GLenum internalformat,
                                          GLsizei width, GLsizei height,
                                          GLsizei depth,
                                          GLboolean fixedsamplelocations) {
-  glTextureStorage3DMultisample(m_name, samples, internalformat, width, height,
-                                depth, fixedsamplelocations);
+  PAIMON_GL_CHECK(glTextureStorage3DMultisample(m_name, samples, internalformat,
+                                                width, height, depth,
+                                                fixedsamplelocations));
 }
 
 void Texture::set_sub_image_1d(GLint level, GLint xoffset, GLsizei width,
                                GLenum format, GLenum type, const void *pixels) {
-  glTextureSubImage1D(m_name, level, xoffset, width, format, type, pixels);
+  PAIMON_GL_CHECK(glTextureSubImage1D(m_name, level, xoffset, width, format,
+                                      type, pixels));
 }
 
 void Texture::set_sub_image_2d(GLint level, GLint xoffset, GLint yoffset,
                                GLsizei width, GLsizei height, GLenum format,
                                GLenum type, const void *pixels) {
-  glTextureSubImage2D(m_name, level, xoffset, yoffset, width, height, format,
-                      type, pixels);
+  PAIMON_GL_CHECK(glTextureSubImage2D(m_name, level, xoffset, yoffset, width,
+                                      height, format, type, pixels));
 }
 
 void Texture::set_sub_image_3d(GLint level, GLint xoffset, GLint yoffset,
                                GLint zoffset, GLsizei width, GLsizei height,
                                GLsizei depth, GLenum format, GLenum type,
                                const void *pixels) {
-  glTextureSubImage3D(m_name, level, xoffset, yoffset, zoffset, width, height,
-                      depth, format, type, pixels);
+  PAIMON_GL_CHECK(glTextureSubImage3D(m_name, level, xoffset, yoffset, zoffset,
+                                      width, height, depth, format, type,
+                                      pixels));
 }
 
 void Texture::set_compressed_sub_image_1d(GLint level, GLint xoffset,
                                           GLsizei width, GLenum format,
                                           GLsizei image_size,
                                           const void *data) {
-  glCompressedTextureSubImage1D(m_name, level, xoffset, width, format,
-                                image_size, data);
+  PAIMON_GL_CHECK(glCompressedTextureSubImage1D(m_name, level, xoffset, width,
+                                                format, image_size, data));
 }
 
 void Texture::set_compressed_sub_image_2d(GLint level, GLint xoffset,
@@ -95,8 +144,9 @@ void Texture::set_compressed_sub_image_2d(GLint level, GLint xoffset,
                                           GLsizei height, GLenum format,
                                           GLsizei image_size,
                                           const void *data) {
-  glCompressedTextureSubImage2D(m_name, level, xoffset, yoffset, width, height,
-                                format, image_size, data);
+  PAIMON_GL_CHECK(glCompressedTextureSubImage2D(m_name, level, xoffset, yoffset,
+                                                width, height, format,
+                                                image_size, data));
 }
 
 void Texture::set_compressed_sub_image_3d(GLint level, GLint xoffset,
@@ -105,50 +155,53 @@ void Texture::set_compressed_sub_image_3d(GLint level, GLint xoffset,
                                           GLsizei depth, GLenum format,
                                           GLsizei image_size,
                                           const void *data) {
-  glCompressedTextureSubImage3D(m_name, level, xoffset, yoffset, zoffset, width,
-                                height, depth, format, image_size, data);
+  PAIMON_GL_CHECK(glCompressedTextureSubImage3D(m_name, level, xoffset, yoffset,
+                                                zoffset, width, height, depth,
+                                                format, image_size, data));
 }
 
 void Texture::copy_sub_image_1d(GLint level, GLint xoffset, GLint x, GLint y,
                                 GLsizei width) {
-  glCopyTextureSubImage1D(m_name, level, xoffset, x, y, width);
+  PAIMON_GL_CHECK(glCopyTextureSubImage1D(m_name, level, xoffset, x, y, width));
 }
 
 void Texture::copy_sub_image_2d(GLint level, GLint xoffset, GLint yoffset,
                                 GLint x, GLint y, GLsizei width,
                                 GLsizei height) {
-  glCopyTextureSubImage2D(m_name, level, xoffset, yoffset, x, y, width, height);
+  PAIMON_GL_CHECK(glCopyTextureSubImage2D(m_name, level, xoffset, yoffset, x, y,
+                                          width, height));
 }
 
 void Texture::copy_sub_image_3d(GLint level, GLint xoffset, GLint yoffset,
                                 GLint zoffset, GLint x, GLint y, GLsizei width,
                                 GLsizei height) {
-  glCopyTextureSubImage3D(m_name, level, xoffset, yoffset, zoffset, x, y, width,
-                          height);
+  PAIMON_GL_CHECK(glCopyTextureSubImage3D(m_name, level, xoffset, yoffset,
+                                          zoffset, x, y, width, height));
 }
 
 void Texture::generate_mipmap() { glGenerateTextureMipmap(m_name); }
 
 void Texture::get_image(GLint level, GLenum format, GLenum type,
                         GLsizei buf_size, void *pixels) {
-  glGetTextureImage(m_name, level, format, type, buf_size, pixels);
+  PAIMON_GL_CHECK(glGetTextureImage(m_name, level, format, type, buf_size,
+                                    pixels));
 }
 
 void Texture::get_compressed_image(GLint level, GLsizei buf_size,
                                    void *pixels) {
-  glGetCompressedTextureImage(m_name, level, buf_size, pixels);
+  PAIMON_GL_CHECK(glGetCompressedTextureImage(m_name, level, buf_size, pixels));
 }
 
 GLenum Texture::get_target() const { return m_target; }
 
 template <>
 void Texture::get(GLenum property, GLint *value) {
-  glGetTextureParameteriv(m_name, property, value);
+  PAIMON_GL_CHECK(glGetTextureParameteriv(m_name, property, value));
 }
 
 template <>
 void Texture::get(GLenum property, GLfloat *value) {
-  glGetTextureParameterfv(m_name, property, value);
+  PAIMON_GL_CHECK(glGetTextureParameterfv(m_name, property, value));
 }
 
 template <>
@@ -167,12 +220,12 @@ GLfloat Texture::get(GLenum property) {
 
 template <>
 void Texture::get(GLint level, GLenum property, GLint *value) {
-  glGetTextureLevelParameteriv(m_name, level, property, value);
+  PAIMON_GL_CHECK(glGetTextureLevelParameteriv(m_name, level, property, value));
 }
 
 template <>
 void Texture::get(GLint level, GLenum property, GLfloat *value) {
-  glGetTextureLevelParameterfv(m_name, level, property, value);
+  PAIMON_GL_CHECK(glGetTextureLevelParameterfv(m_name, level, property, value));
 }
 
 template <>
@@ -191,35 +244,36 @@ GLfloat Texture::get(GLint level, GLenum property) {
 
 template <>
 void Texture::set<GLint>(GLenum property, GLint value) {
-  glTextureParameteri(m_name, property, value);
+  PAIMON_GL_CHECK(glTextureParameteri(m_name, property, value));
 }
 
 template <>
 void Texture::set<GLenum>(GLenum property, GLenum value) {
-  glTextureParameteri(m_name, property, static_cast<GLint>(value));
+  PAIMON_GL_CHECK(glTextureParameteri(m_name, property,
+                                      static_cast<GLint>(value)));
 }
 
 template <>
 void Texture::set<GLfloat>(GLenum property, GLfloat value) {
-  glTextureParameterf(m_name, property, value);
+  PAIMON_GL_CHECK(glTextureParameterf(m_name, property, value));
 }
 
 template <>
 void Texture::set<GLint *>(GLenum property, GLint *value) {
-  glTextureParameteriv(m_name, property, value);
+  PAIMON_GL_CHECK(glTextureParameteriv(m_name, property, value));
 }
 
 template <>
 void Texture::set<GLfloat *>(GLenum property, GLfloat *value) {
-  glTextureParameterfv(m_name, property, value);
+  PAIMON_GL_CHECK(glTextureParameterfv(m_name, property, value));
 }
 
 template <>
 void Texture::set<const GLint *>(GLenum property, const GLint *value) {
-  glTextureParameteriv(m_name, property, value);
+  PAIMON_GL_CHECK(glTextureParameteriv(m_name, property, value));
 }
 
 template <>
 void Texture::set<const GLfloat *>(GLenum property, const GLfloat *value) {
-  glTextureParameterfv(m_name, property, value);
+  PAIMON_GL_CHECK(glTextureParameterfv(m_name, property, value));
 }
@@ -1,10 +1,15 @@
 #pragma once
 
+#include <cstdint>
+#include <functional>
+
 #include "paimon/opengl/base/object.h"
 
 namespace paimon {
 class Texture : public NamedObject {
 public:
+  using DestroyCallback = std::function<void(const Texture &)>;
+
   Texture(GLenum target);
   ~Texture();
 
@@ -85,6 +90,15 @@ public:
 
   GLenum get_target() const;
 
+  // Unique for the lifetime of the program, unlike GL names which are recycled
+  uint64_t get_generation() const { return m_generation; }
+
+  // Called when any texture is destroyed, returns an id for removal. GL
+  // thread only, the registry is not synchronized. A callback may add or
+  // remove callbacks and destroy other textures.
+  static size_t add_destroy_callback(DestroyCallback callback);
+  static void remove_destroy_callback(size_t id);
+
   template <class T>
   void get(GLenum property, T *value);
 
@@ -102,5 +116,6 @@ public:
 
 private:
   const GLenum m_target;
+  uint64_t m_generation;
 };
 } // namespace paimon
@@ -2,15 +2,17 @@
 
 #include <glad/gl.h>
 
+#include "paimon/opengl/error.h"
+
 using namespace paimon;
 
 VertexArray::VertexArray() : NamedObject(GL_VERTEX_ARRAY) {
-  glCreateVertexArrays(1, &m_name);
+  PAIMON_GL_CHECK(glCreateVertexArrays(1, &m_name));
 }
 
 VertexArray::~VertexArray() {
   if (m_name != 0) {
-    glDeleteVertexArrays(1, &m_name);
+    PAIMON_GL_CHECK(glDeleteVertexArrays(1, &m_name));
   }
 }
 
@@ -19,35 +21,36 @@ bool VertexArray::is_valid() const {
 }
 
 void VertexArray::enable_attribute(GLuint index) const {
-  glEnableVertexArrayAttrib(m_name, index);
+  PAIMON_GL_CHECK(glEnableVertexArrayAttrib(m_name, index));
 }
 
 void VertexArray::disable_attribute(GLuint index) const {
-  glDisableVertexArrayAttrib(m_name, index);
+  PAIMON_GL_CHECK(glDisableVertexArrayAttrib(m_name, index));
 }
 
 void VertexArray::set_attribute_format(GLuint attribute, GLint size,
                                         GLenum type, GLboolean normalized,
                                         GLuint relative_offset) const {
-  glVertexArrayAttribFormat(m_name, attribute, size, type, normalized,
-                            relative_offset);
+  PAIMON_GL_CHECK(glVertexArrayAttribFormat(m_name, attribute, size, type,
+                                            normalized, relative_offset));
 }
 
 void VertexArray::set_binding_divisor(GLuint binding, GLuint divisor) const {
-  glVertexArrayBindingDivisor(m_name, binding, divisor);
+  PAIMON_GL_CHECK(glVertexArrayBindingDivisor(m_name, binding, divisor));
 }
 
 void VertexArray::set_vertex_buffer(uint32_t binding, const Buffer &buffer,
                                     GLintptr offset, GLsizei stride) const {
-  glVertexArrayVertexBuffer(m_name, binding, buffer.get_name(), offset, stride);
+  PAIMON_GL_CHECK(glVertexArrayVertexBuffer(m_name, binding, buffer.get_name(),
+                                            offset, stride));
 }
 
 void VertexArray::set_element_buffer(const Buffer &buffer) const {
-  glVertexArrayElementBuffer(m_name, buffer.get_name());
+  PAIMON_GL_CHECK(glVertexArrayElementBuffer(m_name, buffer.get_name()));
 }
 
 void VertexArray::set_attribute_binding(GLuint attribute, GLuint binding) const {
-  glVertexArrayAttribBinding(m_name, attribute, binding);
+  PAIMON_GL_CHECK(glVertexArrayAttribBinding(m_name, attribute, binding));
 }
 
 void VertexArray::bind() const { glBindVertexArray(m_name); }
@@ -0,0 +1,502 @@
+#include "paimon/rendering/buffer_allocator.h"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+
+#include "paimon/core/log_system.h"
+
+namespace paimon {
+
+TlsfAllocator::TlsfAllocator(uint32_t capacity) : m_capacity(capacity) {
+  m_freeHeads.fill(InvalidNode);
+  if (capacity > 0) {
+    auto node = createNode();
+    m_nodes[node].size = capacity;
+    insertFree(node);
+  }
+}
+
+std::optional<uint32_t> TlsfAllocator::allocate(uint32_t size) {
+  if (size == 0 || size > m_capacity - m_used) {
+    return std::nullopt;
+  }
+
+  // Round the request up to the next list boundary so that any range in the
+  // found list is large enough
+  uint32_t search = size;
+  if (size >= SecondLevelCount) {
+    uint32_t msb = std::bit_width(size) - 1;
+    uint64_t rounded =
+        uint64_t(size) + (uint64_t(1) << (msb - SecondLevelBits)) - 1;
+    search = static_cast<uint32_t>(
+        std::min<uint64_t>(rounded, std::numeric_limits<uint32_t>::max()));
+  }
+
+  uint32_t firstLevel = 0;
+  uint32_t secondLevel = 0;
+  mapping(search, firstLevel, secondLevel);
+
+  uint32_t node = InvalidNode;
+  uint32_t secondLevelMap =
+      m_secondLevelBitmaps[firstLevel] & (~0u << secondLevel);
+  if (secondLevelMap == 0) {
+    uint32_t firstLevelMap =
+        firstLevel + 1 < FirstLevelCount
+            ? m_firstLevelBitmap & (~0u << (firstLevel + 1))
+            : 0;
+    if (firstLevelMap != 0) {
+      firstLevel = std::countr_zero(firstLevelMap);
+      secondLevelMap = m_secondLevelBitmaps[firstLevel];
+    }
+  }
+  if (secondLevelMap != 0) {
+    secondLevel = std::countr_zero(secondLevelMap);
+    node = m_freeHeads[firstLevel * SecondLevelCount + secondLevel];
+  }
+
+  // The list holding exactly this size may still have a range that fits,
+  // e.g. the single range of a block sized for one allocation
+  if (node == InvalidNode) {
+    mapping(size, firstLevel, secondLevel);
+    for (auto candidate = m_freeHeads[firstLevel * SecondLevelCount +
+                                      secondLevel];
+         candidate != InvalidNode; candidate = m_nodes[candidate].nextFree) {
+      if (m_nodes[candidate].size >= size) {
+        node = candidate;
+        break;
+      }
+    }
+  }
+
+  if (node == InvalidNode) {
+    return std::nullopt;
+  }
+
+  removeFree(node);
+
+  // Split off the remainder, createNode may grow m_nodes so index it again
+  if (m_nodes[node].size > size) {
+    auto rest = createNode();
+    m_nodes[rest].offset = m_nodes[node].offset + size;
+    m_nodes[rest].size = m_nodes[node].size - size;
+    m_nodes[rest].prevPhysical = node;
+    m_nodes[rest].nextPhysical = m_nodes[node].nextPhysical;
+    if (m_nodes[rest].nextPhysical != InvalidNode) {
+      m_nodes[m_nodes[rest].nextPhysical].prevPhysical = rest;
+    }
+    m_nodes[node].nextPhysical = rest;
+    m_nodes[node].size = size;
+    insertFree(rest);
+  }
+
+  m_nodes[node].used = true;
+  m_used += size;
+  return node;
+}
+
+void TlsfAllocator::release(uint32_t node) {
+  if (node >= m_nodes.size() || !m_nodes[node].used) {
+    LOG_ERROR("TlsfAllocator: invalid release of node {}", node);
+    return;
+  }
+
+  m_nodes[node].used = false;
+  m_used -= m_nodes[node].size;
+
+  // Merge with the following range
+  auto next = m_nodes[node].nextPhysical;
+  if (next != InvalidNode && !m_nodes[next].used) {
+    removeFree(next);
+    m_nodes[node].size += m_nodes[next].size;
+    m_nodes[node].nextPhysical = m_nodes[next].nextPhysical;
+    if (m_nodes[node].nextPhysical != InvalidNode) {
+      m_nodes[m_nodes[node].nextPhysical].prevPhysical = node;
+    }
+    destroyNode(next);
+  }
+
+  // Merge with the preceding range
+  auto prev = m_nodes[node].prevPhysical;
+  if (prev != InvalidNode && !m_nodes[prev].used) {
+    removeFree(prev);
+    m_nodes[prev].size += m_nodes[node].size;
+    m_nodes[prev].nextPhysical = m_nodes[node].nextPhysical;
+    if (m_nodes[prev].nextPhysical != InvalidNode) {
+      m_nodes[m_nodes[prev].nextPhysical].prevPhysical = prev;
+    }
+    destroyNode(node);
+    node = prev;
+  }
+
+  insertFree(node);
+}
+
+uint32_t TlsfAllocator::getLargestFreeRange() const {
+  if (m_firstLevelBitmap == 0) {
+    return 0;
+  }
+
+  // The largest range lives in the highest non-empty list
+  uint32_t firstLevel = 31 - std::countl_zero(m_firstLevelBitmap);
+  uint32_t secondLevel =
+      31 - std::countl_zero(m_secondLevelBitmaps[firstLevel]);
+
+  uint32_t largest = 0;
+  for (auto node = m_freeHeads[firstLevel * SecondLevelCount + secondLevel];
+       node != InvalidNode; node = m_nodes[node].nextFree) {
+    largest = std::max(largest, m_nodes[node].size);
+  }
+  return largest;
+}
+
+void TlsfAllocator::mapping(uint32_t size, uint32_t &firstLevel,
+                            uint32_t &secondLevel) {
+  // Small sizes get one list each, larger ones are split linearly into
+  // SecondLevelCount lists per power of two
+  if (size < SecondLevelCount) {
+    firstLevel = 0;
+    secondLevel = size;
+    return;
+  }
+
+  uint32_t msb = std::bit_width(size) - 1;
+  firstLevel = msb - SecondLevelBits + 1;
+  secondLevel = (size >> (msb - SecondLevelBits)) ^ SecondLevelCount;
+}
+
+uint32_t TlsfAllocator::createNode() {
+  if (!m_recycledNodes.empty()) {
+    auto node = m_recycledNodes.back();
+    m_recycledNodes.pop_back();
+    m_nodes[node] = Node{};
+    return node;
+  }
+
+  m_nodes.emplace_back();
+  return static_cast<uint32_t>(m_nodes.size() - 1);
+}
+
+void TlsfAllocator::destroyNode(uint32_t node) {
+  m_recycledNodes.push_back(node);
+}
+
+void TlsfAllocator::insertFree(uint32_t node) {
+  uint32_t firstLevel = 0;
+  uint32_t secondLevel = 0;
+  mapping(m_nodes[node].size, firstLevel, secondLevel);
+
+  auto &head = m_freeHeads[firstLevel * SecondLevelCount + secondLevel];
+  m_nodes[node].prevFree = InvalidNode;
+  m_nodes[node].nextFree = head;
+  if (head != InvalidNode) {
+    m_nodes[head].prevFree = node;
+  }
+  head = node;
+
+  m_firstLevelBitmap |= 1u << firstLevel;
+  m_secondLevelBitmaps[firstLevel] |= 1u << secondLevel;
+  ++m_freeRangeCount;
+}
+
+void TlsfAllocator::removeFree(uint32_t node) {
+  uint32_t firstLevel = 0;
+  uint32_t secondLevel = 0;
+  mapping(m_nodes[node].size, firstLevel, secondLevel);
+
+  auto &n = m_nodes[node];
+  if (n.prevFree != InvalidNode) {
+    m_nodes[n.prevFree].nextFree = n.nextFree;
+  }
+  if (n.nextFree != InvalidNode) {
+    m_nodes[n.nextFree].prevFree = n.prevFree;
+  }
+
+  auto &head = m_freeHeads[firstLevel * SecondLevelCount + secondLevel];
+  if (head == node) {
+    head = n.nextFree;
+    if (head == InvalidNode) {
+      m_secondLevelBitmaps[firstLevel] &= ~(1u << secondLevel);
+      if (m_secondLevelBitmaps[firstLevel] == 0) {
+        m_firstLevelBitmap &= ~(1u << firstLevel);
+      }
+    }
+  }
+
+  n.prevFree = InvalidNode;
+  n.nextFree = InvalidNode;
+  --m_freeRangeCount;
+}
+
+BufferAllocation::~BufferAllocation() {
+  if (allocator) {
+    allocator->release(*this);
+  }
+}
+
+BufferAllocator::~BufferAllocator() {
+  // Allocations outliving the allocator must not call back into it
+  for (auto &block : m_blocks) {
+    if (!block) {
+      continue;
+    }
+    for (auto &[node, allocation] : block->allocations) {
+      allocation->allocator = nullptr;
+    }
+  }
+}
+
+std::shared_ptr<BufferAllocation>
+BufferAllocator::allocate(GLsizeiptr size, const void *data) {
+  if (size <= 0) {
+    LOG_ERROR("BufferAllocator: cannot allocate {} bytes", size);
+    return nullptr;
+  }
+
+  if (!m_initialized) {
+    initialize();
+  }
+
+  auto units = (size + m_alignment - 1) / m_alignment;
+  if (units > std::numeric_limits<uint32_t>::max()) {
+    LOG_ERROR("BufferAllocator: allocation of {} bytes is too large", size);
+    return nullptr;
+  }
+
+  // Allocations larger than a block get a dedicated one
+  std::optional<std::pair<uint32_t, uint32_t>> slot;
+  if (size > m_blockSize) {
+    auto block = createBlock(static_cast<uint32_t>(units), true);
+    slot.emplace(block, *m_blocks[block]->allocator.allocate(
+                            static_cast<uint32_t>(units)));
+  } else {
+    slot = allocateUnits(static_cast<uint32_t>(units));
+    if (!slot) {
+      auto block = createBlock(
+          static_cast<uint32_t>((m_blockSize + m_alignment - 1) / m_alignment),
+          false);
+      slot.emplace(block, *m_blocks[block]->allocator.allocate(
+                              static_cast<uint32_t>(units)));
+    }
+  }
+
+  auto [blockIndex, node] = *slot;
+  auto &block = *m_blocks[blockIndex];
+
+  auto allocation = std::make_shared<BufferAllocation>();
+  allocation->allocator = this;
+  allocation->buffer = block.buffer.get();
+  allocation->offset =
+      static_cast<GLintptr>(block.allocator.getOffset(node)) * m_alignment;
+  allocation->size = size;
+  allocation->block = blockIndex;
+  allocation->node = node;
+  block.allocations[node] = allocation.get();
+
+  if (data) {
+    allocation->buffer->set_sub_data(allocation->offset, size, data);
+  }
+
+  return allocation;
+}
+
+void BufferAllocator::defragment(GLsizeiptr budget) {
+  if (!m_defragmentSource) {
+    m_defragmentSource = selectDefragmentSource();
+    if (!m_defragmentSource) {
+      return;
+    }
+    LOG_DEBUG("BufferAllocator: evacuating block {}", *m_defragmentSource);
+  }
+
+  auto sourceIndex = *m_defragmentSource;
+  auto &source = *m_blocks[sourceIndex];
+
+  // Ranges are copied on the GPU, commands already recorded against the old
+  // range are ordered before the copy so the data is never stale
+  GLsizeiptr moved = 0;
+  while (!source.allocations.empty() && moved < budget) {
+    auto it = source.allocations.begin();
+    auto *allocation = it->second;
+
+    auto slot = allocateUnits(source.allocator.getSize(allocation->node));
+    if (!slot) {
+      LOG_DEBUG("BufferAllocator: no room to evacuate block {}", sourceIndex);
+      m_defragmentSource.reset();
+      return;
+    }
+
+    auto [targetIndex, node] = *slot;
+    auto &target = *m_blocks[targetIndex];
+    auto targetOffset =
+        static_cast<GLintptr>(target.allocator.getOffset(node)) * m_alignment;
+    target.buffer->copy_sub_data(*source.buffer, allocation->offset,
+                                 targetOffset, allocation->size);
+    target.allocations[node] = allocation;
+
+    source.allocator.release(allocation->node);
+    source.allocations.erase(it);
+
+    allocation->buffer = target.buffer.get();
+    allocation->offset = targetOffset;
+    allocation->block = targetIndex;
+    allocation->node = node;
+
+    moved += allocation->size;
+  }
+  m_movedBytes += moved;
+
+  if (source.allocations.empty()) {
+    LOG_DEBUG("BufferAllocator: released block {}", sourceIndex);
+    m_blocks[sourceIndex].reset();
+    m_defragmentSource.reset();
+  }
+}
+
+BufferAllocatorStats BufferAllocator::getStats() const {
+  BufferAllocatorStats stats;
+  GLsizeiptr totalFree = 0;
+  for (const auto &block : m_blocks) {
+    if (!block) {
+      continue;
+    }
+    const auto &allocator = block->allocator;
+    ++stats.blockCount;
+    stats.allocationCount += block->allocations.size();
+    stats.capacity +=
+        static_cast<GLsizeiptr>(allocator.getCapacity()) * m_alignment;
+    stats.used += static_cast<GLsizeiptr>(allocator.getUsed()) * m_alignment;
+    stats.freeRangeCount += allocator.getFreeRangeCount();
+    stats.largestFreeRange =
+        std::max(stats.largestFreeRange,
+                 static_cast<GLsizeiptr>(allocator.getLargestFreeRange()) *
+                     m_alignment);
+    totalFree += static_cast<GLsizeiptr>(allocator.getCapacity() -
+                                         allocator.getUsed()) *
+                 m_alignment;
+  }
+
+  if (totalFree > 0) {
+    stats.fragmentation =
+        1.0f - static_cast<float>(stats.largestFreeRange) /
+                   static_cast<float>(totalFree);
+  }
+  stats.movedBytes = m_movedBytes;
+  return stats;
+}
+
+GLsizeiptr BufferAllocator::getAlignment() {
+  if (!m_initialized) {
+    initialize();
+  }
+  return m_alignment;
+}
+
+void BufferAllocator::initialize() {
+  GLint uniformAlignment = 0;
+  GLint storageAlignment = 0;
+  glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniformAlignment);
+  glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &storageAlignment);
+
+  // Both are powers of two, so the larger one satisfies either binding
+  m_alignment = std::max<GLsizeiptr>(
+      {16, static_cast<GLsizeiptr>(uniformAlignment),
+       static_cast<GLsizeiptr>(storageAlignment)});
+  m_blockSize = std::max(m_blockSize, m_alignment);
+  m_initialized = true;
+
+  LOG_INFO("BufferAllocator: offset alignment {} bytes", m_alignment);
+}
+
+uint32_t BufferAllocator::createBlock(uint32_t units, bool dedicated) {
+  auto block = std::make_unique<Block>();
+  block->buffer = std::make_unique<Buffer>();
+  block->buffer->set_storage(static_cast<GLsizeiptr>(units) * m_alignment,
+                             nullptr, GL_DYNAMIC_STORAGE_BIT);
+  block->allocator = TlsfAllocator(units);
+  block->dedicated = dedicated;
+
+  // Reuse a released slot so indices stay small
+  auto slot = std::find(m_blocks.begin(), m_blocks.end(), nullptr);
+  auto index = static_cast<uint32_t>(slot - m_blocks.begin());
+  if (slot == m_blocks.end()) {
+    m_blocks.push_back(std::move(block));
+  } else {
+    *slot = std::move(block);
+  }
+
+  if (!dedicated) {
+    LOG_INFO("BufferAllocator: created block {} ({} bytes)", index,
+             static_cast<GLsizeiptr>(units) * m_alignment);
+  }
+  return index;
+}
+
+std::optional<std::pair<uint32_t, uint32_t>>
+BufferAllocator::allocateUnits(uint32_t units) {
+  for (uint32_t i = 0; i < m_blocks.size(); ++i) {
+    auto &block = m_blocks[i];
+    if (!block || block->dedicated || m_defragmentSource == i) {
+      continue;
+    }
+    if (auto node = block->allocator.allocate(units)) {
+      return std::make_pair(i, *node);
+    }
+  }
+  return std::nullopt;
+}
+
+void BufferAllocator::release(const BufferAllocation &allocation) {
+  if (allocation.block >= m_blocks.size() || !m_blocks[allocation.block]) {
+    return;
+  }
+
+  auto &block = *m_blocks[allocation.block];
+  block.allocations.erase(allocation.node);
+  block.allocator.release(allocation.node);
+
+  // Regular blocks stay around for reuse, the defragmenter drops the sparse
+  // ones once another block can take their ranges
+  if (block.dedicated && block.allocations.empty()) {
+    m_blocks[allocation.block].reset();
+  }
+}
+
+std::optional<uint32_t> BufferAllocator::selectDefragmentSource() const {
+  std::optional<uint32_t> source;
+  float sourceOccupancy = DefragmentThreshold;
+  GLsizeiptr totalFree = 0;
+  size_t regularCount = 0;
+
+  for (uint32_t i = 0; i < m_blocks.size(); ++i) {
+    const auto &block = m_blocks[i];
+    if (!block || block->dedicated) {
+      continue;
+    }
+    const auto &allocator = block->allocator;
+    ++regularCount;
+    totalFree += allocator.getCapacity() - allocator.getUsed();
+
+    auto occupancy = static_cast<float>(allocator.getUsed()) /
+                     static_cast<float>(allocator.getCapacity());
+    if (occupancy < sourceOccupancy) {
+      source = i;
+      sourceOccupancy = occupancy;
+    }
+  }
+
+  if (!source || regularCount < 2) {
+    return std::nullopt;
+  }
+
+  // The other blocks must be able to take every live range
+  const auto &allocator = m_blocks[*source]->allocator;
+  auto otherFree = totalFree - (allocator.getCapacity() - allocator.getUsed());
+  if (otherFree < allocator.getUsed()) {
+    return std::nullopt;
+  }
+
+  return source;
+}
+
+} // namespace paimon
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include <glad/gl.h>
+
+#include "paimon/opengl/buffer.h"
+
+namespace paimon {
+
+// TlsfAllocator hands out [offset, offset + size) ranges from a fixed capacity
+// using a two-level segregated fit, so allocation and release are O(1) no
+// matter how many ranges are live. Ranges are identified by a node id that
+// stays stable until the range is released.
+class TlsfAllocator {
+public:
+  explicit TlsfAllocator(uint32_t capacity = 0);
+
+  // Good-fit allocation, returns the node id or std::nullopt when no free
+  // range is large enough
+  std::optional<uint32_t> allocate(uint32_t size);
+
+  void release(uint32_t node);
+
+  uint32_t getOffset(uint32_t node) const { return m_nodes[node].offset; }
+  uint32_t getSize(uint32_t node) const { return m_nodes[node].size; }
+
+  uint32_t getCapacity() const { return m_capacity; }
+  uint32_t getUsed() const { return m_used; }
+  uint32_t getFreeRangeCount() const { return m_freeRangeCount; }
+  uint32_t getLargestFreeRange() const;
+
+private:
+  static constexpr uint32_t InvalidNode = ~0u;
+  static constexpr uint32_t SecondLevelBits = 4;
+  static constexpr uint32_t SecondLevelCount = 1u << SecondLevelBits;
+  static constexpr uint32_t FirstLevelCount = 32;
+
+  struct Node {
+    uint32_t offset = 0;
+    uint32_t size = 0;
+    uint32_t prevPhysical = InvalidNode;
+    uint32_t nextPhysical = InvalidNode;
+    uint32_t prevFree = InvalidNode;
+    uint32_t nextFree = InvalidNode;
+    bool used = false;
+  };
+
+  static void mapping(uint32_t size, uint32_t &firstLevel,
+                      uint32_t &secondLevel);
+
+  uint32_t createNode();
+  void destroyNode(uint32_t node);
+
+  void insertFree(uint32_t node);
+  void removeFree(uint32_t node);
+
+private:
+  uint32_t m_capacity = 0;
+  uint32_t m_used = 0;
+  uint32_t m_freeRangeCount = 0;
+
+  std::vector<Node> m_nodes;
+  std::vector<uint32_t> m_recycledNodes;
+
+  // One bit per non-empty first level and per non-empty second level list
+  uint32_t m_firstLevelBitmap = 0;
+  std::array<uint32_t, FirstLevelCount> m_secondLevelBitmaps{};
+  std::array<uint32_t, FirstLevelCount * SecondLevelCount> m_freeHeads;
+};
+
+class BufferAllocator;
+
+// Range of a shared buffer block, released back to the allocator on
+// destruction. The defragmenter may move the range to another block or
+// offset, so read buffer and offset every frame instead of caching them.
+struct BufferAllocation {
+  BufferAllocator *allocator = nullptr;
+  Buffer *buffer = nullptr;
+  GLintptr offset = 0;
+  GLsizeiptr size = 0;
+
+  uint32_t block = 0;
+  uint32_t node = 0;
+
+  const Buffer &getBuffer() const { return *buffer; }
+
+  ~BufferAllocation();
+};
+
+struct BufferAllocatorStats {
+  size_t blockCount = 0;
+  size_t allocationCount = 0;
+  GLsizeiptr capacity = 0;
+  GLsizeiptr used = 0;
+  size_t freeRangeCount = 0;
+  GLsizeiptr largestFreeRange = 0;
+  // 0 when all free space is one contiguous range, approaching 1 as it
+  // splits into many small ranges
+  float fragmentation = 0.0f;
+  GLsizeiptr movedBytes = 0; // moved by the defragmenter so far
+};
+
+// BufferAllocator sub-allocates ranges for uniform and storage data out of a
+// few large immutable buffers instead of creating a buffer per user. Offsets
+// and sizes are rounded to the larger of the UBO and SSBO offset alignments,
+// so any allocation can be bound with bind_range.
+class BufferAllocator {
+public:
+  static constexpr GLsizeiptr DefaultBlockSize = 16 << 20;
+  static constexpr GLsizeiptr DefaultDefragmentBudget = 1 << 20;
+
+  // Blocks below this occupancy are evacuated by the defragmenter
+  static constexpr float DefragmentThreshold = 0.5f;
+
+  BufferAllocator() = default;
+  ~BufferAllocator();
+
+  // Delete copy constructor and assignment
+  BufferAllocator(const BufferAllocator &) = delete;
+  BufferAllocator &operator=(const BufferAllocator &) = delete;
+
+  // Allocate a range and optionally upload its initial contents, returns
+  // nullptr on failure
+  std::shared_ptr<BufferAllocation> allocate(GLsizeiptr size,
+                                             const void *data = nullptr);
+
+  // Move live ranges out of the sparsest block, copying at most budget bytes,
+  // call once per frame before any pass binds an allocation
+  void defragment(GLsizeiptr budget = DefaultDefragmentBudget);
+
+  BufferAllocatorStats getStats() const;
+
+  GLsizeiptr getAlignment();
+
+  void setBlockSize(GLsizeiptr size) { m_blockSize = size; }
+
+private:
+  friend struct BufferAllocation;
+
+  struct Block {
+    std::unique_ptr<Buffer> buffer;
+    TlsfAllocator allocator;
+    std::unordered_map<uint32_t, BufferAllocation *> allocations;
+    bool dedicated = false;
+  };
+
+  void initialize();
+
+  // Create a block of at least the given size in units, returns its index
+  uint32_t createBlock(uint32_t units, bool dedicated);
+
+  // Allocate units from a regular block, skipping the defragment source
+  std::optional<std::pair<uint32_t, uint32_t>> allocateUnits(uint32_t units);
+
+  void release(const BufferAllocation &allocation);
+
+  // Pick the regular block to evacuate, if any is sparse enough
+  std::optional<uint32_t> selectDefragmentSource() const;
+
+private:
+  bool m_initialized = false;
+  GLsizeiptr m_alignment = 256;
+  GLsizeiptr m_blockSize = DefaultBlockSize;
+  GLsizeiptr m_movedBytes = 0;
+
+  // Released blocks leave a null slot so block indices stay stable
+  std::vector<std::unique_ptr<Block>> m_blocks;
+
+  std::optional<uint32_t> m_defragmentSource;
+};
+
+} // namespace paimon
@@ -0,0 +1,70 @@
+#include "paimon/rendering/deletion_queue.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include <glad/gl.h>
+
+#include "paimon/core/log_system.h"
+
+namespace paimon {
+
+void DeletionQueue::retire(std::shared_ptr<void> resource) {
+  if (resource) {
+    m_current.push_back(std::move(resource));
+  }
+}
+
+void DeletionQueue::retire(std::vector<std::shared_ptr<void>> resources) {
+  std::erase(resources, nullptr);
+  if (m_current.empty()) {
+    m_current = std::move(resources);
+    return;
+  }
+  m_current.insert(m_current.end(),
+                   std::make_move_iterator(resources.begin()),
+                   std::make_move_iterator(resources.end()));
+}
+
+void DeletionQueue::beginFrame() {
+  // Everything retired so far may still be referenced by submitted commands
+  if (!m_current.empty()) {
+    m_inFlight.push_back(Batch{std::move(m_current)});
+    m_current.clear();
+  }
+
+  while (!m_inFlight.empty()) {
+    auto& batch = m_inFlight.front();
+    if (batch.fence.client_wait(0, 0) == GL_TIMEOUT_EXPIRED) {
+      break;
+    }
+    std::move(batch.resources.begin(), batch.resources.end(),
+              std::back_inserter(m_ready));
+    m_inFlight.pop_front();
+  }
+
+  auto count = std::min(m_ready.size(), m_maxDeletionsPerFrame);
+  m_ready.erase(m_ready.begin(), m_ready.begin() + count);
+
+  if (!m_ready.empty()) {
+    LOG_DEBUG("DeletionQueue: {} resources deferred to the next frame",
+              m_ready.size());
+  }
+}
+
+void DeletionQueue::flush() {
+  glFinish();
+  m_ready.clear();
+  m_inFlight.clear();
+  m_current.clear();
+}
+
+size_t DeletionQueue::getPendingCount() const {
+  size_t count = m_current.size() + m_ready.size();
+  for (const auto& batch : m_inFlight) {
+    count += batch.resources.size();
+  }
+  return count;
+}
+
+} // namespace paimon
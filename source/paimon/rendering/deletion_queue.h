@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "paimon/opengl/base/object.h"
+
+namespace paimon {
+
+// DeletionQueue keeps released GPU resources alive until the GPU is done with
+// them. Resources retired during a frame are tagged with a fence at the next
+// frame boundary and destroyed once it has signaled, at most
+// MaxDeletionsPerFrame per frame so unloading a large scene does not hitch.
+//
+// Any owner can be retired (Texture, Buffer, Framebuffer, sg::Primitive, ...),
+// the last reference is dropped by the queue.
+class DeletionQueue {
+public:
+  static constexpr size_t DefaultMaxDeletionsPerFrame = 256;
+
+  DeletionQueue() = default;
+  ~DeletionQueue() = default;
+
+  // Delete copy constructor and assignment
+  DeletionQueue(const DeletionQueue&) = delete;
+  DeletionQueue& operator=(const DeletionQueue&) = delete;
+
+  // Defer the release of a resource, null pointers are ignored
+  void retire(std::shared_ptr<void> resource);
+
+  // Bulk version, avoids per-object overhead when unloading a scene
+  void retire(std::vector<std::shared_ptr<void>> resources);
+
+  // Fence the resources retired since the last call and destroy those whose
+  // fence has signaled, call once per frame on the GL thread
+  void beginFrame();
+
+  // Wait for the GPU and destroy everything immediately
+  void flush();
+
+  void setMaxDeletionsPerFrame(size_t count) { m_maxDeletionsPerFrame = count; }
+  size_t getMaxDeletionsPerFrame() const { return m_maxDeletionsPerFrame; }
+
+  // Resources retired but not destroyed yet
+  size_t getPendingCount() const;
+
+private:
+  struct Batch {
+    std::vector<std::shared_ptr<void>> resources;
+    SyncObject fence;
+  };
+
+private:
+  size_t m_maxDeletionsPerFrame = DefaultMaxDeletionsPerFrame;
+
+  // Retired during the current frame
+  std::vector<std::shared_ptr<void>> m_current;
+
+  // Waiting for their fence, oldest first
+  std::deque<Batch> m_inFlight;
+
+  // Safe to destroy, spread across frames
+  std::deque<std::shared_ptr<void>> m_ready;
+};
+
+} // namespace paimon
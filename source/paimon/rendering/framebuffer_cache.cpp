@@ -1,33 +1,41 @@
 #include "paimon/rendering/framebuffer_cache.h"
 
+#include <algorithm>
+
 #include "paimon/core/hash.h"
 #include "paimon/core/log_system.h"
+#include "paimon/rendering/deletion_queue.h"
 
 namespace paimon {
 
-constexpr std::size_t defaultFramebufferKey = 0;
-
 FramebufferCache::FramebufferCache() {
   // create default framebuffer entry
-  auto defaultFramebuffer = std::make_unique<Framebuffer>(true); // true = default framebuffer
-  m_cache[defaultFramebufferKey] = std::move(defaultFramebuffer);
-  LOG_INFO("Initialized FramebufferCache with default framebuffer (key 0)");
+  m_defaultFramebuffer = std::make_unique<Framebuffer>(true); // true = default framebuffer
+
+  // Destroyed textures must not leave framebuffers behind that a recycled GL
+  // name could be attached to
+  m_destroyCallbackId = Texture::add_destroy_callback(
+      [this](const Texture& texture) { invalidate(texture); });
+
+  LOG_INFO("Initialized FramebufferCache with default framebuffer");
+}
+
+FramebufferCache::~FramebufferCache() {
+  Texture::remove_destroy_callback(m_destroyCallbackId);
 }
 
 Framebuffer* FramebufferCache::get(const RenderingInfo& info) {
   // Compute hash directly from RenderingInfo
   std::size_t hash = createHash(info);
-  
-  // Ensure hash is not 0 (reserved for default framebuffer)
-  if (hash == 0) {
-    hash = 1;
-  }
 
   // Check if framebuffer already exists in cache
   auto it = m_cache.find(hash);
   if (it != m_cache.end()) {
-    return it->second.get();
+    ++m_stats.hits;
+    m_lru.splice(m_lru.begin(), m_lru, it->second.lru);
+    return it->second.framebuffer.get();
   }
+  ++m_stats.misses;
 
   // Create new framebuffer
   auto framebuffer = createFramebuffer(info);
@@ -42,30 +50,74 @@ Framebuffer* FramebufferCache::get(const RenderingInfo& info) {
     return nullptr;
   }
 
-  Framebuffer* ptr = framebuffer.get();
-  m_cache[hash] = std::move(framebuffer);
+  Entry entry;
+  entry.framebuffer = std::move(framebuffer);
+  for (const auto& attachment : info.colorAttachments) {
+    entry.generations.push_back(attachment.texture.get_generation());
+  }
+  if (info.depthAttachment.has_value()) {
+    entry.generations.push_back(info.depthAttachment->texture.get_generation());
+  }
+  if (info.stencilAttachment.has_value()) {
+    entry.generations.push_back(info.stencilAttachment->texture.get_generation());
+  }
+  for (auto generation : entry.generations) {
+    m_textureKeys[generation].push_back(hash);
+  }
+
+  m_lru.push_front(hash);
+  entry.lru = m_lru.begin();
+
+  Framebuffer* ptr = entry.framebuffer.get();
+  m_cache.emplace(hash, std::move(entry));
 
   LOG_INFO("Created and cached new framebuffer with hash {} (cache size: {})", hash, m_cache.size());
-  
+
+  evict();
+
   return ptr;
 }
 
 Framebuffer* FramebufferCache::get(const SwapchainRenderingInfo&) {
-  // Default framebuffer uses key=0
-  return m_cache[defaultFramebufferKey].get();
+  return m_defaultFramebuffer.get();
+}
+
+void FramebufferCache::invalidate(const Texture& texture) {
+  auto it = m_textureKeys.find(texture.get_generation());
+  if (it == m_textureKeys.end()) {
+    return;
+  }
+
+  auto keys = std::move(it->second);
+  m_textureKeys.erase(it);
+
+  for (auto key : keys) {
+    if (m_cache.contains(key)) {
+      erase(key);
+      ++m_stats.invalidations;
+    }
+  }
 }
 
 void FramebufferCache::clear() {
   m_cache.clear();
+  m_lru.clear();
+  m_textureKeys.clear();
   LOG_INFO("Framebuffer cache cleared");
 }
 
+void FramebufferCache::setCapacity(size_t capacity) {
+  m_capacity = capacity;
+  evict();
+}
+
 std::size_t FramebufferCache::createHash(const RenderingInfo& info) const {
   std::size_t hash = 0;
 
   // Hash color attachments
   for (const auto& colorAttachment : info.colorAttachments) {
     hashCombine(hash, colorAttachment.texture.get_name());
+    hashCombine(hash, colorAttachment.texture.get_generation());
     hashCombine(hash, colorAttachment.mipLevel);
     hashCombine(hash, colorAttachment.arrayLayer);
   }
@@ -74,6 +126,7 @@ std::size_t FramebufferCache::createHash(const RenderingInfo& info) const {
   if (info.depthAttachment.has_value()) {
     const auto& att = info.depthAttachment.value();
     hashCombine(hash, att.texture.get_name());
+    hashCombine(hash, att.texture.get_generation());
     hashCombine(hash, att.mipLevel);
     hashCombine(hash, att.arrayLayer);
   }
@@ -82,6 +135,7 @@ std::size_t FramebufferCache::createHash(const RenderingInfo& info) const {
   if (info.stencilAttachment.has_value()) {
     const auto& att = info.stencilAttachment.value();
     hashCombine(hash, att.texture.get_name());
+    hashCombine(hash, att.texture.get_generation());
     hashCombine(hash, att.mipLevel);
     hashCombine(hash, att.arrayLayer);
   }
@@ -89,6 +143,42 @@ std::size_t FramebufferCache::createHash(const RenderingInfo& info) const {
   return hash;
 }
 
+void FramebufferCache::erase(std::size_t key) {
+  auto it = m_cache.find(key);
+  if (it == m_cache.end()) {
+    return;
+  }
+
+  // Drop the reverse references of the other attachments
+  for (auto generation : it->second.generations) {
+    auto keysIt = m_textureKeys.find(generation);
+    if (keysIt == m_textureKeys.end()) {
+      continue;
+    }
+    std::erase(keysIt->second, key);
+    if (keysIt->second.empty()) {
+      m_textureKeys.erase(keysIt);
+    }
+  }
+
+  if (m_deletionQueue) {
+    m_deletionQueue->retire(std::move(it->second.framebuffer));
+  }
+
+  m_lru.erase(it->second.lru);
+  m_cache.erase(it);
+}
+
+void FramebufferCache::evict() {
+  // The most recently used framebuffer is always kept, it may be bound
+  while (m_cache.size() > std::max<size_t>(m_capacity, 1)) {
+    auto key = m_lru.back();
+    erase(key);
+    ++m_stats.evictions;
+    LOG_DEBUG("Evicted framebuffer with hash {} (cache size: {})", key, m_cache.size());
+  }
+}
+
 std::unique_ptr<Framebuffer> FramebufferCache::createFramebuffer(
     const RenderingInfo& info) const {
   auto framebuffer = std::make_unique<Framebuffer>();
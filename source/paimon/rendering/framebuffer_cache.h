@@ -1,18 +1,32 @@
 #pragma once
 
+#include <cstdint>
+#include <list>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include "paimon/opengl/framebuffer.h"
 #include "paimon/rendering/rendering_info.h"
 
 namespace paimon {
 
+class DeletionQueue;
+
+struct FramebufferCacheStats {
+  size_t hits = 0;
+  size_t misses = 0;
+  size_t evictions = 0;     // dropped by the LRU cap
+  size_t invalidations = 0; // dropped because an attachment was destroyed
+};
+
 // FramebufferCache manages framebuffer objects based on attachment configurations
 class FramebufferCache {
 public:
+  static constexpr size_t DefaultCapacity = 64;
+
   FramebufferCache();
-  ~FramebufferCache() = default;
+  ~FramebufferCache();
 
   // Delete copy constructor and assignment
   FramebufferCache(const FramebufferCache&) = delete;
@@ -21,25 +35,65 @@ public:
   // Get or create a framebuffer based on RenderingInfo
   Framebuffer* get(const RenderingInfo& info);
 
-  // Get or create default framebuffer (uses key=0)
+  // Get default framebuffer
   Framebuffer* get(const SwapchainRenderingInfo&);
 
-  // Clear the cache
+  // Drop every framebuffer that has the texture attached
+  void invalidate(const Texture& texture);
+
+  // Clear the cache, the default framebuffer is kept
   void clear();
 
+  // Maximum number of cached framebuffers before the least recently used one
+  // is evicted
+  void setCapacity(size_t capacity);
+  size_t getCapacity() const { return m_capacity; }
+
+  // Dropped framebuffers are retired here instead of deleted immediately
+  void setDeletionQueue(DeletionQueue* deletionQueue) {
+    m_deletionQueue = deletionQueue;
+  }
+
   // Get cache statistics
   size_t getCacheSize() const { return m_cache.size(); }
+  const FramebufferCacheStats& getStats() const { return m_stats; }
 
 private:
-  // Compute hash from RenderingInfo
+  struct Entry {
+    std::unique_ptr<Framebuffer> framebuffer;
+    std::vector<uint64_t> generations; // attached texture generations
+    std::list<std::size_t>::iterator lru;
+  };
+
+  // Compute hash from RenderingInfo, tagged with the texture generations so a
+  // recycled GL name never matches a stale entry
   std::size_t createHash(const RenderingInfo& info) const;
 
   // Create a new framebuffer from RenderingInfo
   std::unique_ptr<Framebuffer> createFramebuffer(const RenderingInfo& info) const;
 
+  void erase(std::size_t key);
+
+  void evict();
+
 private:
-  // Cache uses hash value as key, with 0 reserved for default framebuffer
-  std::unordered_map<std::size_t, std::unique_ptr<Framebuffer>> m_cache;
+  DeletionQueue* m_deletionQueue = nullptr;
+
+  std::unique_ptr<Framebuffer> m_defaultFramebuffer;
+
+  // Cache uses hash value as key
+  std::unordered_map<std::size_t, Entry> m_cache;
+
+  // Keys ordered from most to least recently used
+  std::list<std::size_t> m_lru;
+
+  // Texture generation -> keys of the framebuffers it is attached to
+  std::unordered_map<uint64_t, std::vector<std::size_t>> m_textureKeys;
+
+  size_t m_capacity = DefaultCapacity;
+  size_t m_destroyCallbackId = 0;
+
+  FramebufferCacheStats m_stats;
 };
 
 } // namespace paimon
@@ -0,0 +1,238 @@
+#include "paimon/rendering/geometry_pool.h"
+
+#include <algorithm>
+
+#include <glad/gl.h>
+
+#include "paimon/core/log_system.h"
+#include "paimon/rendering/render_context.h"
+
+namespace paimon {
+
+FreeListAllocator::FreeListAllocator(uint32_t capacity) : m_capacity(capacity) {
+  if (capacity > 0) {
+    m_freeBlocks.emplace(0, capacity);
+  }
+}
+
+std::optional<uint32_t> FreeListAllocator::allocate(uint32_t size) {
+  if (size == 0) {
+    return std::nullopt;
+  }
+
+  // Best fit keeps large blocks intact for large meshes
+  auto best = m_freeBlocks.end();
+  for (auto it = m_freeBlocks.begin(); it != m_freeBlocks.end(); ++it) {
+    if (it->second >= size &&
+        (best == m_freeBlocks.end() || it->second < best->second)) {
+      best = it;
+      if (it->second == size) {
+        break;
+      }
+    }
+  }
+
+  if (best == m_freeBlocks.end()) {
+    return std::nullopt;
+  }
+
+  auto offset = best->first;
+  auto remaining = best->second - size;
+  m_freeBlocks.erase(best);
+  if (remaining > 0) {
+    m_freeBlocks.emplace(offset + size, remaining);
+  }
+
+  m_used += size;
+  return offset;
+}
+
+void FreeListAllocator::release(uint32_t offset, uint32_t size) {
+  if (size == 0) {
+    return;
+  }
+
+  auto [it, inserted] = m_freeBlocks.emplace(offset, size);
+  if (!inserted) {
+    LOG_ERROR("FreeListAllocator: double release at offset {}", offset);
+    return;
+  }
+  m_used -= size;
+
+  // Merge with the following block
+  auto next = std::next(it);
+  if (next != m_freeBlocks.end() && it->first + it->second == next->first) {
+    it->second += next->second;
+    m_freeBlocks.erase(next);
+  }
+
+  // Merge with the preceding block
+  if (it != m_freeBlocks.begin()) {
+    auto prev = std::prev(it);
+    if (prev->first + prev->second == it->first) {
+      prev->second += it->second;
+      m_freeBlocks.erase(it);
+    }
+  }
+}
+
+GeometryAllocation::~GeometryAllocation() {
+  if (pool) {
+    pool->release(*this);
+  }
+}
+
+std::shared_ptr<GeometryAllocation>
+GeometryPool::upload(const GeometryData& data) {
+  auto vertexCount = static_cast<uint32_t>(data.vertexCount);
+  auto indexCount = static_cast<uint32_t>(data.indices.size());
+
+  if (vertexCount == 0) {
+    LOG_ERROR("GeometryPool: cannot upload geometry without vertices");
+    return nullptr;
+  }
+
+  // Find a page with room for both ranges
+  std::optional<uint32_t> baseVertex;
+  std::optional<uint32_t> firstIndex;
+  uint32_t pageIndex = 0;
+  for (; pageIndex < m_pages.size(); ++pageIndex) {
+    auto& page = *m_pages[pageIndex];
+    baseVertex = page.vertexAllocator.allocate(vertexCount);
+    if (!baseVertex) {
+      continue;
+    }
+    if (indexCount > 0) {
+      firstIndex = page.indexAllocator.allocate(indexCount);
+      if (!firstIndex) {
+        page.vertexAllocator.release(*baseVertex, vertexCount);
+        baseVertex.reset();
+        continue;
+      }
+    }
+    break;
+  }
+
+  if (pageIndex == m_pages.size()) {
+    auto page = createPage(std::max(PageVertexCapacity, vertexCount),
+                           std::max(PageIndexCapacity, indexCount));
+    baseVertex = page->vertexAllocator.allocate(vertexCount);
+    if (indexCount > 0) {
+      firstIndex = page->indexAllocator.allocate(indexCount);
+    }
+    m_pages.push_back(std::move(page));
+
+    LOG_INFO("GeometryPool: created page {} ({} vertices, {} indices)",
+             pageIndex, m_pages.back()->vertexAllocator.getCapacity(),
+             m_pages.back()->indexAllocator.getCapacity());
+  }
+
+  auto& page = *m_pages[pageIndex];
+
+  // Missing attributes are zero-filled so stale data from released ranges
+  // never leaks into a new primitive
+  auto uploadAttribute = [&](const Buffer& buffer, const void* source,
+                             size_t count, GLsizeiptr stride,
+                             const char* name) {
+    GLintptr offset = static_cast<GLintptr>(*baseVertex) * stride;
+    GLsizeiptr size = static_cast<GLsizeiptr>(vertexCount) * stride;
+    if (count == vertexCount) {
+      buffer.set_sub_data(offset, size, source);
+      return;
+    }
+    if (count > 0) {
+      LOG_WARN("GeometryPool: {} count {} does not match vertex count {}",
+               name, count, vertexCount);
+    }
+    buffer.clear_sub_data(GL_R32F, offset, size, GL_RED, GL_FLOAT, nullptr);
+  };
+
+  uploadAttribute(page.positions, data.positions.data(),
+                  data.positions.size(), sizeof(glm::vec3), "Position");
+  uploadAttribute(page.normals, data.normals.data(), data.normals.size(),
+                  sizeof(glm::vec3), "Normal");
+  uploadAttribute(page.texcoords, data.texcoords.data(),
+                  data.texcoords.size(), sizeof(glm::vec2), "TexCoord");
+  uploadAttribute(page.colors, data.colors.data(), data.colors.size(),
+                  sizeof(glm::vec3), "Color");
+
+  if (indexCount > 0) {
+    page.indices.set_sub_data(
+        static_cast<GLintptr>(*firstIndex) * sizeof(uint32_t),
+        static_cast<GLsizeiptr>(indexCount) * sizeof(uint32_t),
+        data.indices.data());
+  }
+
+  auto allocation = std::make_shared<GeometryAllocation>();
+  allocation->pool = this;
+  allocation->page = pageIndex;
+  allocation->baseVertex = *baseVertex;
+  allocation->vertexCount = vertexCount;
+  allocation->firstIndex = firstIndex.value_or(0);
+  allocation->indexCount = indexCount;
+  return allocation;
+}
+
+void GeometryPool::bind(RenderContext& ctx, uint32_t page) const {
+  if (page >= m_pages.size()) {
+    LOG_ERROR("GeometryPool: page {} out of range", page);
+    return;
+  }
+
+  const auto& p = *m_pages[page];
+  ctx.bindVertexBuffer(0, p.positions, 0, sizeof(glm::vec3));
+  ctx.bindVertexBuffer(1, p.normals, 0, sizeof(glm::vec3));
+  ctx.bindVertexBuffer(2, p.texcoords, 0, sizeof(glm::vec2));
+  ctx.bindVertexBuffer(3, p.colors, 0, sizeof(glm::vec3));
+  ctx.bindIndexBuffer(p.indices, DataType::UInt);
+}
+
+size_t GeometryPool::getUsedVertices() const {
+  size_t used = 0;
+  for (const auto& page : m_pages) {
+    used += page->vertexAllocator.getUsed();
+  }
+  return used;
+}
+
+size_t GeometryPool::getUsedIndices() const {
+  size_t used = 0;
+  for (const auto& page : m_pages) {
+    used += page->indexAllocator.getUsed();
+  }
+  return used;
+}
+
+std::unique_ptr<GeometryPool::Page>
+GeometryPool::createPage(uint32_t vertexCapacity,
+                         uint32_t indexCapacity) const {
+  auto page = std::make_unique<Page>();
+
+  page->positions.set_storage(vertexCapacity * sizeof(glm::vec3), nullptr,
+                              GL_DYNAMIC_STORAGE_BIT);
+  page->normals.set_storage(vertexCapacity * sizeof(glm::vec3), nullptr,
+                            GL_DYNAMIC_STORAGE_BIT);
+  page->texcoords.set_storage(vertexCapacity * sizeof(glm::vec2), nullptr,
+                              GL_DYNAMIC_STORAGE_BIT);
+  page->colors.set_storage(vertexCapacity * sizeof(glm::vec3), nullptr,
+                           GL_DYNAMIC_STORAGE_BIT);
+  page->indices.set_storage(indexCapacity * sizeof(uint32_t), nullptr,
+                            GL_DYNAMIC_STORAGE_BIT);
+
+  page->vertexAllocator = FreeListAllocator(vertexCapacity);
+  page->indexAllocator = FreeListAllocator(indexCapacity);
+
+  return page;
+}
+
+void GeometryPool::release(const GeometryAllocation& allocation) {
+  if (allocation.page >= m_pages.size()) {
+    return;
+  }
+
+  auto& page = *m_pages[allocation.page];
+  page.vertexAllocator.release(allocation.baseVertex, allocation.vertexCount);
+  page.indexAllocator.release(allocation.firstIndex, allocation.indexCount);
+}
+
+} // namespace paimon
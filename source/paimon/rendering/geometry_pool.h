@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "paimon/opengl/buffer.h"
+
+namespace paimon {
+
+class RenderContext;
+
+// FreeListAllocator hands out [offset, offset + size) ranges from a fixed
+// capacity, coalescing neighbouring blocks on release
+class FreeListAllocator {
+public:
+  explicit FreeListAllocator(uint32_t capacity = 0);
+
+  // Best-fit allocation, returns std::nullopt when no block is large enough
+  std::optional<uint32_t> allocate(uint32_t size);
+
+  void release(uint32_t offset, uint32_t size);
+
+  uint32_t getCapacity() const { return m_capacity; }
+  uint32_t getUsed() const { return m_used; }
+
+private:
+  uint32_t m_capacity = 0;
+  uint32_t m_used = 0;
+
+  // Free blocks keyed by offset, value is block size
+  std::map<uint32_t, uint32_t> m_freeBlocks;
+};
+
+// Source data for one primitive, missing attributes may be left empty
+struct GeometryData {
+  size_t vertexCount = 0;
+  std::span<const glm::vec3> positions;
+  std::span<const glm::vec3> normals;
+  std::span<const glm::vec2> texcoords;
+  std::span<const glm::vec3> colors;
+  std::span<const uint32_t> indices;
+};
+
+class GeometryPool;
+
+// Vertex and index ranges owned by a primitive, released back to the pool on
+// destruction
+struct GeometryAllocation {
+  GeometryPool *pool = nullptr;
+  uint32_t page = 0;
+  uint32_t baseVertex = 0;
+  uint32_t vertexCount = 0;
+  uint32_t firstIndex = 0;
+  uint32_t indexCount = 0;
+
+  ~GeometryAllocation();
+};
+
+// GeometryPool sub-allocates vertex and index ranges for all loaded meshes out
+// of a few large immutable buffers (one set per page), so a whole scene can be
+// drawn with a single vertex array binding and base-vertex draws
+class GeometryPool {
+public:
+  // Capacity of a regular page, larger meshes get a dedicated page
+  static constexpr uint32_t PageVertexCapacity = 1u << 18;
+  static constexpr uint32_t PageIndexCapacity = 1u << 20;
+
+  GeometryPool() = default;
+  ~GeometryPool() = default;
+
+  // Delete copy constructor and assignment
+  GeometryPool(const GeometryPool&) = delete;
+  GeometryPool& operator=(const GeometryPool&) = delete;
+
+  // Allocate ranges and upload the data, returns nullptr on failure
+  std::shared_ptr<GeometryAllocation> upload(const GeometryData& data);
+
+  // Bind the vertex and index buffers of a page to the current vertex array
+  void bind(RenderContext& ctx, uint32_t page) const;
+
+  // Get pool statistics
+  size_t getPageCount() const { return m_pages.size(); }
+  size_t getUsedVertices() const;
+  size_t getUsedIndices() const;
+
+private:
+  friend struct GeometryAllocation;
+
+  struct Page {
+    Buffer positions;
+    Buffer normals;
+    Buffer texcoords;
+    Buffer colors;
+    Buffer indices;
+
+    FreeListAllocator vertexAllocator;
+    FreeListAllocator indexAllocator;
+  };
+
+  std::unique_ptr<Page> createPage(uint32_t vertexCapacity,
+                                   uint32_t indexCapacity) const;
+
+  void release(const GeometryAllocation& allocation);
+
+private:
+  std::vector<std::unique_ptr<Page>> m_pages;
+};
+
+} // namespace paimon
@@ -0,0 +1,178 @@
+#include "paimon/rendering/gpu_timer_pool.h"
+
+#include <algorithm>
+#include <limits>
+
+#include <glad/gl.h>
+
+#include "paimon/core/log_system.h"
+
+namespace paimon {
+
+namespace {
+// End query index of a scope left open at the frame boundary
+constexpr uint32_t UnclosedScope = std::numeric_limits<uint32_t>::max();
+} // namespace
+
+void GpuTimerPool::beginFrame() {
+  if (!m_openTimers.empty()) {
+    LOG_WARN("GpuTimerPool: {} scopes still open at frame boundary",
+             m_openTimers.size());
+    m_openTimers.clear();
+  }
+
+  auto& current = m_frames[m_frameIndex % FrameLatency];
+  if (!current.timers.empty()) {
+    current.pending = true;
+  }
+
+  // Resolve in submission order, a frame that is not ready implies the
+  // following ones are not either
+  for (uint32_t i = 1; i <= FrameLatency; ++i) {
+    auto& frame = m_frames[(m_frameIndex + i) % FrameLatency];
+    if (frame.pending && !resolve(frame)) {
+      break;
+    }
+  }
+
+  ++m_frameIndex;
+
+  // Reuse the oldest slot, dropping its results if they are still not ready
+  auto& next = m_frames[m_frameIndex % FrameLatency];
+  if (next.pending) {
+    ++m_droppedFrames;
+    LOG_DEBUG("GpuTimerPool: dropped timings of frame {}",
+              m_frameIndex - FrameLatency);
+  }
+  next.pending = false;
+  next.queryCount = 0;
+  next.timers.clear();
+}
+
+void GpuTimerPool::beginScope(std::string_view name) {
+  if (!m_enabled) {
+    return;
+  }
+
+  auto& frame = m_frames[m_frameIndex % FrameLatency];
+  auto beginQuery = frame.queryCount;
+  acquireQuery(frame).query_counter();
+
+  m_openTimers.push_back(static_cast<uint32_t>(frame.timers.size()));
+  frame.timers.push_back({getScopeIndex(name), beginQuery, UnclosedScope});
+}
+
+void GpuTimerPool::endScope() {
+  if (!m_enabled) {
+    return;
+  }
+  if (m_openTimers.empty()) {
+    LOG_ERROR("GpuTimerPool: endScope without matching beginScope");
+    return;
+  }
+
+  auto& frame = m_frames[m_frameIndex % FrameLatency];
+  auto& timer = frame.timers[m_openTimers.back()];
+  m_openTimers.pop_back();
+
+  timer.endQuery = frame.queryCount;
+  acquireQuery(frame).query_counter();
+}
+
+void GpuTimerPool::reset() {
+  for (auto& frame : m_frames) {
+    frame.pending = false;
+    frame.queryCount = 0;
+    frame.timers.clear();
+  }
+  m_openTimers.clear();
+  m_droppedFrames = 0;
+
+  for (auto& scope : m_scopes) {
+    scope.sampleCount = 0;
+  }
+}
+
+std::vector<GpuTimerStats> GpuTimerPool::getStats() const {
+  std::vector<GpuTimerStats> result;
+  result.reserve(m_scopes.size());
+
+  std::vector<double> sorted;
+  for (const auto& scope : m_scopes) {
+    GpuTimerStats stats;
+    stats.name = scope.name;
+    stats.sampleCount = scope.sampleCount;
+
+    auto count = static_cast<size_t>(
+        std::min<uint64_t>(scope.sampleCount, SampleHistory));
+    if (count > 0) {
+      sorted.assign(scope.samples.begin(), scope.samples.begin() + count);
+      std::sort(sorted.begin(), sorted.end());
+
+      double sum = 0.0;
+      for (auto sample : sorted) {
+        sum += sample;
+      }
+
+      stats.lastMs = scope.samples[(scope.sampleCount - 1) % SampleHistory];
+      stats.minMs = sorted.front();
+      stats.avgMs = sum / static_cast<double>(count);
+      stats.p99Ms = sorted[std::min(count - 1, count * 99 / 100)];
+    }
+
+    result.push_back(std::move(stats));
+  }
+  return result;
+}
+
+uint32_t GpuTimerPool::getScopeIndex(std::string_view name) {
+  auto it = m_scopeIndices.find(std::string(name));
+  if (it != m_scopeIndices.end()) {
+    return it->second;
+  }
+
+  auto index = static_cast<uint32_t>(m_scopes.size());
+  m_scopes.push_back({.name = std::string(name)});
+  m_scopeIndices.emplace(std::string(name), index);
+  return index;
+}
+
+Query& GpuTimerPool::acquireQuery(Frame& frame) {
+  if (frame.queryCount == frame.queries.size()) {
+    frame.queries.push_back(std::make_unique<Query>(GL_TIMESTAMP));
+  }
+  return *frame.queries[frame.queryCount++];
+}
+
+bool GpuTimerPool::resolve(Frame& frame) {
+  // Timestamps usually complete in order, check the newest query first
+  for (auto it = frame.timers.rbegin(); it != frame.timers.rend(); ++it) {
+    if (it->endQuery == UnclosedScope) {
+      continue;
+    }
+    auto& query = *frame.queries[it->endQuery];
+    if (query.get<GLuint>(GL_QUERY_RESULT_AVAILABLE) == GL_FALSE) {
+      return false;
+    }
+  }
+
+  for (const auto& timer : frame.timers) {
+    if (timer.endQuery == UnclosedScope) {
+      continue;
+    }
+
+    auto begin =
+        frame.queries[timer.beginQuery]->get<GLuint64>(GL_QUERY_RESULT);
+    auto end = frame.queries[timer.endQuery]->get<GLuint64>(GL_QUERY_RESULT);
+
+    auto& scope = m_scopes[timer.scope];
+    scope.samples[scope.sampleCount % SampleHistory] =
+        static_cast<double>(end - begin) * 1e-6;
+    ++scope.sampleCount;
+  }
+
+  frame.pending = false;
+  return true;
+}
+
+} // namespace paimon
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "paimon/opengl/query.h"
+
+namespace paimon {
+
+// Aggregated GPU time of one named scope, in milliseconds
+struct GpuTimerStats {
+  std::string name;
+  uint64_t sampleCount = 0;
+  double lastMs = 0.0;
+  double minMs = 0.0;
+  double avgMs = 0.0;
+  double p99Ms = 0.0;
+};
+
+// GpuTimerPool measures GPU time of named scopes with GL_TIMESTAMP query pairs.
+// Queries are recycled from a ring of FrameLatency frames and results are only
+// read once GL_QUERY_RESULT_AVAILABLE reports them ready, so timing a scope
+// never stalls the pipeline.
+class GpuTimerPool {
+public:
+  // Frames a query may stay in flight before its slot is reused
+  static constexpr uint32_t FrameLatency = 4;
+
+  // Number of recent samples kept per scope for the statistics
+  static constexpr uint32_t SampleHistory = 256;
+
+  GpuTimerPool() = default;
+  ~GpuTimerPool() = default;
+
+  // Delete copy constructor and assignment
+  GpuTimerPool(const GpuTimerPool&) = delete;
+  GpuTimerPool& operator=(const GpuTimerPool&) = delete;
+
+  // Resolve finished frames and start recording a new one
+  void beginFrame();
+
+  // Scopes may nest, each endScope() closes the innermost open scope
+  void beginScope(std::string_view name);
+  void endScope();
+
+  void setEnabled(bool enabled) { m_enabled = enabled; }
+  bool isEnabled() const { return m_enabled; }
+
+  // Discard the samples collected so far and the frames still in flight,
+  // e.g. after warmup. Scope names are kept.
+  void reset();
+
+  // Statistics of every scope seen so far, in first-use order
+  std::vector<GpuTimerStats> getStats() const;
+
+  // Frames whose results were still unavailable when their slot was reused
+  uint64_t getDroppedFrames() const { return m_droppedFrames; }
+
+private:
+  struct Timer {
+    uint32_t scope;
+    uint32_t beginQuery;
+    uint32_t endQuery;
+  };
+
+  struct Frame {
+    std::vector<std::unique_ptr<Query>> queries;
+    uint32_t queryCount = 0;
+    std::vector<Timer> timers;
+    bool pending = false;
+  };
+
+  struct Scope {
+    std::string name;
+    std::array<double, SampleHistory> samples{};
+    uint64_t sampleCount = 0;
+  };
+
+  uint32_t getScopeIndex(std::string_view name);
+  Query& acquireQuery(Frame& frame);
+
+  // Read the results of a frame if all of them are available
+  bool resolve(Frame& frame);
+
+private:
+  bool m_enabled = true;
+
+  std::array<Frame, FrameLatency> m_frames;
+  uint64_t m_frameIndex = 0;
+  uint64_t m_droppedFrames = 0;
+
+  // Indices into the current frame's timers of the open scopes
+  std::vector<uint32_t> m_openTimers;
+
+  std::vector<Scope> m_scopes;
+  std::unordered_map<std::string, uint32_t> m_scopeIndices;
+};
+
+} // namespace paimon
@@ -1,21 +1,184 @@
 #include "paimon/rendering/graphics_pipeline.h"
 
+#include <unordered_set>
+#include <vector>
+
+#include "paimon/core/hash.h"
 #include "paimon/core/log_system.h"
 #include "paimon/opengl/program_pipeline.h"
 
 using namespace paimon;
 
+namespace {
+
+// Live pipelines, searched when a shader program is reloaded
+std::unordered_set<GraphicsPipeline *> s_pipelines;
+
+std::size_t createHash(const ColorBlendState &state) {
+  std::size_t hash = 0;
+  hashCombine(hash, state.logicOpEnable, state.logicOp, state.blendConstants[0],
+              state.blendConstants[1], state.blendConstants[2],
+              state.blendConstants[3]);
+  for (const auto &attachment : state.attachments) {
+    hashCombine(hash, attachment.blendEnable, attachment.srcColorBlendFactor,
+                attachment.dstColorBlendFactor, attachment.colorBlendOp,
+                attachment.srcAlphaBlendFactor, attachment.dstAlphaBlendFactor,
+                attachment.alphaBlendOp, attachment.colorWriteMask[0],
+                attachment.colorWriteMask[1], attachment.colorWriteMask[2],
+                attachment.colorWriteMask[3]);
+  }
+  return hash;
+}
+
+void hashStencil(std::size_t &hash,
+                 const DepthStencilState::StencilOpState &state) {
+  hashCombine(hash, state.failOp, state.passOp, state.depthFailOp,
+              state.compareOp, state.compareMask, state.writeMask,
+              state.reference);
+}
+
+std::size_t createHash(const DepthStencilState &state) {
+  std::size_t hash = 0;
+  hashCombine(hash, state.depthTestEnable, state.depthWriteEnable,
+              state.depthCompareOp, state.depthBoundsTestEnable,
+              state.minDepthBounds, state.maxDepthBounds,
+              state.stencilTestEnable);
+  hashStencil(hash, state.front);
+  hashStencil(hash, state.back);
+  return hash;
+}
+
+std::size_t createHash(const InputAssemblyState &state) {
+  std::size_t hash = 0;
+  hashCombine(hash, state.topology, state.primitiveRestartEnable);
+  return hash;
+}
+
+std::size_t createHash(const MultisampleState &state) {
+  std::size_t hash = 0;
+  hashCombine(hash, state.rasterizationSamples, state.sampleShadingEnable,
+              state.minSampleShading, state.alphaToCoverageEnable,
+              state.alphaToOneEnable);
+  for (auto mask : state.sampleMask) {
+    hashCombine(hash, mask);
+  }
+  return hash;
+}
+
+std::size_t createHash(const RasterizationState &state) {
+  std::size_t hash = 0;
+  hashCombine(hash, state.depthClampEnable, state.rasterizerDiscardEnable,
+              state.polygonMode, state.cullMode, state.frontFace,
+              state.depthBiasEnable, state.depthBiasConstantFactor,
+              state.depthBiasClamp, state.depthBiasSlopeFactor,
+              state.lineWidth, state.pointSize, state.programPointSize);
+  return hash;
+}
+
+std::size_t createHash(const TessellationState &state) {
+  std::size_t hash = 0;
+  hashCombine(hash, state.patchControlPoints);
+  return hash;
+}
+
+std::size_t createHash(const ViewportState &state) {
+  std::size_t hash = 0;
+  for (const auto &viewport : state.viewports) {
+    hashCombine(hash, viewport.x, viewport.y, viewport.width, viewport.height,
+                viewport.minDepth, viewport.maxDepth);
+  }
+  for (const auto &scissor : state.scissors) {
+    hashCombine(hash, scissor.x, scissor.y, scissor.width, scissor.height);
+  }
+  return hash;
+}
+
+// Hash every group, order matches the bit positions of PipelineState::Group
+PipelineStateBlock hashGroups(const PipelineState &state) {
+  PipelineStateBlock block;
+  block.groupHashes = {
+      createHash(state.colorBlend),    createHash(state.depthStencil),
+      createHash(state.inputAssembly), createHash(state.multisample),
+      createHash(state.rasterization), createHash(state.tessellation),
+      createHash(state.viewport),
+  };
+  return block;
+}
+
+} // namespace
+
+PipelineStateBlock PipelineStateBlock::create(const PipelineState &state) {
+  auto block = hashGroups(state);
+
+  // Compared field by field, a hash collision with the default state must
+  // not hide a group
+  static const PipelineState defaultState;
+  for (size_t i = 0; i < PipelineState::GroupCount; ++i) {
+    uint32_t group = 1u << i;
+    if (!state.equals(defaultState, group)) {
+      block.nonDefaultGroups |= group;
+    }
+  }
+
+  return block;
+}
+
+const PipelineStateBlock &PipelineStateBlock::getDefault() {
+  static const PipelineStateBlock block = hashGroups(PipelineState{});
+  return block;
+}
+
 GraphicsPipeline::GraphicsPipeline(const GraphicsPipelineCreateInfo &ci)
     : ProgramPipeline() {
   for (const auto &[stage, shaderProgram] : ci.shaderStages) {
     use_program_stages(stage, *shaderProgram);
+    m_stages.emplace(stage, shaderProgram);
   }
 
-  if (!validate()) {
+  m_validated = validate();
+  if (!m_validated) {
     LOG_ERROR("GraphicsPipeline validation failed!");
   }
 
   m_state = ci.state;
+  m_stateBlock = PipelineStateBlock::create(m_state);
+  m_vertexInputLayout = VertexInputLayout::intern(m_state.vertexInput);
+
+  s_pipelines.insert(this);
+}
+
+GraphicsPipeline::~GraphicsPipeline() { s_pipelines.erase(this); }
+
+bool GraphicsPipeline::replaceProgram(const ShaderProgram &oldProgram,
+                                      const ShaderProgram &newProgram) {
+  std::vector<std::pair<GraphicsPipeline *, GLbitfield>> relinked;
+  bool accepted = true;
+  for (auto *pipeline : s_pipelines) {
+    for (auto &[stage, program] : pipeline->m_stages) {
+      if (program != &oldProgram) {
+        continue;
+      }
+      pipeline->use_program_stages(stage, newProgram);
+      relinked.emplace_back(pipeline, stage);
+    }
+  }
+
+  for (auto &[pipeline, stage] : relinked) {
+    if (pipeline->m_validated && !pipeline->validate()) {
+      LOG_WARN("GraphicsPipeline validation failed with the reloaded program");
+      accepted = false;
+      break;
+    }
+  }
+
+  for (auto &[pipeline, stage] : relinked) {
+    if (accepted) {
+      pipeline->m_stages[stage] = &newProgram;
+    } else {
+      pipeline->use_program_stages(stage, oldProgram);
+    }
+  }
+  return accepted;
 }
 
-const PipelineState &GraphicsPipeline::getState() const { return m_state; }
\ No newline at end of file
+const PipelineState &GraphicsPipeline::getState() const { return m_state; }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <unordered_map>
 
 #include <glad/gl.h>
@@ -7,6 +8,7 @@
 #include "paimon/opengl/state.h"
 #include "paimon/opengl/program_pipeline.h"
 #include "paimon/opengl/shader_program.h"
+#include "paimon/rendering/vertex_input_layout.h"
 
 namespace paimon {
 
@@ -18,13 +20,48 @@ struct GraphicsPipelineCreateInfo {
   PipelineState state;
 };
 
+// Hashes of a PipelineState baked once at pipeline creation, so binding a
+// pipeline rejects changed groups without comparing every field
+struct PipelineStateBlock {
+  // Hash of each state group, indexed by the bit position of the group
+  std::array<std::size_t, PipelineState::GroupCount> groupHashes{};
+
+  // Groups that differ from a default constructed PipelineState
+  uint32_t nonDefaultGroups = 0;
+
+  static PipelineStateBlock create(const PipelineState &state);
+
+  // Block of a default constructed PipelineState
+  static const PipelineStateBlock &getDefault();
+};
+
 class GraphicsPipeline : public ProgramPipeline {
 public:
   GraphicsPipeline(const GraphicsPipelineCreateInfo &ci);
+  ~GraphicsPipeline() override;
 
   const PipelineState& getState() const;
 
+  const PipelineStateBlock& getStateBlock() const { return m_stateBlock; }
+
+  // Resolved once at creation, binding needs no hashing of the vertex input
+  const VertexInputLayout& getVertexInputLayout() const {
+    return *m_vertexInputLayout;
+  }
+
+  // Re-link every pipeline using a program to its replacement, for shader
+  // hot-reload. Pipelines that validated before must validate with the new
+  // program, otherwise all of them keep the old one and false is returned.
+  static bool replaceProgram(const ShaderProgram &oldProgram,
+                             const ShaderProgram &newProgram);
+
 private:
+  // Program of each stage, kept for replaceProgram
+  std::unordered_map<GLbitfield, const ShaderProgram*> m_stages;
+  bool m_validated = false;
+
   PipelineState m_state;
+  PipelineStateBlock m_stateBlock;
+  const VertexInputLayout* m_vertexInputLayout = nullptr;
 };
-} // namespace paimon
\ No newline at end of file
+} // namespace paimon
@@ -0,0 +1,156 @@
+#include "paimon/rendering/material_texture_packer.h"
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <tuple>
+#include <unordered_set>
+#include <vector>
+
+#include <glad/gl.h>
+
+#include "paimon/app/application.h"
+#include "paimon/core/ecs/components.h"
+#include "paimon/core/log_system.h"
+
+namespace paimon {
+
+namespace {
+
+// Material texture slots, in the order of the ColorPass bindings
+std::array<const std::shared_ptr<sg::Texture>*, 5>
+materialTextures(const sg::Material& material) {
+  return {&material.pbrMetallicRoughness.baseColorTexture,
+          &material.pbrMetallicRoughness.metallicRoughnessTexture,
+          &material.normalTexture, &material.emissiveTexture,
+          &material.occlusionTexture};
+}
+
+// Textures can share an array when all their levels have the same extent
+struct GroupKey {
+  GLint width = 0;
+  GLint height = 0;
+  GLint levels = 0;
+  GLint internalFormat = 0;
+
+  bool operator<(const GroupKey& other) const {
+    return std::tie(width, height, levels, internalFormat) <
+           std::tie(other.width, other.height, other.levels,
+                    other.internalFormat);
+  }
+};
+
+} // namespace
+
+MaterialTexturePacker::MaterialTexturePacker(DeletionQueue& deletionQueue)
+    : m_deletionQueue(deletionQueue) {
+  // Drop layers whose source texture is gone, a recycled GL name must not
+  // resolve to a stale layer. The array is not destroyed from inside the
+  // callback, in-flight frames may still sample it.
+  m_destroyCallbackId =
+      Texture::add_destroy_callback([this](const Texture& texture) {
+        auto it = m_entries.find(texture.get_generation());
+        if (it == m_entries.end()) {
+          return;
+        }
+        m_deletionQueue.retire(std::move(it->second.array));
+        m_entries.erase(it);
+      });
+}
+
+MaterialTexturePacker::~MaterialTexturePacker() {
+  Texture::remove_destroy_callback(m_destroyCallbackId);
+}
+
+size_t MaterialTexturePacker::pack(ecs::Scene& scene) {
+  auto& fallback = Application::getInstance()
+                       .getTextureUploadQueue()
+                       .getFallbackTexture();
+
+  // Collect unpacked, resident textures grouped by layout
+  std::map<GroupKey, std::vector<std::shared_ptr<Texture>>> groups;
+  std::unordered_set<uint64_t> seen;
+  auto view = scene.view<ecs::Material>();
+  for (auto [entity, materialComp] : view.each()) {
+    if (!materialComp.material) {
+      continue;
+    }
+    for (auto* slot : materialTextures(*materialComp.material)) {
+      const auto& texture = *slot;
+      if (!texture || !texture->image || texture->image == fallback ||
+          texture->image->get_target() != GL_TEXTURE_2D) {
+        continue;
+      }
+      auto& image = texture->image;
+      auto generation = image->get_generation();
+      if (m_entries.contains(generation) || !seen.insert(generation).second) {
+        continue;
+      }
+
+      GroupKey key;
+      key.width = image->get<GLint>(0, GL_TEXTURE_WIDTH);
+      key.height = image->get<GLint>(0, GL_TEXTURE_HEIGHT);
+      key.internalFormat = image->get<GLint>(0, GL_TEXTURE_INTERNAL_FORMAT);
+      key.levels = image->get<GLint>(GL_TEXTURE_IMMUTABLE_LEVELS);
+      if (key.levels == 0) {
+        LOG_WARN("MaterialTexturePacker: skipping mutable texture {}",
+                 image->get_name());
+        continue;
+      }
+      groups[key].push_back(image);
+    }
+  }
+
+  GLint maxArrayLayers = 0;
+  glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &maxArrayLayers);
+  auto maxLayers = static_cast<size_t>(maxArrayLayers);
+
+  size_t packed = 0;
+  for (const auto& [key, textures] : groups) {
+    for (size_t first = 0; first < textures.size(); first += maxLayers) {
+      auto layers = std::min(textures.size() - first, maxLayers);
+
+      auto array = std::make_shared<Texture>(GL_TEXTURE_2D_ARRAY);
+      array->set_storage_3d(key.levels, static_cast<GLenum>(key.internalFormat),
+                            key.width, key.height,
+                            static_cast<GLsizei>(layers));
+
+      for (size_t layer = 0; layer < layers; ++layer) {
+        const auto& source = textures[first + layer];
+        for (GLint level = 0; level < key.levels; ++level) {
+          glCopyImageSubData(source->get_name(), GL_TEXTURE_2D, level, 0, 0,
+                             0, array->get_name(), GL_TEXTURE_2D_ARRAY, level,
+                             0, 0, static_cast<GLint>(layer),
+                             std::max(key.width >> level, 1),
+                             std::max(key.height >> level, 1), 1);
+        }
+        m_entries[source->get_generation()] = {array,
+                                               static_cast<int>(layer)};
+      }
+
+      packed += layers;
+      LOG_INFO("MaterialTexturePacker: packed {} textures of {}x{} into an "
+               "array",
+               layers, key.width, key.height);
+    }
+  }
+
+  return packed;
+}
+
+const PackedTexture*
+MaterialTexturePacker::find(const sg::Texture& texture) const {
+  if (!texture.image) {
+    return nullptr;
+  }
+  auto it = m_entries.find(texture.image->get_generation());
+  return it != m_entries.end() ? &it->second : nullptr;
+}
+
+bool MaterialTexturePacker::isPacked(const sg::Material& material) const {
+  return std::ranges::all_of(materialTextures(material), [&](auto* slot) {
+    return !*slot || !(*slot)->image || find(**slot);
+  });
+}
+
+} // namespace paimon
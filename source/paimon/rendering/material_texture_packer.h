@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+#include "paimon/core/ecs/scene.h"
+#include "paimon/core/sg/material.h"
+#include "paimon/opengl/texture.h"
+#include "paimon/rendering/deletion_queue.h"
+
+namespace paimon {
+
+// Layer of a GL_TEXTURE_2D_ARRAY holding a copy of a material texture
+struct PackedTexture {
+  std::shared_ptr<Texture> array;
+  int layer = -1;
+};
+
+// MaterialTexturePacker copies material textures with the same size, format
+// and mip count into the layers of shared texture arrays, so materials of the
+// same class bind one array per slot instead of their own 2D textures.
+class MaterialTexturePacker {
+public:
+  // Arrays of destroyed source textures are retired to the deletion queue
+  explicit MaterialTexturePacker(DeletionQueue& deletionQueue);
+  ~MaterialTexturePacker();
+
+  // Delete copy constructor and assignment
+  MaterialTexturePacker(const MaterialTexturePacker&) = delete;
+  MaterialTexturePacker& operator=(const MaterialTexturePacker&) = delete;
+
+  // Pack every resident texture of the scene materials that is not packed
+  // yet, textures still showing the upload fallback are skipped. Returns the
+  // number of textures packed.
+  size_t pack(ecs::Scene& scene);
+
+  // Array layer of a texture, nullptr when it is not packed
+  const PackedTexture* find(const sg::Texture& texture) const;
+
+  // True when every texture of the material can be sampled from arrays
+  bool isPacked(const sg::Material& material) const;
+
+  void clear() { m_entries.clear(); }
+
+  size_t getPackedCount() const { return m_entries.size(); }
+
+private:
+  // Packed textures keyed by source texture generation, dropped when the
+  // source texture is destroyed
+  std::unordered_map<uint64_t, PackedTexture> m_entries;
+  DeletionQueue& m_deletionQueue;
+  size_t m_destroyCallbackId = 0;
+};
+
+} // namespace paimon
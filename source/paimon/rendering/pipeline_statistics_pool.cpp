@@ -0,0 +1,160 @@
+#include "paimon/rendering/pipeline_statistics_pool.h"
+
+#include "paimon/core/log_system.h"
+
+namespace paimon {
+
+void PipelineStatisticsPool::beginFrame() {
+  if (!m_scopeStack.empty()) {
+    LOG_WARN("PipelineStatisticsPool: {} scopes still open at frame boundary",
+             m_scopeStack.size());
+    if (m_segmentActive) {
+      endSegment();
+    }
+    m_scopeStack.clear();
+  }
+
+  auto& current = m_frames[m_frameIndex % FrameLatency];
+  if (!current.segments.empty()) {
+    current.pending = true;
+  }
+
+  for (uint32_t i = 1; i <= FrameLatency; ++i) {
+    auto& frame = m_frames[(m_frameIndex + i) % FrameLatency];
+    if (frame.pending && !resolve(frame)) {
+      break;
+    }
+  }
+
+  ++m_frameIndex;
+
+  auto& next = m_frames[m_frameIndex % FrameLatency];
+  if (next.pending) {
+    LOG_DEBUG("PipelineStatisticsPool: dropped counters of frame {}",
+              m_frameIndex - FrameLatency);
+  }
+  next.pending = false;
+  next.queryCount = 0;
+  next.segments.clear();
+
+  m_enabled = m_requestedEnabled;
+}
+
+void PipelineStatisticsPool::beginScope(std::string_view name) {
+  if (!m_enabled) {
+    return;
+  }
+
+  // The parent is suspended while the nested scope runs
+  if (m_segmentActive) {
+    endSegment();
+  }
+
+  auto scope = getScopeIndex(name);
+  m_scopeStack.push_back(scope);
+  beginSegment(scope);
+}
+
+void PipelineStatisticsPool::endScope() {
+  if (!m_enabled) {
+    return;
+  }
+  if (m_scopeStack.empty()) {
+    LOG_ERROR("PipelineStatisticsPool: endScope without matching beginScope");
+    return;
+  }
+
+  endSegment();
+  m_scopeStack.pop_back();
+
+  if (!m_scopeStack.empty()) {
+    beginSegment(m_scopeStack.back());
+  }
+}
+
+std::vector<PipelineStatistics> PipelineStatisticsPool::getStats() const {
+  std::vector<PipelineStatistics> result;
+  result.reserve(m_scopes.size());
+
+  for (const auto& scope : m_scopes) {
+    result.push_back({
+        .name = scope.name,
+        .frameCount = scope.frameCount,
+        .verticesSubmitted = scope.last[0],
+        .primitivesSubmitted = scope.last[1],
+        .clippingOutputPrimitives = scope.last[2],
+        .fragmentShaderInvocations = scope.last[3],
+        .computeShaderInvocations = scope.last[4],
+    });
+  }
+  return result;
+}
+
+uint32_t PipelineStatisticsPool::getScopeIndex(std::string_view name) {
+  auto it = m_scopeIndices.find(std::string(name));
+  if (it != m_scopeIndices.end()) {
+    return it->second;
+  }
+
+  auto index = static_cast<uint32_t>(m_scopes.size());
+  m_scopes.push_back({.name = std::string(name)});
+  m_scopeIndices.emplace(std::string(name), index);
+  return index;
+}
+
+void PipelineStatisticsPool::beginSegment(uint32_t scope) {
+  auto& frame = m_frames[m_frameIndex % FrameLatency];
+  frame.segments.push_back({scope, frame.queryCount});
+
+  for (auto target : Targets) {
+    if (frame.queryCount == frame.queries.size()) {
+      frame.queries.push_back(std::make_unique<Query>(target));
+    }
+    frame.queries[frame.queryCount++]->begin();
+  }
+  m_segmentActive = true;
+}
+
+void PipelineStatisticsPool::endSegment() {
+  auto& frame = m_frames[m_frameIndex % FrameLatency];
+  auto firstQuery = frame.segments.back().firstQuery;
+  for (size_t i = 0; i < Targets.size(); ++i) {
+    frame.queries[firstQuery + i]->end();
+  }
+  m_segmentActive = false;
+}
+
+bool PipelineStatisticsPool::resolve(Frame& frame) {
+  for (auto it = frame.segments.rbegin(); it != frame.segments.rend(); ++it) {
+    for (size_t i = 0; i < Targets.size(); ++i) {
+      auto& query = *frame.queries[it->firstQuery + i];
+      if (query.get<GLuint>(GL_QUERY_RESULT_AVAILABLE) == GL_FALSE) {
+        return false;
+      }
+    }
+  }
+
+  // Sum the segments of each scope seen in this frame
+  std::vector<Counters> totals(m_scopes.size());
+  std::vector<bool> seen(m_scopes.size(), false);
+  for (const auto& segment : frame.segments) {
+    seen[segment.scope] = true;
+    for (size_t i = 0; i < Targets.size(); ++i) {
+      totals[segment.scope][i] +=
+          frame.queries[segment.firstQuery + i]->get<GLuint64>(
+              GL_QUERY_RESULT);
+    }
+  }
+
+  for (size_t i = 0; i < m_scopes.size(); ++i) {
+    if (seen[i]) {
+      m_scopes[i].last = totals[i];
+      ++m_scopes[i].frameCount;
+    }
+  }
+
+  frame.pending = false;
+  return true;
+}
+
+} // namespace paimon
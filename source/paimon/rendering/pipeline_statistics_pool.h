@@ -0,0 +1,105 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <glad/gl.h>
+
+#include "paimon/opengl/query.h"
+
+namespace paimon {
+
+// Pipeline statistics counters of one named scope over the last resolved frame
+struct PipelineStatistics {
+  std::string name;
+  uint64_t frameCount = 0; // frames in which the scope was resolved
+  uint64_t verticesSubmitted = 0;
+  uint64_t primitivesSubmitted = 0;
+  uint64_t clippingOutputPrimitives = 0;
+  uint64_t fragmentShaderInvocations = 0;
+  uint64_t computeShaderInvocations = 0;
+};
+
+// PipelineStatisticsPool collects GL_ARB_pipeline_statistics_query counters per
+// named scope with pooled queries, read back frames later like GpuTimerPool.
+// Only one query per target may be active, so counts are exclusive: a nested
+// scope suspends its parent's queries and the parent resumes afterwards.
+class PipelineStatisticsPool {
+public:
+  static constexpr uint32_t FrameLatency = 4;
+
+  static constexpr std::array<GLenum, 5> Targets = {
+      GL_VERTICES_SUBMITTED, GL_PRIMITIVES_SUBMITTED,
+      GL_CLIPPING_OUTPUT_PRIMITIVES, GL_FRAGMENT_SHADER_INVOCATIONS,
+      GL_COMPUTE_SHADER_INVOCATIONS};
+
+  PipelineStatisticsPool() = default;
+  ~PipelineStatisticsPool() = default;
+
+  // Delete copy constructor and assignment
+  PipelineStatisticsPool(const PipelineStatisticsPool&) = delete;
+  PipelineStatisticsPool& operator=(const PipelineStatisticsPool&) = delete;
+
+  // Resolve finished frames and start recording a new one
+  void beginFrame();
+
+  void beginScope(std::string_view name);
+  void endScope();
+
+  // Disabled by default, the counters cost a little on some drivers
+  void setEnabled(bool enabled) { m_requestedEnabled = enabled; }
+  bool isEnabled() const { return m_requestedEnabled; }
+
+  // Counters of every scope seen so far, in first-use order
+  std::vector<PipelineStatistics> getStats() const;
+
+private:
+  using Counters = std::array<uint64_t, Targets.size()>;
+
+  // One begin/end of all targets attributed to a scope
+  struct Segment {
+    uint32_t scope;
+    uint32_t firstQuery;
+  };
+
+  struct Frame {
+    std::vector<std::unique_ptr<Query>> queries;
+    uint32_t queryCount = 0;
+    std::vector<Segment> segments;
+    bool pending = false;
+  };
+
+  struct Scope {
+    std::string name;
+    Counters last{};
+    uint64_t frameCount = 0;
+  };
+
+  uint32_t getScopeIndex(std::string_view name);
+
+  void beginSegment(uint32_t scope);
+  void endSegment();
+
+  bool resolve(Frame& frame);
+
+private:
+  bool m_requestedEnabled = false;
+  bool m_enabled = false; // latched at frame boundaries
+
+  std::array<Frame, FrameLatency> m_frames;
+  uint64_t m_frameIndex = 0;
+
+  // Scope indices of the open scopes, innermost last
+  std::vector<uint32_t> m_scopeStack;
+  bool m_segmentActive = false;
+
+  std::vector<Scope> m_scopes;
+  std::unordered_map<std::string, uint32_t> m_scopeIndices;
+};
+
+} // namespace paimon
@@ -0,0 +1,61 @@
+#include "paimon/rendering/profile_report.h"
+
+#include <fstream>
+
+#include <nlohmann/json.hpp>
+
+#include "paimon/core/log_system.h"
+#include "paimon/rendering/render_context.h"
+
+namespace paimon {
+
+std::string dumpProfileReport(const RenderContext &ctx) {
+  const auto &timerPool = ctx.getGpuTimerPool();
+
+  nlohmann::json timers = nlohmann::json::array();
+  for (const auto &stats : timerPool.getStats()) {
+    timers.push_back({
+        {"name", stats.name},
+        {"samples", stats.sampleCount},
+        {"last_ms", stats.lastMs},
+        {"min_ms", stats.minMs},
+        {"avg_ms", stats.avgMs},
+        {"p99_ms", stats.p99Ms},
+    });
+  }
+
+  nlohmann::json statistics = nlohmann::json::array();
+  for (const auto &stats : ctx.getPipelineStatisticsPool().getStats()) {
+    statistics.push_back({
+        {"name", stats.name},
+        {"frames", stats.frameCount},
+        {"vertices_submitted", stats.verticesSubmitted},
+        {"primitives_submitted", stats.primitivesSubmitted},
+        {"clipping_output_primitives", stats.clippingOutputPrimitives},
+        {"fragment_shader_invocations", stats.fragmentShaderInvocations},
+        {"compute_shader_invocations", stats.computeShaderInvocations},
+    });
+  }
+
+  nlohmann::json report = {
+      {"gpu_timers", std::move(timers)},
+      {"dropped_timer_frames", timerPool.getDroppedFrames()},
+      {"pipeline_statistics", std::move(statistics)},
+  };
+  return report.dump(2);
+}
+
+bool writeProfileReport(const RenderContext &ctx,
+                        const std::filesystem::path &filepath) {
+  std::ofstream file(filepath);
+  if (!file) {
+    LOG_ERROR("Failed to open profile report file: {}", filepath.string());
+    return false;
+  }
+
+  file << dumpProfileReport(ctx) << '\n';
+  LOG_INFO("Wrote profile report to {}", filepath.string());
+  return true;
+}
+
+} // namespace paimon
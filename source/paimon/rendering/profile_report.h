@@ -0,0 +1,18 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+
+namespace paimon {
+
+class RenderContext;
+
+// Machine-readable snapshot of the GPU timers and pipeline statistics of a
+// render context, as an indented JSON document
+std::string dumpProfileReport(const RenderContext &ctx);
+
+// Write the report to a file, returns false on failure
+bool writeProfileReport(const RenderContext &ctx,
+                        const std::filesystem::path &filepath);
+
+} // namespace paimon
@@ -0,0 +1,282 @@
+#include "paimon/rendering/program_binary_cache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "paimon/core/hash.h"
+#include "paimon/core/log_system.h"
+
+namespace paimon {
+
+namespace {
+
+constexpr uint32_t FileMagic = 0x42504d50; // "PMPB"
+constexpr uint32_t FileVersion = 2;
+
+// Temporary files of interrupted stores older than this are removed
+constexpr auto StaleTemporaryAge = std::chrono::minutes(10);
+
+struct FileHeader {
+  uint32_t magic = FileMagic;
+  uint32_t version = FileVersion;
+  uint64_t key = 0;
+  uint64_t sourceHash = 0;
+  uint64_t sourceLength = 0;
+  uint32_t format = 0;
+  uint32_t length = 0;
+  uint64_t checksum = 0; // of the binary
+};
+
+std::string_view asString(const std::vector<uint8_t> &data) {
+  return {reinterpret_cast<const char *>(data.data()), data.size()};
+}
+
+std::string_view getString(GLenum name) {
+  const auto *value = reinterpret_cast<const char *>(glGetString(name));
+  return value ? value : "";
+}
+
+} // namespace
+
+ProgramBinaryCache::ProgramBinaryCache(std::filesystem::path directory,
+                                       uintmax_t maxSize)
+    : m_directory(std::move(directory)), m_maxSize(maxSize) {}
+
+bool ProgramBinaryCache::isSupported() {
+  if (!m_initialized) {
+    initialize();
+  }
+  return m_supported;
+}
+
+ProgramBinaryKey ProgramBinaryCache::createKey(GLenum type,
+                                               std::string_view source) {
+  if (!m_initialized) {
+    initialize();
+  }
+  auto seed = hashFnv1a(std::format("{}:{}:", FileVersion, type), m_driverHash);
+
+  ProgramBinaryKey key;
+  key.hash = hashFnv1a(source, seed);
+  // Seeded differently, so it does not collide together with the file key
+  key.sourceHash = hashFnv1a(source, ~seed);
+  key.sourceLength = source.size();
+  return key;
+}
+
+std::unique_ptr<ShaderProgram>
+ProgramBinaryCache::load(const ProgramBinaryKey &key) {
+  if (!isSupported()) {
+    return nullptr;
+  }
+
+  auto path = getPath(key.hash);
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    ++m_stats.misses;
+    return nullptr;
+  }
+
+  // Anything unexpected counts as corrupted, the entry is rebuilt from
+  // source and overwritten
+  auto reject = [&](const char *reason) -> std::unique_ptr<ShaderProgram> {
+    LOG_WARN("ProgramBinaryCache: discarding {} ({})", path.string(), reason);
+    file.close();
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+    ++m_stats.rejected;
+    return nullptr;
+  };
+
+  FileHeader header;
+  if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+      header.magic != FileMagic || header.version != FileVersion ||
+      header.key != key.hash) {
+    return reject("bad header");
+  }
+  if (header.sourceHash != key.sourceHash ||
+      header.sourceLength != key.sourceLength) {
+    return reject("key collision");
+  }
+
+  // The length is checked before allocating, a damaged header must not
+  // request an arbitrary amount of memory
+  std::error_code sizeError;
+  auto fileSize = std::filesystem::file_size(path, sizeError);
+  if (sizeError || header.length == 0 || header.length > MaxBinaryLength ||
+      fileSize != sizeof(header) + header.length) {
+    return reject("bad length");
+  }
+
+  std::vector<uint8_t> binary(header.length);
+  if (!file.read(reinterpret_cast<char *>(binary.data()), header.length) ||
+      hashFnv1a(asString(binary)) != header.checksum) {
+    return reject("bad checksum");
+  }
+
+  auto program = std::make_unique<ShaderProgram>(
+      header.format, binary.data(), static_cast<GLsizei>(binary.size()));
+  if (!program->is_linked()) {
+    return reject("rejected by the driver");
+  }
+
+  // Refresh the timestamp, eviction drops the oldest entries first
+  std::error_code ec;
+  std::filesystem::last_write_time(
+      path, std::filesystem::file_time_type::clock::now(), ec);
+
+  ++m_stats.hits;
+  return program;
+}
+
+void ProgramBinaryCache::store(const ProgramBinaryKey &key,
+                               const ShaderProgram &program) {
+  if (!isSupported()) {
+    return;
+  }
+
+  GLenum format = 0;
+  auto binary = program.get_binary(format);
+  if (binary.empty()) {
+    LOG_WARN("ProgramBinaryCache: driver returned no binary for program {}",
+             program.get_name());
+    return;
+  }
+  if (binary.size() > MaxBinaryLength) {
+    LOG_WARN("ProgramBinaryCache: binary of program {} is too large ({} KB)",
+             program.get_name(), binary.size() / 1024);
+    return;
+  }
+
+  FileHeader header;
+  header.key = key.hash;
+  header.sourceHash = key.sourceHash;
+  header.sourceLength = key.sourceLength;
+  header.format = format;
+  header.length = static_cast<uint32_t>(binary.size());
+  header.checksum = hashFnv1a(asString(binary));
+
+  // Write to a unique temporary file and rename it into place, so readers in
+  // other processes never see a partial entry
+  auto path = getPath(key.hash);
+  auto temporary = path;
+  temporary += std::format(".{:08x}.tmp", std::random_device{}());
+  {
+    std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(binary.data()),
+               static_cast<std::streamsize>(binary.size()));
+    if (!file) {
+      LOG_WARN("ProgramBinaryCache: failed to write {}", temporary.string());
+      file.close();
+      std::error_code ec;
+      std::filesystem::remove(temporary, ec);
+      return;
+    }
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(temporary, path, ec);
+  if (ec) {
+    LOG_WARN("ProgramBinaryCache: failed to move {} into place: {}",
+             temporary.string(), ec.message());
+    std::filesystem::remove(temporary, ec);
+    return;
+  }
+
+  ++m_stats.stores;
+  m_size += sizeof(header) + binary.size();
+  if (m_size > m_maxSize) {
+    evict();
+  }
+}
+
+void ProgramBinaryCache::initialize() {
+  m_initialized = true;
+
+  GLint formats = 0;
+  glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+  if (formats == 0) {
+    LOG_INFO("ProgramBinaryCache: driver supports no program binary formats");
+    return;
+  }
+
+  std::error_code ec;
+  std::filesystem::create_directories(m_directory, ec);
+  if (ec) {
+    LOG_WARN("ProgramBinaryCache: cannot create {}: {}", m_directory.string(),
+             ec.message());
+    return;
+  }
+
+  // Binaries are only valid for the exact driver build that produced them
+  m_driverHash = hashFnv1a(getString(GL_VENDOR));
+  m_driverHash = hashFnv1a(getString(GL_RENDERER), m_driverHash);
+  m_driverHash = hashFnv1a(getString(GL_VERSION), m_driverHash);
+  m_driverHash =
+      hashFnv1a(getString(GL_SHADING_LANGUAGE_VERSION), m_driverHash);
+
+  m_supported = true;
+  evict();
+
+  LOG_INFO("ProgramBinaryCache: using {} ({} KB)", m_directory.string(),
+           m_size / 1024);
+}
+
+std::filesystem::path ProgramBinaryCache::getPath(uint64_t key) const {
+  return m_directory / std::format("{:016x}.bin", key);
+}
+
+void ProgramBinaryCache::evict() {
+  struct Entry {
+    std::filesystem::file_time_type time;
+    uintmax_t size;
+    std::filesystem::path path;
+  };
+
+  // Rescan, other processes may share the directory
+  std::error_code ec;
+  std::vector<Entry> entries;
+  auto staleTime =
+      std::filesystem::file_time_type::clock::now() - StaleTemporaryAge;
+  m_size = 0;
+  for (const auto &entry :
+       std::filesystem::directory_iterator(m_directory, ec)) {
+    if (!entry.is_regular_file(ec)) {
+      continue;
+    }
+    // Left behind by interrupted stores, recent ones may still be written
+    if (entry.path().extension() == ".tmp") {
+      if (entry.last_write_time(ec) < staleTime) {
+        std::filesystem::remove(entry.path(), ec);
+      }
+      continue;
+    }
+    if (entry.path().extension() != ".bin") {
+      continue;
+    }
+    entries.push_back(
+        {entry.last_write_time(ec), entry.file_size(ec), entry.path()});
+    m_size += entries.back().size;
+  }
+
+  std::sort(entries.begin(), entries.end(),
+            [](const Entry &a, const Entry &b) { return a.time < b.time; });
+
+  for (const auto &entry : entries) {
+    if (m_size <= m_maxSize) {
+      break;
+    }
+    if (std::filesystem::remove(entry.path, ec)) {
+      m_size -= entry.size;
+      ++m_stats.evictions;
+    }
+  }
+}
+
+} // namespace paimon
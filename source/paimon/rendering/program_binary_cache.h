@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string_view>
+
+#include <glad/gl.h>
+
+#include "paimon/opengl/shader_program.h"
+
+namespace paimon {
+
+// Identifies a cached program, the source hash and length are stored next to
+// the binary so a collision of the file key never loads another program
+struct ProgramBinaryKey {
+  uint64_t hash = 0;
+  uint64_t sourceHash = 0;
+  uint64_t sourceLength = 0;
+};
+
+struct ProgramBinaryCacheStats {
+  size_t hits = 0;
+  size_t misses = 0;
+  size_t rejected = 0;  // corrupted files or binaries the driver refused
+  size_t stores = 0;
+  size_t evictions = 0;
+};
+
+// ProgramBinaryCache persists linked programs with glGetProgramBinary so warm
+// starts skip compilation. Entries are keyed by the final program source and
+// the driver that built them, written atomically and evicted least recently
+// used first once the directory grows past its size limit.
+class ProgramBinaryCache {
+public:
+  static constexpr uintmax_t DefaultMaxSize = 64u << 20;
+  // Larger binaries are treated as corrupted headers
+  static constexpr uint32_t MaxBinaryLength = 16u << 20;
+
+  explicit ProgramBinaryCache(std::filesystem::path directory,
+                              uintmax_t maxSize = DefaultMaxSize);
+  ~ProgramBinaryCache() = default;
+
+  // Delete copy constructor and assignment
+  ProgramBinaryCache(const ProgramBinaryCache &) = delete;
+  ProgramBinaryCache &operator=(const ProgramBinaryCache &) = delete;
+
+  // False when the driver exposes no binary formats, load and store are then
+  // no-ops
+  bool isSupported();
+
+  // Key of a program, covers the stage, the source with its defines expanded
+  // and the vendor, renderer and version strings of the driver
+  ProgramBinaryKey createKey(GLenum type, std::string_view source);
+
+  // Returns nullptr on a miss, files that are corrupted or rejected by the
+  // driver are removed so the caller recompiles and stores a fresh one
+  std::unique_ptr<ShaderProgram> load(const ProgramBinaryKey &key);
+
+  void store(const ProgramBinaryKey &key, const ShaderProgram &program);
+
+  const ProgramBinaryCacheStats &getStats() const { return m_stats; }
+
+private:
+  void initialize();
+
+  std::filesystem::path getPath(uint64_t key) const;
+
+  // Rescan the directory, drop stale temporary files and remove the least
+  // recently used entries until the directory fits
+  void evict();
+
+private:
+  std::filesystem::path m_directory;
+  uintmax_t m_maxSize = DefaultMaxSize;
+  uintmax_t m_size = 0;
+
+  bool m_initialized = false;
+  bool m_supported = false;
+  uint64_t m_driverHash = 0;
+
+  ProgramBinaryCacheStats m_stats;
+};
+
+} // namespace paimon
@@ -0,0 +1,268 @@
+#include "paimon/rendering/readback_queue.h"
+
+#include "paimon/core/log_system.h"
+
+namespace paimon {
+
+namespace {
+// Pixel pack offsets are kept aligned for every format
+constexpr size_t ringAlignment = 256;
+
+size_t alignUp(size_t value, size_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+size_t getComponentCount(GLenum format) {
+  switch (format) {
+  case GL_RED:
+  case GL_GREEN:
+  case GL_BLUE:
+  case GL_DEPTH_COMPONENT:
+  case GL_STENCIL_INDEX:
+  case GL_RED_INTEGER:
+    return 1;
+  case GL_RG:
+  case GL_RG_INTEGER:
+    return 2;
+  case GL_RGB:
+  case GL_BGR:
+  case GL_RGB_INTEGER:
+    return 3;
+  case GL_RGBA:
+  case GL_BGRA:
+  case GL_RGBA_INTEGER:
+    return 4;
+  default:
+    return 0;
+  }
+}
+
+size_t getTypeSize(GLenum type) {
+  switch (type) {
+  case GL_UNSIGNED_BYTE:
+  case GL_BYTE:
+    return 1;
+  case GL_UNSIGNED_SHORT:
+  case GL_SHORT:
+  case GL_HALF_FLOAT:
+    return 2;
+  case GL_UNSIGNED_INT:
+  case GL_INT:
+  case GL_FLOAT:
+    return 4;
+  default:
+    return 0;
+  }
+}
+} // namespace
+
+ReadbackQueue::~ReadbackQueue() {
+  // Deliver what is still queued before the worker goes away
+  flush();
+
+  {
+    std::lock_guard lock(m_mutex);
+    m_stop = true;
+  }
+  m_condition.notify_all();
+  if (m_worker.joinable()) {
+    m_worker.join();
+  }
+}
+
+size_t ReadbackQueue::getRequestSize(const ReadbackRequest &request) {
+  return static_cast<size_t>(request.width) * request.height * request.depth *
+         getComponentCount(request.format) * getTypeSize(request.type);
+}
+
+bool ReadbackQueue::enqueue(const ReadbackRequest &request,
+                            Callback callback) {
+  auto size = getRequestSize(request);
+  if (!request.texture || size == 0) {
+    LOG_ERROR("ReadbackQueue: invalid request for {}x{}x{} format 0x{:X} "
+              "type 0x{:X}",
+              request.width, request.height, request.depth, request.format,
+              request.type);
+    return false;
+  }
+
+  if (!m_initialized) {
+    initialize();
+  }
+
+  auto job = std::make_unique<Job>();
+  job->callback = std::move(callback);
+  job->dataSize = size;
+  job->size = alignUp(size, ringAlignment);
+
+  const Buffer *target = nullptr;
+  size_t offset = 0;
+  if (job->size > m_ring.getCapacity()) {
+    // Too large for the ring, read into a buffer of its own
+    constexpr GLbitfield flags =
+        GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    job->dedicated = std::make_unique<Buffer>();
+    job->dedicated->set_storage(static_cast<GLsizeiptr>(size), nullptr, flags);
+    job->data = static_cast<const uint8_t *>(
+        job->dedicated->map_range(0, static_cast<GLsizeiptr>(size), flags));
+    if (!job->data) {
+      LOG_ERROR("ReadbackQueue: failed to map a {} byte readback buffer",
+                size);
+      return false;
+    }
+    target = job->dedicated.get();
+  } else {
+    auto allocation = m_ring.allocate(job->size);
+    while (!allocation) {
+      // Wait for the oldest readbacks to be delivered
+      retire(true);
+      {
+        std::unique_lock lock(m_mutex);
+        m_doneCondition.wait(lock, [this] { return !m_done.empty(); });
+      }
+      recycle();
+      allocation = m_ring.allocate(job->size);
+    }
+    job->ringAllocation = allocation;
+    job->data = m_ringData + allocation->offset;
+    target = m_ringBuffer.get();
+    offset = allocation->offset;
+  }
+
+  target->bind(GL_PIXEL_PACK_BUFFER);
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+  glGetTextureSubImage(request.texture->get_name(), request.level, request.x,
+                       request.y, request.z, request.width, request.height,
+                       request.depth, request.format, request.type,
+                       static_cast<GLsizei>(size),
+                       reinterpret_cast<void *>(static_cast<uintptr_t>(offset)));
+  glPixelStorei(GL_PACK_ALIGNMENT, 4);
+  Buffer::unbind(GL_PIXEL_PACK_BUFFER);
+
+  job->fence = std::make_unique<SyncObject>();
+  m_inFlight.push_back(std::move(job));
+  return true;
+}
+
+void ReadbackQueue::update() {
+  if (!m_initialized) {
+    return;
+  }
+  recycle();
+  retire(false);
+}
+
+void ReadbackQueue::flush() {
+  if (!m_initialized) {
+    return;
+  }
+
+  while (!m_inFlight.empty()) {
+    retire(true);
+  }
+
+  {
+    std::unique_lock lock(m_mutex);
+    m_doneCondition.wait(lock, [this] { return m_ready.empty() && !m_busy; });
+  }
+  recycle();
+}
+
+size_t ReadbackQueue::getPendingCount() const {
+  std::lock_guard lock(m_mutex);
+  return m_inFlight.size() + m_ready.size() + (m_busy ? 1 : 0);
+}
+
+void ReadbackQueue::initialize() {
+  constexpr GLbitfield flags =
+      GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+  m_ringBuffer = std::make_unique<Buffer>();
+  auto ringSize = static_cast<GLsizeiptr>(m_ring.getCapacity());
+  m_ringBuffer->set_storage(ringSize, nullptr, flags);
+  m_ringData = static_cast<const uint8_t *>(
+      m_ringBuffer->map_range(0, ringSize, flags));
+  if (!m_ringData) {
+    LOG_ERROR("ReadbackQueue: failed to map readback ring, readbacks fall "
+              "back to dedicated buffers");
+    m_ring.reset(0);
+  }
+
+  m_worker = std::thread(&ReadbackQueue::workerLoop, this);
+  m_initialized = true;
+
+  LOG_INFO("ReadbackQueue: initialized with {} MiB readback ring",
+           m_ring.getCapacity() >> 20);
+}
+
+void ReadbackQueue::retire(bool wait) {
+  bool notify = false;
+  while (!m_inFlight.empty()) {
+    auto &job = *m_inFlight.front();
+    auto status = job.fence->client_wait(GL_SYNC_FLUSH_COMMANDS_BIT,
+                                         wait ? GL_TIMEOUT_IGNORED : 0);
+    if (status == GL_TIMEOUT_EXPIRED) {
+      break;
+    }
+    if (status == GL_WAIT_FAILED) {
+      LOG_ERROR("ReadbackQueue: fence wait failed");
+    }
+
+    job.fence.reset();
+    {
+      std::lock_guard lock(m_mutex);
+      m_ready.push_back(std::move(m_inFlight.front()));
+    }
+    m_inFlight.pop_front();
+    notify = true;
+    wait = false; // only block on the oldest one
+  }
+
+  if (notify) {
+    m_condition.notify_one();
+  }
+}
+
+void ReadbackQueue::recycle() {
+  std::deque<std::unique_ptr<Job>> done;
+  {
+    std::lock_guard lock(m_mutex);
+    done.swap(m_done);
+  }
+
+  // Delivered in submission order, so ring space is released in FIFO order
+  for (const auto &job : done) {
+    if (job->ringAllocation) {
+      m_ring.release(*job->ringAllocation);
+    }
+  }
+}
+
+void ReadbackQueue::workerLoop() {
+  while (true) {
+    std::unique_ptr<Job> job;
+    {
+      std::unique_lock lock(m_mutex);
+      m_condition.wait(lock, [this] { return m_stop || !m_ready.empty(); });
+      if (m_stop) {
+        return;
+      }
+      job = std::move(m_ready.front());
+      m_ready.pop_front();
+      m_busy = true;
+    }
+
+    if (job->callback && job->data) {
+      job->callback(job->data, job->dataSize);
+    }
+
+    {
+      std::lock_guard lock(m_mutex);
+      m_busy = false;
+      m_done.push_back(std::move(job));
+    }
+    m_doneCondition.notify_all();
+  }
+}
+
+} // namespace paimon
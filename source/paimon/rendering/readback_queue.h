@@ -0,0 +1,118 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#include <glad/gl.h>
+
+#include "paimon/opengl/base/object.h"
+#include "paimon/opengl/buffer.h"
+#include "paimon/opengl/texture.h"
+#include "paimon/rendering/ring_allocator.h"
+
+namespace paimon {
+
+// Region of a texture to read back, for cubemaps and arrays z is the face or
+// layer. Rows are tightly packed.
+struct ReadbackRequest {
+  const Texture *texture = nullptr;
+  GLint level = 0;
+  GLint x = 0;
+  GLint y = 0;
+  GLint z = 0;
+  GLsizei width = 0;
+  GLsizei height = 0;
+  GLsizei depth = 1;
+  GLenum format = GL_RGBA;
+  GLenum type = GL_UNSIGNED_BYTE;
+};
+
+// ReadbackQueue copies texture regions into a persistently mapped ring of pixel
+// pack buffers and fences each copy. Once a fence has signaled the callback
+// runs on a worker thread with a pointer into the mapped ring, so neither the
+// copy nor the encoding of the result stalls the render thread.
+class ReadbackQueue {
+public:
+  // Called on the worker thread, the data is only valid during the call
+  using Callback = std::function<void(const void *data, size_t size)>;
+
+  static constexpr size_t DefaultRingSize = 64u << 20;
+
+  ReadbackQueue() = default;
+
+  // Delivers pending readbacks, needs the GL context to still be current
+  ~ReadbackQueue();
+
+  // Delete copy constructor and assignment
+  ReadbackQueue(const ReadbackQueue &) = delete;
+  ReadbackQueue &operator=(const ReadbackQueue &) = delete;
+
+  // Issue the copy, returns false for invalid requests or when no buffer
+  // could be mapped. Blocks only when the ring is full of readbacks that have
+  // not completed yet.
+  bool enqueue(const ReadbackRequest &request, Callback callback);
+
+  // Hand completed copies to the worker and recycle ring space, call once per
+  // frame on the GL thread
+  void update();
+
+  // Wait until every queued readback has been delivered
+  void flush();
+
+  // Number of readbacks not delivered yet
+  size_t getPendingCount() const;
+
+  // Size in bytes of a tightly packed region
+  static size_t getRequestSize(const ReadbackRequest &request);
+
+private:
+  struct Job {
+    Callback callback;
+    size_t dataSize = 0;               // tightly packed region size
+    size_t size = 0;                   // ring size, rounded up
+    std::optional<RingAllocator::Allocation> ringAllocation; // if it fit
+    std::unique_ptr<Buffer> dedicated; // used when larger than the ring
+    const uint8_t *data = nullptr;
+    std::unique_ptr<SyncObject> fence;
+  };
+
+  void initialize();
+
+  // Hand signaled jobs to the worker, optionally blocking on the oldest one
+  void retire(bool wait);
+
+  // Release ring space of jobs the worker has finished with
+  void recycle();
+
+  void workerLoop();
+
+private:
+  bool m_initialized = false;
+
+  // Persistently mapped readback ring, space is released in FIFO order as
+  // the worker delivers
+  std::unique_ptr<Buffer> m_ringBuffer;
+  const uint8_t *m_ringData = nullptr;
+  RingAllocator m_ring{DefaultRingSize};
+
+  // GL thread only, copies waiting for their fence
+  std::deque<std::unique_ptr<Job>> m_inFlight;
+
+  // Shared with the worker
+  mutable std::mutex m_mutex;
+  std::condition_variable m_condition;
+  std::condition_variable m_doneCondition;
+  std::deque<std::unique_ptr<Job>> m_ready; // waiting for the worker
+  std::deque<std::unique_ptr<Job>> m_done;  // delivered, ring space in use
+  bool m_busy = false;                      // worker is running a callback
+  bool m_stop = false;
+  std::thread m_worker;
+};
+
+} // namespace paimon
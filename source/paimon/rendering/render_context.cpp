@@ -2,8 +2,38 @@
 
 #include <cstdint>
 
+#include "paimon/opengl/error.h"
+
 namespace paimon {
 
+RenderContext::RenderContext() {
+  m_framebufferCache.setDeletionQueue(&m_deletionQueue);
+}
+
+void RenderContext::beginFrame() {
+  // Catch errors raised outside any scope during the previous frame
+  PAIMON_GL_CHECKPOINT("frame");
+
+  m_deletionQueue.beginFrame();
+  m_gpuTimerPool.beginFrame();
+  m_pipelineStatisticsPool.beginFrame();
+}
+
+void RenderContext::beginScope(std::string_view name) {
+  glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0,
+                   static_cast<GLsizei>(name.size()), name.data());
+  m_gpuTimerPool.beginScope(name);
+  m_pipelineStatisticsPool.beginScope(name);
+}
+
+void RenderContext::endScope() {
+  m_pipelineStatisticsPool.endScope();
+  m_gpuTimerPool.endScope();
+  glPopDebugGroup();
+
+  PAIMON_GL_CHECKPOINT("render scope");
+}
+
 void RenderContext::beginRendering(const RenderingInfo& info) {
   m_insideRenderPass = true;
 
@@ -19,6 +49,34 @@ void RenderContext::beginRendering(const RenderingInfo& info) {
                info.renderAreaExtent.x, info.renderAreaExtent.y);
   }
 
+  // Collect attachments whose contents need not be loaded or stored
+  m_loadDontCareAttachments.clear();
+  m_storeDontCareAttachments.clear();
+  auto collect = [this](const RenderingAttachmentInfo& attachment,
+                        GLenum attachmentPoint) {
+    if (attachment.loadOp == AttachmentLoadOp::DontCare) {
+      m_loadDontCareAttachments.push_back(attachmentPoint);
+    }
+    if (attachment.storeOp == AttachmentStoreOp::DontCare) {
+      m_storeDontCareAttachments.push_back(attachmentPoint);
+    }
+  };
+  for (size_t i = 0; i < info.colorAttachments.size(); ++i) {
+    collect(info.colorAttachments[i],
+            GL_COLOR_ATTACHMENT0 + static_cast<GLenum>(i));
+  }
+  if (info.depthAttachment.has_value()) {
+    collect(info.depthAttachment.value(), GL_DEPTH_ATTACHMENT);
+  }
+  if (info.stencilAttachment.has_value()) {
+    collect(info.stencilAttachment.value(), GL_STENCIL_ATTACHMENT);
+  }
+  m_renderAreaOffset = info.renderAreaOffset;
+  m_renderAreaExtent = info.renderAreaExtent;
+
+  // Discard previous contents instead of loading them
+  invalidateAttachments(m_loadDontCareAttachments);
+
   // Clear color attachments
   for (size_t i = 0; i < info.colorAttachments.size(); ++i) {
     const auto& attachment = info.colorAttachments[i];
@@ -53,6 +111,9 @@ void RenderContext::beginRendering(const RenderingInfo& info) {
 }
 
 void RenderContext::endRendering() {
+  // Discard contents that are not read after the pass
+  invalidateAttachments(m_storeDontCareAttachments);
+
   m_insideRenderPass = false;
   m_currentFbo = nullptr;
   m_currentVao = nullptr;
@@ -61,6 +122,23 @@ void RenderContext::endRendering() {
   VertexArray::unbind();
 }
 
+void RenderContext::invalidateAttachments(const std::vector<GLenum>& attachments) {
+  if (attachments.empty() || !m_currentFbo) {
+    return;
+  }
+
+  // Invalidate only the render area when one is given
+  if (m_renderAreaExtent.x > 0 && m_renderAreaExtent.y > 0) {
+    m_currentFbo->invalidateSub(static_cast<GLsizei>(attachments.size()),
+                                attachments.data(), m_renderAreaOffset.x,
+                                m_renderAreaOffset.y, m_renderAreaExtent.x,
+                                m_renderAreaExtent.y);
+  } else {
+    m_currentFbo->invalidate(static_cast<GLsizei>(attachments.size()),
+                             attachments.data());
+  }
+}
+
 void RenderContext::beginSwapchainRendering(const SwapchainRenderingInfo& info) {
   m_insideRenderPass = true;
   
@@ -102,10 +180,30 @@ void RenderContext::bindPipeline(const GraphicsPipeline& pipeline) {
   // Bind the program pipeline
   pipeline.bind();
 
-  m_currentPipelineState.apply(pipeline.getState());
+  // Apply only the state groups that changed. A differing baked hash is a
+  // change, an equal one is confirmed field by field so a collision cannot
+  // leave stale state bound. Groups default on both sides are skipped.
+  const auto& block = pipeline.getStateBlock();
+  const auto& state = pipeline.getState();
+  uint32_t candidates =
+      block.nonDefaultGroups | m_currentStateBlock.nonDefaultGroups;
+  uint32_t dirtyGroups = 0;
+  for (size_t i = 0; i < PipelineState::GroupCount; ++i) {
+    uint32_t group = 1u << i;
+    if ((candidates & group) &&
+        (block.groupHashes[i] != m_currentStateBlock.groupHashes[i] ||
+         !m_currentPipelineState.equals(state, group))) {
+      dirtyGroups |= group;
+    }
+  }
+  if (dirtyGroups != 0) {
+    m_currentPipelineState.apply(state, dirtyGroups);
+  }
+  m_currentStateBlock = block;
+
   // Vertex Input State is handled via Vertex Array Objects
-  auto nextVao = m_vertexArrayCache.get(pipeline.getState().vertexInput);
-  if (nextVao != m_currentVao) {
+  auto nextVao = m_vertexArrayCache.get(pipeline.getVertexInputLayout());
+  if (nextVao && nextVao != m_currentVao) {
     nextVao->bind();
     m_currentVao = nextVao;
   }
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <cstdint>
+#include <string_view>
+#include <vector>
+
 #include <glad/gl.h>
 
 #include "paimon/opengl/buffer.h"
@@ -10,8 +13,11 @@
 #include "paimon/opengl/texture.h"
 #include "paimon/opengl/type.h"
 #include "paimon/opengl/vertex_array.h"
+#include "paimon/rendering/deletion_queue.h"
 #include "paimon/rendering/framebuffer_cache.h"
+#include "paimon/rendering/gpu_timer_pool.h"
 #include "paimon/rendering/graphics_pipeline.h"
+#include "paimon/rendering/pipeline_statistics_pool.h"
 #include "paimon/rendering/rendering_info.h"
 #include "paimon/rendering/vertex_array_cache.h"
 
@@ -20,13 +26,22 @@ namespace paimon {
 // RenderContext for Vulkan-style rendering commands
 class RenderContext {
 public:
-  RenderContext() = default;
+  RenderContext();
   ~RenderContext() = default;
 
   // Delete copy constructor and assignment
   RenderContext(const RenderContext&) = delete;
   RenderContext& operator=(const RenderContext&) = delete;
 
+  // Mark the start of a frame, resolves profiling results of earlier frames and
+  // destroys retired resources the GPU no longer uses
+  void beginFrame();
+
+  // Named profiling scope, timed on the GPU, counted by the pipeline statistics
+  // queries and shown as a debug group in frame captures. Scopes may nest.
+  void beginScope(std::string_view name);
+  void endScope();
+
   // Begin rendering pass
   void beginRendering(const RenderingInfo& info);
 
@@ -121,19 +136,53 @@ public:
   
   void multiDrawElementsIndirect(const void* indirect, GLsizei drawCount, GLsizei stride);
 
+  // Cache access for statistics and capacity tuning
+  FramebufferCache& getFramebufferCache() { return m_framebufferCache; }
+  const FramebufferCache& getFramebufferCache() const { return m_framebufferCache; }
+
+  // Deferred destruction of resources that in-flight frames may still use
+  DeletionQueue& getDeletionQueue() { return m_deletionQueue; }
+
+  GpuTimerPool& getGpuTimerPool() { return m_gpuTimerPool; }
+  const GpuTimerPool& getGpuTimerPool() const { return m_gpuTimerPool; }
+
+  PipelineStatisticsPool& getPipelineStatisticsPool() {
+    return m_pipelineStatisticsPool;
+  }
+  const PipelineStatisticsPool& getPipelineStatisticsPool() const {
+    return m_pipelineStatisticsPool;
+  }
+
+private:
+  // Invalidate attachments of the current framebuffer within the render area
+  void invalidateAttachments(const std::vector<GLenum>& attachments);
+
 private:
+  // Declared first so it outlives the caches that retire into it
+  DeletionQueue m_deletionQueue;
+
   bool m_insideRenderPass = false;
 
   Framebuffer* m_currentFbo = nullptr;
+
+  // Attachments with DontCare load/store ops of the current render pass
+  std::vector<GLenum> m_loadDontCareAttachments;
+  std::vector<GLenum> m_storeDontCareAttachments;
+  glm::ivec2 m_renderAreaOffset{0, 0};
+  glm::ivec2 m_renderAreaExtent{0, 0};
   VertexArray* m_currentVao = nullptr;
 
   
   DataType m_currentIndexType = DataType::UInt;
 
   PipelineState m_currentPipelineState;
+  PipelineStateBlock m_currentStateBlock = PipelineStateBlock::getDefault();
 
   FramebufferCache m_framebufferCache;
   VertexArrayCache m_vertexArrayCache;
+
+  GpuTimerPool m_gpuTimerPool;
+  PipelineStatisticsPool m_pipelineStatisticsPool;
 };
 
 } // namespace paimon
@@ -1,5 +1,11 @@
 #include "paimon/rendering/render_pass/color_pass.h"
 
+#include <algorithm>
+#include <array>
+#include <initializer_list>
+#include <span>
+#include <string_view>
+
 #include <glad/gl.h>
 
 #include "paimon/app/application.h"
@@ -11,38 +17,151 @@
 
 using namespace paimon;
 
+namespace {
+
+// Size of a uniform block range, the C++ mirror or the largest size any of
+// the programs reports for the block
+GLsizeiptr getBlockSize(std::string_view name, size_t size,
+                        std::initializer_list<const ShaderProgram *> programs) {
+  for (const auto *program : programs) {
+    if (!program) {
+      continue;
+    }
+    if (const auto *block = program->get_interface().find_uniform_block(name)) {
+      size = std::max(size, static_cast<size_t>(block->dataSize));
+    }
+  }
+  return static_cast<GLsizeiptr>(size);
+}
+
+#ifndef NDEBUG
+constexpr std::array<BlockMemberLayout, 1> TransformUBOLayout = {{
+    {"model", offsetof(TransformUBO, model)},
+}};
+
+constexpr std::array<BlockMemberLayout, 3> CameraUBOLayout = {{
+    {"view", offsetof(CameraUBO, view)},
+    {"projection", offsetof(CameraUBO, projection)},
+    {"position", offsetof(CameraUBO, position)},
+}};
+
+// The second light checks the array stride
+constexpr size_t FirstLight = offsetof(LightingUBO, lights);
+constexpr size_t SecondLight = FirstLight + sizeof(PunctualLightData);
+constexpr std::array<BlockMemberLayout, 10> LightingUBOLayout = {{
+    {"lightCount", offsetof(LightingUBO, lightCount)},
+    {"lights[0].position", FirstLight + offsetof(PunctualLightData, position)},
+    {"lights[0].type", FirstLight + offsetof(PunctualLightData, type)},
+    {"lights[0].direction",
+     FirstLight + offsetof(PunctualLightData, direction)},
+    {"lights[0].range", FirstLight + offsetof(PunctualLightData, range)},
+    {"lights[0].color", FirstLight + offsetof(PunctualLightData, color)},
+    {"lights[0].intensity",
+     FirstLight + offsetof(PunctualLightData, intensity)},
+    {"lights[0].innerConeAngle",
+     FirstLight + offsetof(PunctualLightData, innerConeAngle)},
+    {"lights[0].outerConeAngle",
+     FirstLight + offsetof(PunctualLightData, outerConeAngle)},
+    {"lights[1].position", SecondLight + offsetof(PunctualLightData, position)},
+}};
+
+constexpr std::array<BlockMemberLayout, 9> MaterialUBOLayout = {{
+    {"baseColorFactor", offsetof(MaterialUBO, baseColorFactor)},
+    {"emissiveFactor", offsetof(MaterialUBO, emissiveFactor)},
+    {"metallicFactor", offsetof(MaterialUBO, metallicFactor)},
+    {"roughnessFactor", offsetof(MaterialUBO, roughnessFactor)},
+    {"baseColorLayer", offsetof(MaterialUBO, baseColorLayer)},
+    {"metallicRoughnessLayer", offsetof(MaterialUBO, metallicRoughnessLayer)},
+    {"normalLayer", offsetof(MaterialUBO, normalLayer)},
+    {"emissiveLayer", offsetof(MaterialUBO, emissiveLayer)},
+    {"occlusionLayer", offsetof(MaterialUBO, occlusionLayer)},
+}};
+
+constexpr std::array<BlockMemberLayout, 2> EnvironmentUBOLayout = {{
+    {"rotation", offsetof(EnvironmentUBO, rotation)},
+    {"intensity", offsetof(EnvironmentUBO, intensity)},
+}};
+
+// Compare the C++ mirrors with the blocks a program uses
+void checkBlockLayouts(const ShaderProgram &program) {
+  const auto &programInterface = program.get_interface();
+  auto check = [&](std::string_view name, size_t size,
+                   std::span<const BlockMemberLayout> members) {
+    if (const auto *block = programInterface.find_uniform_block(name)) {
+      ProgramInterface::check_block_layout(*block, size, members);
+    }
+  };
+  check("TransformUBO", sizeof(TransformUBO), TransformUBOLayout);
+  check("CameraUBO", sizeof(CameraUBO), CameraUBOLayout);
+  check("LightingUBO", sizeof(LightingUBO), LightingUBOLayout);
+  check("MaterialUBO", sizeof(MaterialUBO), MaterialUBOLayout);
+  check("EnvironmentUBO", sizeof(EnvironmentUBO), EnvironmentUBOLayout);
+}
+#endif
+
+} // namespace
+
 ColorPass::ColorPass(RenderContext &renderContext)
     : m_renderContext(renderContext) {
   // Create a minimal VAO (no vertex data needed, vertices are in shader)
   // m_vao = std::make_unique<VertexArray>();
 
-  // Setup sampler for texture filtering
-  m_sampler = std::make_unique<Sampler>();
-  m_sampler->set(GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-  m_sampler->set(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-  m_sampler->set(GL_TEXTURE_WRAP_S, GL_REPEAT);
-  m_sampler->set(GL_TEXTURE_WRAP_T, GL_REPEAT);
-
-  // Setup sampler for IBL cubemaps
-  m_ibl_sampler = std::make_unique<Sampler>();
-  m_ibl_sampler->set(GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-  m_ibl_sampler->set(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-  m_ibl_sampler->set(GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-  m_ibl_sampler->set(GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-  m_ibl_sampler->set(GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+  // Default material sampler and sampler for IBL cubemaps
+  auto &samplerCache = Application::getInstance().getSamplerCache();
+  m_sampler = samplerCache.get({});
+  m_ibl_sampler = samplerCache.get(
+      SamplerDescriptor::clampToEdge(GL_LINEAR_MIPMAP_LINEAR, GL_LINEAR));
+
+  auto &shaderManager = Application::getInstance().getShaderManager();
+  m_pipelines[GenericVariant] =
+      createPipeline(m_programs.get(shaderManager, GenericVariant));
+
+  m_color_texture = std::make_unique<Texture>(GL_TEXTURE_2D);
+  m_depth_texture = std::make_unique<Texture>(GL_TEXTURE_2D);
+
+  // Allocate uniform buffer ranges from the shared allocator
+  auto &bufferAllocator = Application::getInstance().getBufferAllocator();
+  // Sized as the shaders report the blocks, a bound range smaller than the
+  // block is an error at draw time
+  auto *vertex_program =
+      shaderManager.createShaderProgram("damaged_helmet.vert");
+  auto *fragment_program = m_programs.get(shaderManager, GenericVariant);
+  auto blockSize = [&](std::string_view name, size_t size) {
+    return getBlockSize(name, size, {vertex_program, fragment_program});
+  };
+  m_transform_ubo = bufferAllocator.allocate(
+      blockSize("TransformUBO", sizeof(TransformUBO)));
+  m_camera_ubo =
+      bufferAllocator.allocate(blockSize("CameraUBO", sizeof(CameraUBO)));
+  m_material_ubo =
+      bufferAllocator.allocate(blockSize("MaterialUBO", sizeof(MaterialUBO)));
+  // Allocate space for lighting UBO with fixed maximum lights
+  m_lighting_ubo =
+      bufferAllocator.allocate(blockSize("LightingUBO", sizeof(LightingUBO)));
+  m_environment_ubo = bufferAllocator.allocate(
+      blockSize("EnvironmentUBO", sizeof(EnvironmentUBO)));
+}
 
+std::unique_ptr<GraphicsPipeline>
+ColorPass::createPipeline(ShaderProgram *fragment_program) const {
   // Get shader programs for main rendering (separable programs for pipeline)
   auto &shaderManager = Application::getInstance().getShaderManager();
 
   auto *vertex_program =
       shaderManager.createShaderProgram("damaged_helmet.vert");
-  auto *fragment_program =
-      shaderManager.createShaderProgram("damaged_helmet.frag");
 
   if (!vertex_program || !fragment_program) {
     LOG_ERROR("Failed to load main shader programs");
   }
 
+#ifndef NDEBUG
+  for (const auto *program : {vertex_program, fragment_program}) {
+    if (program) {
+      checkBlockLayouts(*program);
+    }
+  }
+#endif
+
   // Create graphics pipeline
   GraphicsPipelineCreateInfo pipelineInfo;
   pipelineInfo.shaderStages = {
@@ -64,25 +183,72 @@ ColorPass::ColorPass(RenderContext &renderContext)
   pipelineInfo.state.vertexInput.bindings = sg::Primitive::bindings();
   pipelineInfo.state.vertexInput.attributes = sg::Primitive::attributes();
 
-  m_pipeline = std::make_unique<GraphicsPipeline>(pipelineInfo);
-  if (!m_pipeline->validate()) {
+  auto pipeline = std::make_unique<GraphicsPipeline>(pipelineInfo);
+  if (!pipeline->validate()) {
     LOG_ERROR("Failed to validate graphics pipeline");
   }
+  return pipeline;
+}
 
-  m_color_texture = std::make_unique<Texture>(GL_TEXTURE_2D);
-  m_depth_texture = std::make_unique<Texture>(GL_TEXTURE_2D);
+ShaderVariantKey
+ColorPass::getMaterialFeatures(const sg::Material &material) const {
+  // Packed materials sample the layers their textures were copied to
+  bool packed = m_texture_packer && m_texture_packer->isPacked(material);
+  auto hasTexture = [&](const std::shared_ptr<sg::Texture> &texture) {
+    if (!texture) {
+      return false;
+    }
+    return packed ? m_texture_packer->find(*texture) != nullptr
+                  : texture->image != nullptr;
+  };
 
-  // Create uniform buffers and storage buffers
-  m_transform_ubo.set_storage(sizeof(TransformUBO), nullptr,
-                              GL_DYNAMIC_STORAGE_BIT);
-  m_camera_ubo.set_storage(sizeof(CameraUBO), nullptr, GL_DYNAMIC_STORAGE_BIT);
-  m_material_ubo.set_storage(sizeof(MaterialUBO), nullptr,
-                             GL_DYNAMIC_STORAGE_BIT);
-  // Allocate space for lighting UBO with fixed maximum lights
-  m_lighting_ubo.set_storage(sizeof(LightingUBO), nullptr,
-                             GL_DYNAMIC_STORAGE_BIT);
-  m_environment_ubo.set_storage(sizeof(EnvironmentUBO), nullptr,
-                                GL_DYNAMIC_STORAGE_BIT);
+  const auto &pbr = material.pbrMetallicRoughness;
+  ShaderVariantKey key = packed ? PbrShaderFeatures::MaterialTextureArrays : 0;
+  if (hasTexture(pbr.baseColorTexture)) {
+    key |= PbrShaderFeatures::BaseColorTexture;
+  }
+  if (hasTexture(pbr.metallicRoughnessTexture)) {
+    key |= PbrShaderFeatures::MetallicRoughnessTexture;
+  }
+  if (hasTexture(material.emissiveTexture)) {
+    key |= PbrShaderFeatures::EmissiveTexture;
+  }
+  if (hasTexture(material.occlusionTexture)) {
+    key |= PbrShaderFeatures::OcclusionTexture;
+  }
+  return key;
+}
+
+GraphicsPipeline *ColorPass::getPipeline(ShaderVariantKey key) {
+  auto &pipeline = m_pipelines[key];
+  if (!pipeline) {
+    // Compiled in the background, the first frames draw with the generic
+    // variant
+    auto &shaderManager = Application::getInstance().getShaderManager();
+    if (auto *program = m_programs.request(shaderManager, key).get()) {
+      pipeline = createPipeline(program);
+    }
+  }
+  return pipeline.get();
+}
+
+void ColorPass::setTexturePacking(bool enabled) {
+  if (!enabled) {
+    m_texture_packer.reset();
+    return;
+  }
+  if (m_texture_packer) {
+    return;
+  }
+
+  // The array variant is only compiled when packing is actually used, in the
+  // background while materials keep drawing with the generic pipeline
+  auto &shaderManager = Application::getInstance().getShaderManager();
+  m_programs.request(shaderManager,
+                     PbrShaderFeatures::MaterialTextureArrays | GenericVariant);
+  m_texture_packer = std::make_unique<MaterialTexturePacker>(
+      m_renderContext.getDeletionQueue());
+  m_texture_packing_dirty = true;
 }
 
 void ColorPass::draw(RenderContext &ctx, const glm::ivec2 &resolution,
@@ -121,7 +287,8 @@ void ColorPass::draw(RenderContext &ctx, const glm::ivec2 &resolution,
     cameraData.view = cameraComp.view;
     cameraData.projection = cameraComp.projection;
     cameraData.position = position;
-    m_camera_ubo.set_sub_data(0, sizeof(CameraUBO), &cameraData);
+    m_camera_ubo->getBuffer().set_sub_data(
+        m_camera_ubo->offset, sizeof(CameraUBO), &cameraData);
   }
 
   {
@@ -202,11 +369,23 @@ void ColorPass::draw(RenderContext &ctx, const glm::ivec2 &resolution,
     }
 
     // Upload lighting data to UBO
-    m_lighting_ubo.set_sub_data(0, sizeof(LightingUBO), &lightingData);
+    m_lighting_ubo->getBuffer().set_sub_data(
+        m_lighting_ubo->offset, sizeof(LightingUBO), &lightingData);
   }
 
-  m_color_texture->set_storage_2d(1, GL_RGBA8, resolution.x, resolution.y);
-  m_depth_texture->set_storage_2d(1, GL_DEPTH_COMPONENT32, resolution.x, resolution.y);
+  // Immutable storage cannot be respecified, recreate the targets on resize.
+  // The old ones may still be sampled by in-flight frames (the viewport shows
+  // the color target), destroying them later also drops their framebuffer.
+  if (resolution != m_resolution) {
+    m_resolution = resolution;
+    ctx.getDeletionQueue().retire(std::move(m_color_texture));
+    ctx.getDeletionQueue().retire(std::move(m_depth_texture));
+    m_color_texture = std::make_unique<Texture>(GL_TEXTURE_2D);
+    m_color_texture->set_storage_2d(1, GL_RGBA8, resolution.x, resolution.y);
+    m_depth_texture = std::make_unique<Texture>(GL_TEXTURE_2D);
+    m_depth_texture->set_storage_2d(1, GL_DEPTH_COMPONENT32, resolution.x,
+                                    resolution.y);
+  }
 
   {
     // Setup rendering info for FBO
@@ -221,81 +400,178 @@ void ColorPass::draw(RenderContext &ctx, const glm::ivec2 &resolution,
 
     // Setup depth attachment
     renderingInfo.depthAttachment.emplace(
-        *m_depth_texture, AttachmentLoadOp::Clear, AttachmentStoreOp::Store,
+        *m_depth_texture, AttachmentLoadOp::Clear, AttachmentStoreOp::DontCare,
         ClearValue::DepthStencil(1.0f, 0));
 
+    // Packed materials cannot draw without the array variant
+    const auto &arrayProgram =
+        m_programs[PbrShaderFeatures::MaterialTextureArrays | GenericVariant];
+    if (m_texture_packer && arrayProgram.isReady() && !arrayProgram.get()) {
+      LOG_ERROR("ColorPass: texture array variant failed, packing disabled");
+      m_texture_packer.reset();
+    }
+
+    // Pack material textures once streamed uploads have settled, a new load
+    // re-arms packing through the uploads it queues
+    if (m_texture_packer) {
+      auto &uploadQueue = Application::getInstance().getTextureUploadQueue();
+      if (uploadQueue.getPendingCount() > 0) {
+        m_texture_packing_dirty = true;
+      } else if (m_texture_packing_dirty) {
+        m_texture_packer->pack(scene);
+        m_texture_packing_dirty = false;
+      }
+    }
+
     // Begin rendering to FBO
+    ctx.beginScope("ColorPass");
     ctx.beginRendering(renderingInfo);
 
+    // Specialize each draw for the textures its material has and sort the
+    // draws by variant. Draws of a variant keep the view order.
+    m_draws.clear();
+    auto primitiveView =
+        scene.view<ecs::Primitive, ecs::Material, ecs::GlobalTransform>();
+    for (auto [entity, primitiveComp, materialComp, transform] :
+         primitiveView.each()) {
+      if (!primitiveComp.primitive || !primitiveComp.primitive->allocation)
+        continue;
+
+      Draw &draw = m_draws.emplace_back();
+      draw.key = GenericVariant;
+      draw.primitive = primitiveComp.primitive.get();
+      draw.material = materialComp.material.get();
+      draw.model = &transform.matrix;
+      if (draw.material) {
+        auto key = getMaterialFeatures(*draw.material);
+        if (getPipeline(key)) {
+          draw.key = key;
+        }
+      }
+    }
+    std::stable_sort(
+        m_draws.begin(), m_draws.end(),
+        [](const Draw &a, const Draw &b) { return a.key < b.key; });
+
     // Bind pipeline (this applies depth test and other states)
-    ctx.bindPipeline(*m_pipeline);
+    ctx.bindPipeline(*m_pipelines[GenericVariant]);
+    const GraphicsPipeline *boundPipeline = m_pipelines[GenericVariant].get();
+
+    // Packed arrays and samplers bound per material texture unit, materials
+    // sharing arrays skip the rebind
+    std::array<std::pair<const Texture *, const Sampler *>, 5> boundArrays{};
 
     // Set viewport
     ctx.setViewport(0, 0, resolution.x, resolution.y);
 
-    // Iterate over entities with Primitive and Material components
-    auto primitiveView = scene.view<ecs::Primitive, ecs::Material, ecs::GlobalTransform>();
-    for (auto [entity, primitiveComp, materialComp, transform] : primitiveView.each()) {
-      if (!primitiveComp.primitive)
-        continue;
+    // All primitives share the geometry pool buffers
+    auto &geometryPool = Application::getInstance().getGeometryPool();
+
+    // White stand-in for the textures a material lacks, the generic variant
+    // samples every unit
+    const auto &fallbackTexture = Application::getInstance()
+                                      .getTextureUploadQueue()
+                                      .getFallbackTexture();
+    uint32_t boundPage = UINT32_MAX;
 
-      const auto &primitive = *primitiveComp.primitive;
+    for (const auto &draw : m_draws) {
+      const auto &primitive = *draw.primitive;
 
       // Update transform uniform buffer
       TransformUBO transformData;
-      transformData.model = transform.matrix;
-      m_transform_ubo.set_sub_data(0, sizeof(TransformUBO), &transformData);
-
-      // Bind vertex buffers
-      if (primitive.positions) {
-        ctx.bindVertexBuffer(0, *primitive.positions, 0, sizeof(glm::vec3));
-      }
-      if (primitive.normals) {
-        ctx.bindVertexBuffer(1, *primitive.normals, 0, sizeof(glm::vec3));
-      }
-      if (primitive.texcoords) {
-        ctx.bindVertexBuffer(2, *primitive.texcoords, 0, sizeof(glm::vec2));
-      }
-      if (primitive.colors) {
-        ctx.bindVertexBuffer(3, *primitive.colors, 0, sizeof(glm::vec3));
+      transformData.model = *draw.model;
+      m_transform_ubo->getBuffer().set_sub_data(
+          m_transform_ubo->offset, sizeof(TransformUBO), &transformData);
+
+      // Bind vertex and index buffers only when the pool page changes
+      if (primitive.page != boundPage) {
+        geometryPool.bind(ctx, primitive.page);
+        boundPage = primitive.page;
       }
 
-      // Bind index buffer if present
-      if (primitive.indices) {
-        ctx.bindIndexBuffer(*primitive.indices, primitive.indexType);
+      // Draws are sorted, the pipeline changes once per variant
+      const auto *pipeline = m_pipelines[draw.key].get();
+      if (pipeline != boundPipeline) {
+        ctx.bindPipeline(*pipeline);
+        boundPipeline = pipeline;
       }
 
       // Update material UBO and bind textures from Material component
-      if (materialComp.material) {
-        const auto &mat = materialComp.material;
+      if (draw.material) {
+        const auto *mat = draw.material;
         const auto &pbr = mat->pbrMetallicRoughness;
 
+        // Packed materials sample texture arrays with an array variant,
+        // until it is compiled they use their own textures
+        bool packed = draw.key & PbrShaderFeatures::MaterialTextureArrays;
+
         // Prepare material data
         MaterialUBO materialData;
         materialData.baseColorFactor = pbr.baseColorFactor;
         materialData.emissiveFactor = mat->emissiveFactor;
         materialData.metallicFactor = pbr.metallicFactor;
         materialData.roughnessFactor = pbr.roughnessFactor;
-        m_material_ubo.set_sub_data(0, sizeof(MaterialUBO), &materialData);
 
-        // Bind textures with sampler
-        if (pbr.baseColorTexture && pbr.baseColorTexture->image) {
-          ctx.bindTexture(0, *pbr.baseColorTexture->image, *m_sampler);
-        }
-        if (pbr.metallicRoughnessTexture &&
-            pbr.metallicRoughnessTexture->image) {
-          ctx.bindTexture(1, *pbr.metallicRoughnessTexture->image,
-                          *m_sampler);
-        }
-        if (mat->normalTexture && mat->normalTexture->image) {
-          ctx.bindTexture(2, *mat->normalTexture->image, *m_sampler);
-        }
-        if (mat->emissiveTexture && mat->emissiveTexture->image) {
-          ctx.bindTexture(3, *mat->emissiveTexture->image, *m_sampler);
-        }
-        if (mat->occlusionTexture && mat->occlusionTexture->image) {
-          ctx.bindTexture(4, *mat->occlusionTexture->image, *m_sampler);
+        if (packed) {
+          // Bind the array holding the texture and return its layer
+          auto bindPackedTexture =
+              [&](uint32_t unit,
+                  const std::shared_ptr<sg::Texture> &texture) -> int {
+            const auto *packedTexture =
+                texture ? m_texture_packer->find(*texture) : nullptr;
+            if (!packedTexture) {
+              return -1;
+            }
+            const auto *sampler =
+                texture->sampler ? texture->sampler.get() : m_sampler.get();
+            auto binding = std::make_pair(
+                static_cast<const Texture *>(packedTexture->array.get()),
+                sampler);
+            if (boundArrays[unit] != binding) {
+              ctx.bindTexture(unit, *packedTexture->array, *sampler);
+              boundArrays[unit] = binding;
+            }
+            return packedTexture->layer;
+          };
+          materialData.baseColorLayer =
+              bindPackedTexture(0, pbr.baseColorTexture);
+          materialData.metallicRoughnessLayer =
+              bindPackedTexture(1, pbr.metallicRoughnessTexture);
+          materialData.normalLayer = bindPackedTexture(2, mat->normalTexture);
+          materialData.emissiveLayer =
+              bindPackedTexture(3, mat->emissiveTexture);
+          materialData.occlusionLayer =
+              bindPackedTexture(4, mat->occlusionTexture);
+        } else {
+          // Bind textures with their own sampler, or the default one. Units
+          // left empty would keep the texture of the previous draw.
+          bool generic = draw.key == GenericVariant;
+          auto bindMaterialTexture =
+              [&](uint32_t unit, const std::shared_ptr<sg::Texture> &texture) {
+            if (texture && texture->image) {
+              ctx.bindTexture(unit, *texture->image,
+                              texture->sampler ? *texture->sampler
+                                               : *m_sampler);
+            } else if (generic) {
+              ctx.bindTexture(unit, *fallbackTexture, *m_sampler);
+            }
+          };
+          bindMaterialTexture(0, pbr.baseColorTexture);
+          bindMaterialTexture(1, pbr.metallicRoughnessTexture);
+          bindMaterialTexture(2, mat->normalTexture);
+          bindMaterialTexture(3, mat->emissiveTexture);
+          bindMaterialTexture(4, mat->occlusionTexture);
+          boundArrays.fill({});
+
+          materialData.baseColorLayer = -1;
+          materialData.metallicRoughnessLayer = -1;
+          materialData.normalLayer = -1;
+          materialData.emissiveLayer = -1;
+          materialData.occlusionLayer = -1;
         }
+
+        m_material_ubo->getBuffer().set_sub_data(
+            m_material_ubo->offset, sizeof(MaterialUBO), &materialData);
       }
 
       // Bind IBL textures (bindings 5/6/7 match shader layout)
@@ -304,7 +580,8 @@ void ColorPass::draw(RenderContext &ctx, const glm::ivec2 &resolution,
         EnvironmentUBO envData;
         envData.intensity = env.intensity;
         envData.rotation = glm::mat4_cast(env.rotation);
-        m_environment_ubo.set_sub_data(0, sizeof(EnvironmentUBO), &envData);
+        m_environment_ubo->getBuffer().set_sub_data(
+            m_environment_ubo->offset, sizeof(EnvironmentUBO), &envData);
 
         if (env.irradianceMap) {
           ctx.bindTexture(5, *env.irradianceMap, *m_ibl_sampler);
@@ -318,21 +595,32 @@ void ColorPass::draw(RenderContext &ctx, const glm::ivec2 &resolution,
         break; // Only one environment
       }
 
-      ctx.bindUniformBuffer(0, m_transform_ubo);
-      ctx.bindUniformBuffer(1, m_camera_ubo);
-      ctx.bindUniformBuffer(2, m_material_ubo);
-      ctx.bindUniformBuffer(3, m_lighting_ubo);
-      ctx.bindUniformBuffer(4, m_environment_ubo);
+      ctx.bindUniformBuffer(0, m_transform_ubo->getBuffer(),
+                            m_transform_ubo->offset, m_transform_ubo->size);
+      ctx.bindUniformBuffer(1, m_camera_ubo->getBuffer(),
+                            m_camera_ubo->offset, m_camera_ubo->size);
+      ctx.bindUniformBuffer(2, m_material_ubo->getBuffer(),
+                            m_material_ubo->offset, m_material_ubo->size);
+      ctx.bindUniformBuffer(3, m_lighting_ubo->getBuffer(),
+                            m_lighting_ubo->offset, m_lighting_ubo->size);
+      ctx.bindUniformBuffer(4, m_environment_ubo->getBuffer(),
+                            m_environment_ubo->offset,
+                            m_environment_ubo->size);
 
       // Draw the primitive
       if (primitive.hasIndices()) {
-        ctx.drawElements(primitive.indexCount, nullptr);
-      } else if (primitive.positions) {
-        ctx.drawArrays(0, primitive.vertexCount);
+        ctx.drawElementsBaseVertex(
+            primitive.indexCount,
+            reinterpret_cast<const void *>(primitive.firstIndex *
+                                           sizeof(uint32_t)),
+            primitive.baseVertex);
+      } else if (primitive.vertexCount > 0) {
+        ctx.drawArrays(primitive.baseVertex, primitive.vertexCount);
       }
     }
 
     // End rendering to FBO
     ctx.endRendering();
+    ctx.endScope();
   }
 }
\ No newline at end of file
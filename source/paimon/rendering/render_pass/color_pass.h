@@ -1,19 +1,33 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <memory>
+#include <string_view>
+#include <vector>
 
 #include "paimon/core/ecs/scene.h"
+#include "paimon/core/sg/material.h"
+#include "paimon/core/sg/mesh.h"
 #include "paimon/opengl/buffer.h"
 #include "paimon/opengl/sampler.h"
 #include "paimon/opengl/texture.h"
+#include "paimon/rendering/buffer_allocator.h"
 #include "paimon/rendering/graphics_pipeline.h"
+#include "paimon/rendering/material_texture_packer.h"
 #include "paimon/rendering/render_context.h"
+#include "paimon/rendering/shader_variant.h"
 
 namespace paimon {
 
+// C++ mirrors of the shader uniform blocks, the static_asserts pin the
+// std140 layout and debug builds check it against the driver at pipeline
+// creation
+
 struct TransformUBO {
   glm::mat4 model;
 };
+static_assert(sizeof(TransformUBO) == 64);
 
 struct CameraUBO {
   glm::mat4 view;
@@ -21,6 +35,7 @@ struct CameraUBO {
   glm::vec3 position;
   float _padding[1]; // alignment - vec3 needs to be aligned as vec4 in std140
 };
+static_assert(sizeof(CameraUBO) == 144 && offsetof(CameraUBO, position) == 128);
 
 // Maximum number of lights supported
 constexpr size_t MAX_LIGHTS = 32;
@@ -37,6 +52,10 @@ struct PunctualLightData {
   float outerConeAngle;
   glm::vec2 _padding; // std140: alignment
 };
+static_assert(sizeof(PunctualLightData) == 64 &&
+              offsetof(PunctualLightData, direction) == 16 &&
+              offsetof(PunctualLightData, color) == 32 &&
+              offsetof(PunctualLightData, innerConeAngle) == 48);
 
 // LightingUBO contains light count and fixed-size array of lights
 struct LightingUBO {
@@ -44,20 +63,54 @@ struct LightingUBO {
   int _padding[3]; // std140 alignment for array
   PunctualLightData lights[MAX_LIGHTS];
 };
+static_assert(offsetof(LightingUBO, lights) == 16);
 
 struct MaterialUBO {
   glm::vec4 baseColorFactor;
   glm::vec3 emissiveFactor;
   float metallicFactor;
   float roughnessFactor;
-  float _padding[3]; // alignment
+  // Texture array layers when the material is packed, -1 for no texture
+  int baseColorLayer;
+  int metallicRoughnessLayer;
+  int normalLayer;
+  int emissiveLayer;
+  int occlusionLayer;
+  float _padding[2]; // alignment
 };
+static_assert(sizeof(MaterialUBO) == 64 &&
+              offsetof(MaterialUBO, emissiveFactor) == 16 &&
+              offsetof(MaterialUBO, roughnessFactor) == 32 &&
+              offsetof(MaterialUBO, occlusionLayer) == 52);
 
 struct EnvironmentUBO {
   glm::mat4 rotation; // Rotation of the environment map, applied to IBL sampling
   float intensity; // scales IBL contribution (ecs::Environment::intensity)
   float _padding[3]; // alignment
 };
+static_assert(sizeof(EnvironmentUBO) == 80 &&
+              offsetof(EnvironmentUBO, intensity) == 64);
+
+// Variant features of the PBR fragment shader. A variant only samples the
+// material textures it has a bit for, the others read as their factor.
+struct PbrShaderFeatures {
+  static constexpr std::string_view Shader = "damaged_helmet.frag";
+  enum : ShaderVariantKey {
+    MaterialTextureArrays = 1 << 0, // samples packed texture arrays
+    BaseColorTexture = 1 << 1,
+    MetallicRoughnessTexture = 1 << 2,
+    EmissiveTexture = 1 << 3,
+    OcclusionTexture = 1 << 4,
+    // Samples every material texture, for any material
+    MaterialTextures = BaseColorTexture | MetallicRoughnessTexture |
+                       EmissiveTexture | OcclusionTexture,
+  };
+  static constexpr std::array<std::string_view, 5> Defines = {
+      "MATERIAL_TEXTURE_ARRAYS",        "HAS_BASE_COLOR_TEXTURE",
+      "HAS_METALLIC_ROUGHNESS_TEXTURE", "HAS_EMISSIVE_TEXTURE",
+      "HAS_OCCLUSION_TEXTURE",
+  };
+};
 
 class ColorPass {
 public:
@@ -67,22 +120,63 @@ public:
 
   Texture* getColorTexture() const { return m_color_texture.get(); }
 
+  // Pack material textures into texture arrays once uploads settle, so
+  // materials of the same class bind once per pass. Off by default.
+  void setTexturePacking(bool enabled);
+  bool isTexturePacking() const { return m_texture_packer != nullptr; }
+
 private:
+  using ProgramTable = ShaderVariantTable<PbrShaderFeatures>;
+
+  std::unique_ptr<GraphicsPipeline>
+  createPipeline(ShaderProgram *fragment_program) const;
+
+  // A draw of the frame, sorted by variant so each pipeline binds once
+  struct Draw {
+    ShaderVariantKey key = 0;
+    const sg::Primitive *primitive = nullptr;
+    const sg::Material *material = nullptr;
+    const glm::mat4 *model = nullptr;
+  };
+
+  // Variant drawing everything until the specialized ones are compiled
+  static constexpr ShaderVariantKey GenericVariant =
+      PbrShaderFeatures::MaterialTextures;
+
+  // Features of the variant specialized for a material
+  ShaderVariantKey getMaterialFeatures(const sg::Material &material) const;
+
+  // Pipeline of a variant, requesting its program on first use. nullptr
+  // while the program is compiling or when it failed to compile.
+  GraphicsPipeline *getPipeline(ShaderVariantKey key);
+
   RenderContext& m_renderContext;
 
+  glm::ivec2 m_resolution{0, 0};
   std::unique_ptr<Texture> m_color_texture;
   std::unique_ptr<Texture> m_depth_texture;
 
-  std::unique_ptr<Sampler> m_sampler;
-  std::unique_ptr<Sampler> m_ibl_sampler; // Cubemap sampler for IBL textures
-  std::unique_ptr<GraphicsPipeline> m_pipeline;
-
-  // Uniform buffers
-  Buffer m_transform_ubo;
-  Buffer m_camera_ubo;
-  Buffer m_lighting_ubo;
-  Buffer m_material_ubo;
-  Buffer m_environment_ubo;
+  std::shared_ptr<const Sampler> m_sampler;
+  std::shared_ptr<const Sampler> m_ibl_sampler; // Cubemap sampler for IBL textures
+  // Fragment program and pipeline of each variant, indexed by feature bits.
+  // The generic variant is built up front, the others once requested and
+  // compiled.
+  ProgramTable m_programs;
+  std::array<std::unique_ptr<GraphicsPipeline>, ProgramTable::VariantCount>
+      m_pipelines;
+
+  // Draws of the current frame, kept to reuse the allocation
+  std::vector<Draw> m_draws;
+
+  std::unique_ptr<MaterialTexturePacker> m_texture_packer;
+  bool m_texture_packing_dirty = false;
+
+  // Uniform buffer ranges, may move between frames when defragmented
+  std::shared_ptr<BufferAllocation> m_transform_ubo;
+  std::shared_ptr<BufferAllocation> m_camera_ubo;
+  std::shared_ptr<BufferAllocation> m_lighting_ubo;
+  std::shared_ptr<BufferAllocation> m_material_ubo;
+  std::shared_ptr<BufferAllocation> m_environment_ubo;
 };
 
 }
\ No newline at end of file
@@ -14,11 +14,8 @@ FinalPass::FinalPass(RenderContext &renderContext)
   // m_vao = std::make_unique<VertexArray>();
 
   // Setup sampler for texture filtering
-  m_sampler = std::make_unique<Sampler>();
-  m_sampler->set(GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-  m_sampler->set(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-  m_sampler->set(GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-  m_sampler->set(GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+  m_sampler = Application::getInstance().getSamplerCache().get(
+      SamplerDescriptor::clampToEdge());
 
   // Load shaders from Application's ShaderManager
   auto &shaderManager = Application::getInstance().getShaderManager();
@@ -50,6 +47,7 @@ void FinalPass::draw(RenderContext& ctx, const Texture &texture, const glm::ivec
   renderingInfo.clearDepth = 1.0f;
   renderingInfo.clearStencil = 0;
 
+  ctx.beginScope("FinalPass");
   ctx.beginSwapchainRendering(renderingInfo);
 
   ctx.bindPipeline(*m_pipeline);
@@ -59,4 +57,5 @@ void FinalPass::draw(RenderContext& ctx, const Texture &texture, const glm::ivec
   ctx.drawArrays(0, 6);
 
   ctx.endSwapchainRendering();
+  ctx.endScope();
 }
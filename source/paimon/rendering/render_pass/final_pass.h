@@ -18,7 +18,7 @@ public:
 private:
   RenderContext& m_renderContext;
 
-  std::unique_ptr<Sampler> m_sampler;
+  std::shared_ptr<const Sampler> m_sampler;
   std::unique_ptr<GraphicsPipeline> m_pipeline;
 };
 
@@ -22,6 +22,8 @@ void Renderer::onUpdate() {
 
   auto &scene = Application::getInstance().getScene();
 
+  m_renderContext->beginFrame();
+
   // First Pass: Render to FBO
   m_color_pass.draw(*m_renderContext, m_resolution, scene);
 
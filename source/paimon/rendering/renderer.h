@@ -20,6 +20,9 @@ public:
   const ColorPass &getColorPass() const { return m_color_pass; }
   ColorPass &getColorPass() { return m_color_pass; }
 
+  const RenderContext &getRenderContext() const { return *m_renderContext; }
+  RenderContext &getRenderContext() { return *m_renderContext; }
+
 private:
   std::unique_ptr<RenderContext> m_renderContext;
   
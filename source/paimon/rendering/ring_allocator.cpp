@@ -0,0 +1,53 @@
+#include "paimon/rendering/ring_allocator.h"
+
+namespace paimon {
+
+void RingAllocator::reset(size_t capacity) {
+  m_capacity = capacity;
+  m_head = 0;
+  m_tail = 0;
+  m_used = 0;
+}
+
+std::optional<RingAllocator::Allocation> RingAllocator::allocate(size_t size) {
+  if (size == 0 || size > m_capacity) {
+    return std::nullopt;
+  }
+  if (m_used == 0) {
+    m_head = 0;
+    m_tail = 0;
+  }
+
+  // Free space is [head, end) + [0, tail) when head >= tail, else [head, tail)
+  if (m_head >= m_tail && !(m_used > 0 && m_head == m_tail)) {
+    if (m_head + size <= m_capacity) {
+      Allocation allocation{m_head, size, 0};
+      m_head += size;
+      m_used += size;
+      return allocation;
+    }
+    if (size <= m_tail) {
+      // Skip the end of the ring and wrap around
+      Allocation allocation{0, size, m_capacity - m_head};
+      m_head = size;
+      m_used += size + allocation.padding;
+      return allocation;
+    }
+    return std::nullopt;
+  }
+
+  if (m_head + size <= m_tail) {
+    Allocation allocation{m_head, size, 0};
+    m_head += size;
+    m_used += size;
+    return allocation;
+  }
+  return std::nullopt;
+}
+
+void RingAllocator::release(const Allocation& allocation) {
+  m_tail = allocation.offset + allocation.size;
+  m_used -= allocation.size + allocation.padding;
+}
+
+} // namespace paimon
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+
+namespace paimon {
+
+// RingAllocator hands out ranges of a fixed size ring that are released in
+// allocation order, as the staging rings of the upload and readback queues
+// are when their fences retire. It only tracks offsets, the caller owns the
+// memory.
+class RingAllocator {
+public:
+  struct Allocation {
+    size_t offset = 0;
+    size_t size = 0;
+    size_t padding = 0; // bytes skipped at the end of the ring to wrap around
+  };
+
+  explicit RingAllocator(size_t capacity = 0) : m_capacity(capacity) {}
+
+  // Drops every allocation
+  void reset(size_t capacity);
+
+  // Nothing when the free space is fragmented or too small
+  std::optional<Allocation> allocate(size_t size);
+
+  // Must be called in allocation order
+  void release(const Allocation& allocation);
+
+  size_t getCapacity() const { return m_capacity; }
+  size_t getUsed() const { return m_used; }
+
+private:
+  size_t m_capacity = 0;
+  size_t m_head = 0;
+  size_t m_tail = 0;
+  size_t m_used = 0;
+};
+
+} // namespace paimon
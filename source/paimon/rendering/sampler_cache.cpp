@@ -0,0 +1,140 @@
+#include "paimon/rendering/sampler_cache.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "paimon/core/log_system.h"
+
+namespace paimon {
+
+namespace {
+
+constexpr std::array<GLenum, 6> MinFilters = {
+    GL_NEAREST,
+    GL_LINEAR,
+    GL_NEAREST_MIPMAP_NEAREST,
+    GL_LINEAR_MIPMAP_NEAREST,
+    GL_NEAREST_MIPMAP_LINEAR,
+    GL_LINEAR_MIPMAP_LINEAR,
+};
+
+constexpr std::array<GLenum, 2> MagFilters = {GL_NEAREST, GL_LINEAR};
+
+constexpr std::array<GLenum, 5> WrapModes = {
+    GL_REPEAT,
+    GL_MIRRORED_REPEAT,
+    GL_CLAMP_TO_EDGE,
+    GL_CLAMP_TO_BORDER,
+    GL_MIRROR_CLAMP_TO_EDGE,
+};
+
+constexpr std::array<GLenum, 8> CompareFuncs = {
+    GL_LEQUAL, GL_GEQUAL, GL_LESS,  GL_GREATER,
+    GL_EQUAL,  GL_NOTEQUAL, GL_ALWAYS, GL_NEVER,
+};
+
+// Index of a value in a table, unknown values map to the first entry
+template <size_t N>
+uint64_t indexOf(const std::array<GLenum, N>& table, GLenum value,
+                 const char* name) {
+  auto it = std::find(table.begin(), table.end(), value);
+  if (it == table.end()) {
+    LOG_WARN("SamplerCache: unsupported {} 0x{:X}", name, value);
+    return 0;
+  }
+  return static_cast<uint64_t>(it - table.begin());
+}
+
+} // namespace
+
+// Layout, from the least significant bit:
+//   minFilter 3 | magFilter 1 | wrapS 3 | wrapT 3 | wrapR 3 |
+//   anisotropy 5 | lodBias 16 | compareMode 1 | compareFunc 3
+uint64_t SamplerDescriptor::pack() const {
+  auto anisotropy = static_cast<uint64_t>(
+      std::clamp(std::lround(maxAnisotropy), 1L, 16L) - 1);
+  auto bias = static_cast<uint16_t>(static_cast<int16_t>(
+      std::clamp(std::lround(lodBias * 256.0f), -32768L, 32767L)));
+
+  uint64_t key = 0;
+  key |= indexOf(MinFilters, minFilter, "min filter");
+  key |= indexOf(MagFilters, magFilter, "mag filter") << 3;
+  key |= indexOf(WrapModes, wrapS, "wrap mode") << 4;
+  key |= indexOf(WrapModes, wrapT, "wrap mode") << 7;
+  key |= indexOf(WrapModes, wrapR, "wrap mode") << 10;
+  key |= anisotropy << 13;
+  key |= static_cast<uint64_t>(bias) << 18;
+  key |= static_cast<uint64_t>(compareMode == GL_COMPARE_REF_TO_TEXTURE) << 34;
+  key |= indexOf(CompareFuncs, compareFunc, "compare func") << 35;
+  return key;
+}
+
+SamplerDescriptor SamplerDescriptor::unpack(uint64_t key) {
+  SamplerDescriptor descriptor;
+  descriptor.minFilter = MinFilters[(key & 0x7) % MinFilters.size()];
+  descriptor.magFilter = MagFilters[(key >> 3) & 0x1];
+  descriptor.wrapS = WrapModes[((key >> 4) & 0x7) % WrapModes.size()];
+  descriptor.wrapT = WrapModes[((key >> 7) & 0x7) % WrapModes.size()];
+  descriptor.wrapR = WrapModes[((key >> 10) & 0x7) % WrapModes.size()];
+  descriptor.maxAnisotropy = static_cast<float>(((key >> 13) & 0x1F) + 1);
+  descriptor.lodBias =
+      static_cast<float>(static_cast<int16_t>((key >> 18) & 0xFFFF)) / 256.0f;
+  descriptor.compareMode =
+      ((key >> 34) & 0x1) ? GL_COMPARE_REF_TO_TEXTURE : GL_NONE;
+  descriptor.compareFunc = CompareFuncs[(key >> 35) & 0x7];
+  return descriptor;
+}
+
+SamplerDescriptor SamplerDescriptor::clampToEdge(GLenum minFilter,
+                                                 GLenum magFilter) {
+  SamplerDescriptor descriptor;
+  descriptor.minFilter = minFilter;
+  descriptor.magFilter = magFilter;
+  descriptor.wrapS = GL_CLAMP_TO_EDGE;
+  descriptor.wrapT = GL_CLAMP_TO_EDGE;
+  descriptor.wrapR = GL_CLAMP_TO_EDGE;
+  return descriptor;
+}
+
+std::shared_ptr<const Sampler>
+SamplerCache::get(const SamplerDescriptor& descriptor) {
+  auto key = descriptor.pack();
+
+  auto it = m_cache.find(key);
+  if (it != m_cache.end()) {
+    return it->second;
+  }
+
+  // Create from the normalized descriptor so equal keys mean equal samplers
+  std::shared_ptr<const Sampler> sampler =
+      createSampler(SamplerDescriptor::unpack(key));
+  m_cache.emplace(key, sampler);
+
+  LOG_DEBUG("Created sampler with key 0x{:X} (cache size: {})", key,
+            m_cache.size());
+  return sampler;
+}
+
+std::unique_ptr<Sampler>
+SamplerCache::createSampler(const SamplerDescriptor& descriptor) const {
+  auto sampler = std::make_unique<Sampler>();
+  sampler->set(GL_TEXTURE_MIN_FILTER, descriptor.minFilter);
+  sampler->set(GL_TEXTURE_MAG_FILTER, descriptor.magFilter);
+  sampler->set(GL_TEXTURE_WRAP_S, descriptor.wrapS);
+  sampler->set(GL_TEXTURE_WRAP_T, descriptor.wrapT);
+  sampler->set(GL_TEXTURE_WRAP_R, descriptor.wrapR);
+  if (descriptor.maxAnisotropy > 1.0f) {
+    sampler->set(GL_TEXTURE_MAX_ANISOTROPY, descriptor.maxAnisotropy);
+  }
+  if (descriptor.lodBias != 0.0f) {
+    sampler->set(GL_TEXTURE_LOD_BIAS, descriptor.lodBias);
+  }
+  if (descriptor.compareMode != GL_NONE) {
+    sampler->set(GL_TEXTURE_COMPARE_MODE, descriptor.compareMode);
+    sampler->set(GL_TEXTURE_COMPARE_FUNC, descriptor.compareFunc);
+  }
+  return sampler;
+}
+
+} // namespace paimon
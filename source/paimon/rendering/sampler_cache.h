@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+#include <glad/gl.h>
+
+#include "paimon/opengl/sampler.h"
+
+namespace paimon {
+
+// Sampler parameters, packed into a 64-bit key for the cache. Anisotropy is
+// quantized to whole steps and the LOD bias to 1/256.
+struct SamplerDescriptor {
+  GLenum minFilter = GL_LINEAR_MIPMAP_LINEAR;
+  GLenum magFilter = GL_LINEAR;
+  GLenum wrapS = GL_REPEAT;
+  GLenum wrapT = GL_REPEAT;
+  GLenum wrapR = GL_REPEAT;
+  float maxAnisotropy = 1.0f;
+  float lodBias = 0.0f;
+  GLenum compareMode = GL_NONE;
+  GLenum compareFunc = GL_LEQUAL;
+
+  uint64_t pack() const;
+  static SamplerDescriptor unpack(uint64_t key);
+
+  // Clamp-to-edge on all axes, used for render targets and cubemaps
+  static SamplerDescriptor clampToEdge(GLenum minFilter = GL_LINEAR,
+                                       GLenum magFilter = GL_LINEAR);
+};
+
+// SamplerCache hands out shared immutable sampler objects, one per distinct
+// descriptor, so materials and passes with equal settings share a GL sampler
+class SamplerCache {
+public:
+  SamplerCache() = default;
+  ~SamplerCache() = default;
+
+  // Delete copy constructor and assignment
+  SamplerCache(const SamplerCache&) = delete;
+  SamplerCache& operator=(const SamplerCache&) = delete;
+
+  std::shared_ptr<const Sampler> get(const SamplerDescriptor& descriptor);
+
+  // Get cache statistics
+  size_t getCacheSize() const { return m_cache.size(); }
+
+private:
+  std::unique_ptr<Sampler> createSampler(const SamplerDescriptor& descriptor) const;
+
+private:
+  std::unordered_map<uint64_t, std::shared_ptr<const Sampler>> m_cache;
+};
+
+} // namespace paimon
@@ -0,0 +1,142 @@
+#include "paimon/rendering/shader_archive.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+#include "paimon/core/log_system.h"
+
+using namespace paimon;
+
+namespace {
+
+constexpr uint32_t ArchiveMagic = 0x41534d50; // "PMSA"
+constexpr uint32_t ArchiveVersion = 1;
+
+struct ArchiveHeader {
+  uint32_t magic = ArchiveMagic;
+  uint32_t version = ArchiveVersion;
+  uint32_t entryCount = 0;
+  uint32_t reserved = 0;
+};
+
+struct ArchiveEntry {
+  uint64_t nameOffset = 0;
+  uint64_t sourceOffset = 0;
+  uint32_t nameLength = 0;
+  uint32_t sourceLength = 0;
+  uint32_t type = GL_INVALID_ENUM;
+  uint32_t reserved = 0;
+};
+
+} // namespace
+
+bool ShaderArchive::open(const std::filesystem::path &path) {
+  close();
+  if (!m_file.open(path)) {
+    return false;
+  }
+
+  const auto *data = m_file.data();
+  const auto size = m_file.size();
+
+  ArchiveHeader header;
+  if (size < sizeof(header)) {
+    LOG_ERROR("Shader archive is truncated: {}", path.string());
+    close();
+    return false;
+  }
+  std::memcpy(&header, data, sizeof(header));
+  if (header.magic != ArchiveMagic || header.version != ArchiveVersion ||
+      size < sizeof(header) + header.entryCount * sizeof(ArchiveEntry)) {
+    LOG_ERROR("Invalid shader archive: {}", path.string());
+    close();
+    return false;
+  }
+
+  const auto *table = data + sizeof(header);
+  m_entries.reserve(header.entryCount);
+  for (uint32_t i = 0; i < header.entryCount; ++i) {
+    ArchiveEntry entry;
+    std::memcpy(&entry, table + i * sizeof(ArchiveEntry), sizeof(entry));
+    if (entry.nameOffset + entry.nameLength > size ||
+        entry.sourceOffset + entry.sourceLength > size) {
+      LOG_ERROR("Invalid shader archive entry {} in {}", i, path.string());
+      close();
+      return false;
+    }
+
+    std::string_view name(reinterpret_cast<const char *>(data) +
+                              entry.nameOffset,
+                          entry.nameLength);
+    std::string_view source(reinterpret_cast<const char *>(data) +
+                                entry.sourceOffset,
+                            entry.sourceLength);
+    m_entries.emplace(name, Entry{source, entry.type});
+  }
+
+  LOG_INFO("Mapped {} shaders from {}", m_entries.size(), path.string());
+  return true;
+}
+
+void ShaderArchive::close() {
+  m_entries.clear();
+  m_file.close();
+}
+
+const ShaderArchive::Entry *ShaderArchive::find(std::string_view name) const {
+  auto it = m_entries.find(name);
+  return it != m_entries.end() ? &it->second : nullptr;
+}
+
+bool ShaderArchive::write(const std::filesystem::path &path,
+                          const std::vector<const ShaderSource *> &sources) {
+  ArchiveHeader header;
+  header.entryCount = static_cast<uint32_t>(sources.size());
+
+  // Names and sources follow the table in entry order
+  std::vector<ArchiveEntry> entries(sources.size());
+  uint64_t offset = sizeof(header) + entries.size() * sizeof(ArchiveEntry);
+  for (size_t i = 0; i < sources.size(); ++i) {
+    auto &entry = entries[i];
+    entry.type = sources[i]->type;
+    entry.nameOffset = offset;
+    entry.nameLength = static_cast<uint32_t>(sources[i]->name.size());
+    offset += entry.nameLength;
+    entry.sourceOffset = offset;
+    entry.sourceLength = static_cast<uint32_t>(sources[i]->source.size());
+    offset += entry.sourceLength;
+  }
+
+  auto temporary = path;
+  temporary += ".tmp";
+  {
+    std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(entries.data()),
+               static_cast<std::streamsize>(entries.size() *
+                                            sizeof(ArchiveEntry)));
+    for (const auto *source : sources) {
+      file.write(source->name.data(),
+                 static_cast<std::streamsize>(source->name.size()));
+      file.write(source->source.data(),
+                 static_cast<std::streamsize>(source->source.size()));
+    }
+    if (!file) {
+      LOG_ERROR("Failed to write shader archive: {}", temporary.string());
+      return false;
+    }
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(temporary, path, ec);
+  if (ec) {
+    LOG_ERROR("Failed to move shader archive into place: {}", ec.message());
+    std::filesystem::remove(temporary, ec);
+    return false;
+  }
+
+  LOG_INFO("Packed {} shaders into {} ({} KB)", sources.size(), path.string(),
+           offset / 1024);
+  return true;
+}
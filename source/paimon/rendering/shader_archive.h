@@ -0,0 +1,55 @@
+#pragma once
+
+#include <filesystem>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <glad/gl.h>
+
+#include "paimon/core/io/mapped_file.h"
+#include "paimon/rendering/shader_source.h"
+
+namespace paimon {
+
+// ShaderArchive packs preprocessed shader sources into a single file that is
+// memory mapped at startup. Opening it only reads the entry table, a source
+// is paged in when its shader is first used.
+//
+// Layout: header, entry table, then names and sources back to back. Offsets
+// are relative to the start of the file.
+class ShaderArchive {
+public:
+  struct Entry {
+    std::string_view source;
+    GLenum type = GL_INVALID_ENUM;
+  };
+
+  ShaderArchive() = default;
+
+  // Delete copy constructor and assignment
+  ShaderArchive(const ShaderArchive &) = delete;
+  ShaderArchive &operator=(const ShaderArchive &) = delete;
+
+  bool open(const std::filesystem::path &path);
+
+  void close();
+
+  bool isOpen() const { return m_file.isOpen(); }
+
+  // nullptr when the archive has no shader of that name
+  const Entry *find(std::string_view name) const;
+
+  size_t getEntryCount() const { return m_entries.size(); }
+
+  // Pack sources, written to a temporary file first so a running
+  // application never maps a partial archive
+  static bool write(const std::filesystem::path &path,
+                    const std::vector<const ShaderSource *> &sources);
+
+private:
+  MappedFile m_file;
+  std::unordered_map<std::string_view, Entry> m_entries;
+};
+
+} // namespace paimon
@@ -0,0 +1,227 @@
+#include "paimon/rendering/shader_compiler.h"
+
+#include <algorithm>
+
+#include "paimon/core/log_system.h"
+
+namespace paimon {
+
+ShaderCompiler::~ShaderCompiler() {
+  {
+    std::lock_guard lock(m_mutex);
+    m_stop = true;
+  }
+  m_condition.notify_all();
+  if (m_worker.joinable()) {
+    m_worker.join();
+  }
+}
+
+uint64_t ShaderCompiler::compile(GLenum type, std::string source,
+                                 bool retrievable, Callback callback) {
+  if (!m_initialized) {
+    initialize();
+  }
+
+  auto job = std::make_unique<Job>();
+  job->id = m_nextId++;
+  job->type = type;
+  job->source = std::move(source);
+  job->retrievable = retrievable;
+  job->callback = std::move(callback);
+  auto id = job->id;
+
+  if (m_parallel || !m_worker.joinable()) {
+    // Returns right away with parallel compile, without a worker this is
+    // where the GL thread blocks
+    job->start = std::chrono::steady_clock::now();
+    auto *times = m_parallel ? nullptr : &job->times;
+    job->program = std::make_unique<ShaderProgram>(job->type, job->source,
+                                                   job->retrievable, times);
+    m_inFlight.push_back(std::move(job));
+    return id;
+  }
+
+  {
+    std::lock_guard lock(m_mutex);
+    m_toCompile.push_back(std::move(job));
+  }
+  m_condition.notify_all();
+  return id;
+}
+
+void ShaderCompiler::update() {
+  // Poll driver compiles, any order may complete first
+  for (size_t i = 0; i < m_inFlight.size();) {
+    if (!m_inFlight[i]->program->is_completed()) {
+      ++i;
+      continue;
+    }
+    auto job = std::move(m_inFlight[i]);
+    m_inFlight.erase(m_inFlight.begin() + static_cast<ptrdiff_t>(i));
+    deliver(*job);
+  }
+
+  std::deque<std::unique_ptr<Job>> compiled;
+  {
+    std::lock_guard lock(m_mutex);
+    compiled.swap(m_compiled);
+  }
+  for (auto &job : compiled) {
+    job->callback(std::move(job->program), job->times);
+  }
+}
+
+void ShaderCompiler::wait(uint64_t id) {
+  auto inFlight = std::ranges::find_if(
+      m_inFlight, [id](const auto &job) { return job->id == id; });
+  if (inFlight != m_inFlight.end()) {
+    // Status queries block until the driver is done
+    auto job = std::move(*inFlight);
+    m_inFlight.erase(inFlight);
+    deliver(*job);
+    return;
+  }
+
+  std::unique_ptr<Job> job;
+  {
+    std::unique_lock lock(m_mutex);
+    auto hasId = [id](const auto &entry) { return entry->id == id; };
+    auto queued = std::ranges::find_if(m_toCompile, hasId);
+    if (queued != m_toCompile.end()) {
+      // Not started yet, faster to build it here than to wait in line
+      job = std::move(*queued);
+      m_toCompile.erase(queued);
+    } else {
+      m_condition.wait(lock, [&] { return m_compiling != id; });
+      auto compiled = std::ranges::find_if(m_compiled, hasId);
+      if (compiled == m_compiled.end()) {
+        return; // already delivered
+      }
+      job = std::move(*compiled);
+      m_compiled.erase(compiled);
+    }
+  }
+
+  if (!job->program) {
+    build(*job);
+  }
+  job->callback(std::move(job->program), job->times);
+}
+
+void ShaderCompiler::waitAll() {
+  auto inFlight = std::move(m_inFlight);
+  m_inFlight.clear();
+  for (auto &job : inFlight) {
+    deliver(*job);
+  }
+
+  std::deque<std::unique_ptr<Job>> queued;
+  std::deque<std::unique_ptr<Job>> compiled;
+  {
+    std::unique_lock lock(m_mutex);
+    queued.swap(m_toCompile);
+    m_condition.wait(lock, [this] { return m_compiling == 0; });
+    compiled.swap(m_compiled);
+  }
+  for (auto &job : compiled) {
+    job->callback(std::move(job->program), job->times);
+  }
+  for (auto &job : queued) {
+    build(*job);
+    job->callback(std::move(job->program), job->times);
+  }
+}
+
+size_t ShaderCompiler::getPendingCount() const {
+  std::lock_guard lock(m_mutex);
+  return m_inFlight.size() + m_toCompile.size() + (m_compiling != 0 ? 1 : 0) +
+         m_compiled.size();
+}
+
+bool ShaderCompiler::isParallel() {
+  if (!m_initialized) {
+    initialize();
+  }
+  return m_parallel;
+}
+
+void ShaderCompiler::initialize() {
+  m_initialized = true;
+
+  if (GLAD_GL_KHR_parallel_shader_compile) {
+    // Let the driver pick as many threads as it supports
+    glMaxShaderCompilerThreadsKHR(0xFFFFFFFFu);
+    m_parallel = true;
+    LOG_INFO("ShaderCompiler: using GL_KHR_parallel_shader_compile");
+    return;
+  }
+
+  // Creating a context makes it current once on this thread, leaving none
+  // current afterwards, so the GL thread context is made current again
+  auto current = Context::getCurrent();
+  if (current) {
+    m_workerContext = Context::create(*current);
+    current->makeCurrent();
+  }
+  if (!m_workerContext || !m_workerContext->valid()) {
+    LOG_WARN("ShaderCompiler: failed to create a shared context, compiling "
+             "on the GL thread");
+    m_workerContext.reset();
+    return;
+  }
+
+  m_worker = std::thread(&ShaderCompiler::workerLoop, this);
+  LOG_INFO("ShaderCompiler: compiling on a worker thread");
+}
+
+void ShaderCompiler::build(Job &job) {
+  // Blocks on the compile and the link, each step is timed
+  job.program = std::make_unique<ShaderProgram>(job.type, job.source,
+                                                job.retrievable, &job.times);
+}
+
+void ShaderCompiler::deliver(Job &job) {
+  // Polled once per frame, a parallel compile may have finished up to a
+  // frame earlier
+  job.program->is_linked(); // wait for the driver
+  job.times.totalMs = std::chrono::duration<double, std::milli>(
+                          std::chrono::steady_clock::now() - job.start)
+                          .count();
+  job.callback(std::move(job.program), job.times);
+}
+
+void ShaderCompiler::workerLoop() {
+  m_workerContext->makeCurrent();
+
+  while (true) {
+    std::unique_ptr<Job> job;
+    {
+      std::unique_lock lock(m_mutex);
+      m_condition.wait(lock,
+                       [this] { return m_stop || !m_toCompile.empty(); });
+      if (m_stop) {
+        break;
+      }
+      job = std::move(m_toCompile.front());
+      m_toCompile.pop_front();
+      m_compiling = job->id;
+    }
+
+    build(*job);
+    // The program is used from the GL thread context, make sure every
+    // command touching it has executed
+    glFinish();
+
+    {
+      std::lock_guard lock(m_mutex);
+      m_compiled.push_back(std::move(job));
+      m_compiling = 0;
+    }
+    m_condition.notify_all();
+  }
+
+  m_workerContext->doneCurrent();
+}
+
+} // namespace paimon
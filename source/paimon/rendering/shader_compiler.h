@@ -0,0 +1,102 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <glad/gl.h>
+
+#include "paimon/opengl/shader_program.h"
+#include "paimon/platform/context.h"
+
+namespace paimon {
+
+// ShaderCompiler builds shader programs off the critical path. With
+// GL_KHR_parallel_shader_compile the driver compiles on its own threads and
+// completion is polled, otherwise a worker thread compiles on a context
+// shared with the GL thread.
+class ShaderCompiler {
+public:
+  // Receives the program and the wall time its build took. Compile and link
+  // are timed apart unless the driver compiled in parallel, waiting on each
+  // step would serialize its threads.
+  using Callback = std::function<void(std::unique_ptr<ShaderProgram>,
+                                      const ShaderBuildTimes &times)>;
+
+  ShaderCompiler() = default;
+  ~ShaderCompiler();
+
+  // Delete copy constructor and assignment
+  ShaderCompiler(const ShaderCompiler &) = delete;
+  ShaderCompiler &operator=(const ShaderCompiler &) = delete;
+
+  // Start compiling a program, the callback runs on the GL thread from
+  // update() or wait() once it is linked or has failed. Returns a job id.
+  uint64_t compile(GLenum type, std::string source, bool retrievable,
+                   Callback callback);
+
+  // Deliver finished programs, call once per frame on the GL thread
+  void update();
+
+  // Finish one job now, compiling it on the GL thread if no one started it
+  void wait(uint64_t id);
+
+  // Finish every job
+  void waitAll();
+
+  // Number of jobs whose callback has not run yet
+  size_t getPendingCount() const;
+
+  // True when the driver compiles in parallel by itself
+  bool isParallel();
+
+private:
+  struct Job {
+    uint64_t id = 0;
+    GLenum type = GL_NONE;
+    std::string source;
+    bool retrievable = false;
+    Callback callback;
+    std::unique_ptr<ShaderProgram> program;
+    // Driver compiles are timed from submission to completion
+    std::chrono::steady_clock::time_point start;
+    ShaderBuildTimes times;
+  };
+
+  void initialize();
+
+  // Build the program and wait for the link, used by the worker and wait()
+  static void build(Job &job);
+
+  // Time a finished driver compile and run the callback
+  static void deliver(Job &job);
+
+  void workerLoop();
+
+private:
+  bool m_initialized = false;
+  bool m_parallel = false;
+  uint64_t m_nextId = 1;
+
+  // GL thread only, driver compiles polled with GL_COMPLETION_STATUS_KHR
+  std::deque<std::unique_ptr<Job>> m_inFlight;
+
+  // Worker fallback, the shared context is created and destroyed on the GL
+  // thread and only current on the worker
+  std::unique_ptr<Context> m_workerContext;
+  mutable std::mutex m_mutex;
+  std::condition_variable m_condition;
+  std::deque<std::unique_ptr<Job>> m_toCompile;
+  std::deque<std::unique_ptr<Job>> m_compiled;
+  uint64_t m_compiling = 0; // id of the job on the worker, 0 when idle
+  bool m_stop = false;
+  std::thread m_worker;
+};
+
+} // namespace paimon
@@ -1,20 +1,96 @@
 #include "paimon/rendering/shader_includer.h"
 
 #include <algorithm>
-#include <regex>
+#include <cctype>
+#include <charconv>
+#include <format>
+#include <optional>
 
-#include "paimon/core/macro.h"
 #include "paimon/core/io/file.h"
 #include "paimon/core/log_system.h"
 
 using namespace paimon;
 
+namespace {
+
+std::string_view trimLeft(std::string_view text) {
+  auto begin = text.find_first_not_of(" \t\r");
+  return begin == std::string_view::npos ? std::string_view{}
+                                         : text.substr(begin);
+}
+
+struct Directive {
+  std::string_view name; // e.g. "include", without the '#'
+  std::string_view rest; // arguments, leading whitespace removed
+};
+
+// Preprocessor directive of a line, nullopt for any other line
+std::optional<Directive> parseDirective(std::string_view line) {
+  line = trimLeft(line);
+  if (line.empty() || line.front() != '#') {
+    return std::nullopt;
+  }
+  line = trimLeft(line.substr(1));
+
+  size_t length = 0;
+  while (length < line.size() &&
+         (std::isalnum(static_cast<unsigned char>(line[length])) ||
+          line[length] == '_')) {
+    ++length;
+  }
+  return Directive{line.substr(0, length), trimLeft(line.substr(length))};
+}
+
+// File name of "file" or <file>, only a comment may follow
+std::optional<std::string_view> parseIncludePath(std::string_view rest) {
+  if (rest.empty() || (rest.front() != '"' && rest.front() != '<')) {
+    return std::nullopt;
+  }
+  char close = rest.front() == '"' ? '"' : '>';
+  auto end = rest.find(close, 1);
+  if (end == std::string_view::npos || end == 1) {
+    return std::nullopt;
+  }
+  auto tail = trimLeft(rest.substr(end + 1));
+  if (!tail.empty() && !tail.starts_with("//")) {
+    return std::nullopt;
+  }
+  return rest.substr(1, end - 1);
+}
+
+bool isWord(std::string_view rest, std::string_view word) {
+  return rest.starts_with(word) &&
+         (rest.size() == word.size() || rest[word.size()] == ' ' ||
+          rest[word.size()] == '\t' || rest[word.size()] == '\r' ||
+          rest[word.size()] == '/');
+}
+
+// Calls visit(line, next, number) for every line, next is the offset of the
+// following line. Returning false stops the scan.
+template <class Visitor>
+void forEachLine(std::string_view source, Visitor &&visit) {
+  size_t offset = 0;
+  int number = 0;
+  while (offset < source.size()) {
+    auto end = source.find('\n', offset);
+    auto next = end == std::string_view::npos ? source.size() : end + 1;
+    auto line = source.substr(offset, std::min(end, source.size()) - offset);
+    if (!visit(line, next, ++number)) {
+      return;
+    }
+    offset = next;
+  }
+}
+
+} // namespace
+
 void ShaderIncluder::addSearchPath(const std::filesystem::path &path) {
   auto absPath = std::filesystem::absolute(path);
   if (!std::filesystem::exists(absPath)) {
     LOG_WARN("Include path does not exist: {}", absPath.string());
   }
   m_searchPaths.push_back(absPath);
+  m_resolved.clear();
 }
 
 void ShaderIncluder::process(std::string &source) {
@@ -22,93 +98,205 @@ void ShaderIncluder::process(std::string &source) {
   m_includedFiles.clear();
   m_processingStack.clear();
 
-  resolveIncludes(source);
+  auto tokens = tokenize(source, false);
+  if (tokens.segments.size() == 1) {
+    return; // nothing to include
+  }
+
+  // #line may not precede #version, shaders including files before it do
+  // without markers
+  m_lineMarkers = tokens.versionFirst;
+
+  std::string output;
+  output.reserve(source.size() * 4);
+  expand(tokens, 0, output);
+  source = std::move(output);
 }
 
-void ShaderIncluder::resolveIncludes(std::string &source) {
-  // Regex to match #include "file" or #include <file>
-#ifdef PAIMON_OS_WINDOWS
-  // MSVC doesn't support std::regex_constants::multiline
-  static const std::regex includePattern(
-      R"(^\s*#include\s+([<"])([^>"]+)([>"])\s*(?://.*)?$)");
-#endif
-#ifdef PAIMON_OS_UNIX
-  static const std::regex includePattern(
-      R"(^\s*#include\s+([<"])([^>"]+)([>"])\s*(?://.*)?$)",
-      std::regex_constants::multiline);
-#endif
-
-  // Process all includes
-  std::smatch match;
-  while (std::regex_search(source, match, includePattern)) {
-    // match[1] = opening delimiter (" or <)
-    // match[2] = file path
-    // match[3] = closing delimiter (" or >)
-    std::string includeFile = match[2].str();
-
-    // Resolve the include path: search in all include paths
-    std::filesystem::path filePath(includeFile);
-    std::filesystem::path resolvedPath;
-
-    // Try include paths
-    auto found = std::find_if(
-        m_searchPaths.begin(), m_searchPaths.end(),
-        [&](const std::filesystem::path &searchPath) {
-          auto fullPath = searchPath / filePath;
-          if (std::filesystem::exists(fullPath)) {
-            resolvedPath = std::filesystem::canonical(fullPath);
-            return true;
-          }
-          return false;
-        });
-
-    if (found == m_searchPaths.end()) {
-      LOG_ERROR("Included file not found: {}", includeFile);
-      return;
+bool ShaderIncluder::findVersion(std::string_view source, size_t &offset,
+                                 int &line) {
+  bool found = false;
+  forEachLine(source, [&](std::string_view text, size_t next, int number) {
+    auto directive = parseDirective(text);
+    if (directive && directive->name == "version") {
+      offset = next;
+      line = number;
+      found = true;
+    }
+    return !found;
+  });
+  return found;
+}
+
+ShaderIncluder::TokenizedFile ShaderIncluder::tokenize(std::string_view source,
+                                                       bool isInclude) {
+  TokenizedFile file;
+  Segment segment;
+  int lineNumber = 0;
+
+  forEachLine(source, [&](std::string_view line, size_t next, int) {
+    ++lineNumber;
+    auto raw = source.substr(line.data() - source.data(),
+                             next - (line.data() - source.data()));
+
+    auto directive = parseDirective(line);
+    if (!directive) {
+      segment.text += raw;
+      return true;
+    }
+
+    if (directive->name == "include") {
+      if (auto include = parseIncludePath(directive->rest)) {
+        segment.include = *include;
+        segment.nextLine = lineNumber + 1;
+        file.segments.push_back(std::move(segment));
+        segment = {};
+        return true;
+      }
+      LOG_WARN("Malformed #include directive: {}", line);
+    } else if (directive->name == "pragma" &&
+               isWord(directive->rest, "once")) {
+      // Files are included once anyway, keep the line count
+      segment.text += '\n';
+      return true;
+    } else if (directive->name == "version") {
+      if (isInclude) {
+        LOG_WARN("Ignoring #version in an included file");
+        segment.text += '\n';
+        return true;
+      }
+      file.versionFirst = file.segments.empty();
+    } else if (directive->name == "line") {
+      // Following lines are numbered from the given one
+      int number = 0;
+      auto [end, error] = std::from_chars(
+          directive->rest.data(),
+          directive->rest.data() + directive->rest.size(), number);
+      if (error == std::errc()) {
+        lineNumber = number - 1;
+      }
+    }
+
+    segment.text += raw;
+    return true;
+  });
+
+  segment.nextLine = lineNumber + 1;
+  file.segments.push_back(std::move(segment));
+  return file;
+}
+
+void ShaderIncluder::expand(const TokenizedFile &file, int sourceIndex,
+                            std::string &output) {
+  for (const auto &segment : file.segments) {
+    output += segment.text;
+    if (segment.include.empty()) {
+      continue;
+    }
+    if (!output.empty() && output.back() != '\n') {
+      output += '\n';
+    }
+
+    auto resolvedPath = resolve(segment.include);
+    if (resolvedPath.empty()) {
+      LOG_ERROR("Included file not found: {}", segment.include);
+      output += "// [Include not found: " + segment.include + "]\n";
+      continue;
     }
 
     // Check for circular includes
     if (std::find(m_processingStack.begin(), m_processingStack.end(),
                   resolvedPath) != m_processingStack.end()) {
       LOG_ERROR("Circular include detected: {}", resolvedPath.string());
-      return;
+      output += "// [Circular include: " + segment.include + "]\n";
+      continue;
+    }
+
+    // Check if already included (include guard), one line replaces another
+    if (m_includedFiles.contains(resolvedPath)) {
+      output += "// [Already included: " + resolvedPath.filename().string() +
+                "]\n";
+      continue;
+    }
+
+    const auto *cached = load(resolvedPath);
+    if (!cached) {
+      LOG_ERROR("Failed to read included file: {}", resolvedPath.string());
+      output += "// [Include not readable: " + segment.include + "]\n";
+      continue;
     }
 
-    // Check if already included (include guard)
-    std::string replacement;
-    if (m_includedFiles.find(resolvedPath) != m_includedFiles.end()) {
-      replacement =
-          "// [Already included: " + resolvedPath.filename().string() + "]";
+    m_includedFiles.insert(resolvedPath);
+    m_processingStack.push_back(resolvedPath);
+
+    if (m_lineMarkers) {
+      output += std::format("#line 1 {} // {}\n", cached->sourceIndex,
+                            segment.include);
     } else {
-      // Mark as included
-      m_includedFiles.insert(resolvedPath);
+      output += "// --- Begin include: " + segment.include + " ---\n";
+    }
 
-      // Add to processing stack
-      m_processingStack.push_back(resolvedPath);
+    // The entry stays valid, std::map nodes do not move on insertion
+    expand(cached->tokens, cached->sourceIndex, output);
+    if (!output.empty() && output.back() != '\n') {
+      output += '\n';
+    }
 
-      // Read the included file
-      std::string includeSource = File::readText(resolvedPath);
-      if (includeSource.empty()) {
-        LOG_ERROR("Failed to read included file: {}", resolvedPath.string());
-        return;
-      }
+    if (m_lineMarkers) {
+      output += std::format("#line {} {}\n", segment.nextLine, sourceIndex);
+    } else {
+      output += "// --- End include: " + segment.include + " ---\n";
+    }
 
-      // Recursively process the included file
-      resolveIncludes(includeSource);
+    m_processingStack.pop_back();
+  }
+}
 
-      // Build replacement with comments
-      replacement =
-          "// --- Begin include: " + includeFile + " ---\n" + includeSource;
-      if (!includeSource.empty() && includeSource.back() != '\n') {
-        replacement += "\n";
-      }
-      replacement += "// --- End include: " + includeFile + " ---";
+std::filesystem::path ShaderIncluder::resolve(const std::string &include) {
+  auto it = m_resolved.find(include);
+  if (it != m_resolved.end()) {
+    return it->second;
+  }
 
-      // Remove from processing stack
-      m_processingStack.pop_back();
+  // Try include paths
+  std::filesystem::path filePath(include);
+  for (const auto &searchPath : m_searchPaths) {
+    std::error_code ec;
+    auto fullPath = searchPath / filePath;
+    if (std::filesystem::exists(fullPath, ec)) {
+      auto resolvedPath = std::filesystem::canonical(fullPath, ec);
+      m_resolved.emplace(include, resolvedPath);
+      return resolvedPath;
     }
+  }
+  return {};
+}
+
+const ShaderIncluder::CachedFile *
+ShaderIncluder::load(const std::filesystem::path &path) {
+  std::error_code ec;
+  auto mtime = std::filesystem::last_write_time(path, ec);
+  if (ec) {
+    // Removed or renamed, look it up again next time
+    std::erase_if(m_resolved,
+                  [&](const auto &entry) { return entry.second == path; });
+    return nullptr;
+  }
+
+  auto [it, inserted] = m_files.try_emplace(path);
+  auto &cached = it->second;
+  if (inserted) {
+    cached.sourceIndex = m_nextSourceIndex++;
+  } else if (cached.mtime == mtime) {
+    return &cached;
+  }
 
-    // Replace the #include directive with the processed content
-    source.replace(match.position(), match.length(), replacement);
+  std::string source = File::readText(path);
+  if (source.empty()) {
+    m_files.erase(it);
+    return nullptr;
   }
+  cached.mtime = mtime;
+  cached.tokens = tokenize(source, true);
+  return &cached;
 }
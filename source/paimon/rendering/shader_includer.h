@@ -1,15 +1,21 @@
 #pragma once
 
 #include <filesystem>
+#include <map>
 #include <set>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace paimon {
 
 /**
  * @brief GLSL Shader Include Processor
- * Resolves #include directives in GLSL shaders.
+ * Resolves #include directives in GLSL shaders with a single pass line
+ * tokenizer. Every file is included once per shader, #pragma once lines are
+ * dropped and #line markers keep compiler errors pointing at the right file
+ * and line. Tokenized include files are cached until they change on disk.
  */
 class ShaderIncluder {
 public:
@@ -31,17 +37,87 @@ public:
    */
   void process(std::string &source);
 
+  /**
+   * @brief Get the files included by the last processed shader
+   * @return Canonical paths of the included files
+   */
+  const std::set<std::filesystem::path> &getIncludedFiles() const {
+    return m_includedFiles;
+  }
+
+  /**
+   * @brief Locate the #version directive of a shader
+   * @param source Shader source code
+   * @param offset Set to the offset just past the directive line
+   * @param line Set to the line number of the directive
+   * @return False when the source has no #version directive
+   */
+  static bool findVersion(std::string_view source, size_t &offset, int &line);
+
 private:
+  /// Source lines up to an #include directive
+  struct Segment {
+    std::string text;    ///< Lines before the directive
+    std::string include; ///< Included file, empty for the last segment
+    int nextLine = 0;    ///< Line number following the directive
+  };
+
+  /// Source split at its #include directives
+  struct TokenizedFile {
+    std::vector<Segment> segments;
+    bool versionFirst = false; ///< #version precedes every #include
+  };
+
+  /// Tokenized include file, valid while the file is unchanged
+  struct CachedFile {
+    std::filesystem::file_time_type mtime;
+    int sourceIndex = 0; ///< Source string number used in #line markers
+    TokenizedFile tokens;
+  };
+
   /**
-   * @brief Resolve all #include directives in the source code
-   * @param source Source code to process (will be modified in place)
+   * @brief Split source into segments at its #include directives
+   * @param source Source code to tokenize
+   * @param isInclude Whether the source is an included file
    */
-  void resolveIncludes(std::string &source);
+  static TokenizedFile tokenize(std::string_view source, bool isInclude);
+
+  /**
+   * @brief Append a tokenized file with its includes expanded
+   * @param file Tokenized file
+   * @param sourceIndex Source string number of the file
+   * @param output Destination of the expanded source
+   */
+  void expand(const TokenizedFile &file, int sourceIndex, std::string &output);
+
+  /**
+   * @brief Find an included file in the search paths
+   * @param include Included name as written in the directive
+   * @return Canonical path, empty when not found
+   */
+  std::filesystem::path resolve(const std::string &include);
+
+  /**
+   * @brief Get a tokenized include file, reading it only when it changed
+   * @param path Canonical path of the file
+   * @return Cache entry, nullptr when the file cannot be read
+   */
+  const CachedFile *load(const std::filesystem::path &path);
 
 private:
   /// Search paths for #include directives
   std::vector<std::filesystem::path> m_searchPaths;
 
+  /// Resolved paths of included names
+  std::unordered_map<std::string, std::filesystem::path> m_resolved;
+
+  /// Tokenized include files keyed by canonical path
+  std::map<std::filesystem::path, CachedFile> m_files;
+  int m_nextSourceIndex = 1; ///< 0 is the shader itself
+
+  /// Whether #line markers are emitted for the current shader
+  bool m_lineMarkers = false;
+
   /// Set of already included files (for include guards)
   std::set<std::filesystem::path> m_includedFiles;
 
@@ -1,16 +1,47 @@
 #include "paimon/rendering/shader_manager.h"
 
 #include <algorithm>
+#include <optional>
 #include <unordered_map>
 
 #include <glad/gl.h>
 
+#include "paimon/core/hash.h"
 #include "paimon/core/io/file.h"
 #include "paimon/core/log_system.h"
 #include "paimon/rendering/shader_source.h"
 
 using namespace paimon;
 
+namespace {
+
+// Shader stage of a file from its extension, nullopt for other files. Generic
+// .glsl files have no stage, their type must be specified later.
+std::optional<GLenum> getShaderType(const std::filesystem::path &filePath) {
+  auto extension = filePath.extension().string();
+  std::transform(extension.begin(), extension.end(), extension.begin(),
+                 ::tolower);
+
+  // Determine shader type from extension using a lookup table
+  static const std::unordered_map<std::string, GLenum> extToType = {
+      {".vert", GL_VERTEX_SHADER},
+      {".frag", GL_FRAGMENT_SHADER},
+      {".geom", GL_GEOMETRY_SHADER},
+      {".comp", GL_COMPUTE_SHADER},
+      {".tesc", GL_TESS_CONTROL_SHADER},
+      {".tese", GL_TESS_EVALUATION_SHADER},
+      {".glsl", GL_INVALID_ENUM} // Generic GLSL, type must be specified later
+  };
+
+  auto it = extToType.find(extension);
+  if (it == extToType.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+} // namespace
+
 ShaderManager::ShaderManager() {}
 
 void ShaderManager::load(const std::filesystem::path &directory) {
@@ -25,60 +56,212 @@ void ShaderManager::load(const std::filesystem::path &directory) {
   }
 
   auto absDirectory = std::filesystem::absolute(directory);
-  LOG_INFO("Loading shaders from: {}", absDirectory.string());
+  LOG_INFO("Indexing shaders in: {}", absDirectory.string());
 
   // Add directory to include paths for shader preprocessing
   m_includer.addSearchPath(absDirectory);
+  m_directories.push_back(absDirectory);
+  if (m_watcher) {
+    m_watcher->watch(absDirectory);
+  }
 
   for (const auto &entry :
         std::filesystem::recursive_directory_iterator(absDirectory)) {
-    if (entry.is_regular_file()) {
-      loadShaderFile(entry.path());
+    if (!entry.is_regular_file()) {
+      continue;
     }
+    auto type = getShaderType(entry.path());
+    if (!type) {
+      continue;
+    }
+
+    // Store with filename as key
+    m_index.emplace(entry.path().filename().string(),
+                    IndexEntry{entry.path(), *type, entry.last_write_time()});
   }
 }
 
+bool ShaderManager::loadArchive(const std::filesystem::path &path) {
+  return m_archive.open(path);
+}
+
+bool ShaderManager::writeArchive(const std::filesystem::path &path) {
+  std::vector<std::string> names;
+  names.reserve(m_index.size());
+  for (const auto &[name, entry] : m_index) {
+    names.push_back(name);
+  }
+  std::sort(names.begin(), names.end());
+
+  std::vector<const ShaderSource *> sources;
+  sources.reserve(names.size());
+  for (const auto &name : names) {
+    sources.push_back(getShaderSource(name));
+  }
+  return ShaderArchive::write(path, sources);
+}
+
+const ShaderSource* ShaderManager::getShaderSource(const std::string &name) {
+  auto it = m_shaderSources.find(name);
+  if (it != m_shaderSources.end()) {
+    return &it->second;
+  }
+
+  auto indexed = m_index.find(name);
+  if (indexed != m_index.end()) {
+    return &loadShaderFile(name, indexed->second);
+  }
+
+  if (const auto *packed = m_archive.find(name)) {
+    // Archived sources are preprocessed already
+    ShaderSource src{name, std::string(packed->source), packed->type,
+                     hashFnv1a(packed->source)};
+    return &m_shaderSources.emplace(name, std::move(src)).first->second;
+  }
+
+  return nullptr;
+}
+
 ShaderProgram* ShaderManager::createShaderProgram(const std::string &name,
                                             const std::vector<ShaderDefine>& defines) {
-  return m_shaderProgramCache.get(m_shaderSources.at(name), defines);
+  const auto *source = getShaderSource(name);
+  if (!source) {
+    LOG_ERROR("Unknown shader: {}", name);
+    return nullptr;
+  }
+  return m_shaderProgramCache.get(*source, defines);
 }
 
-void ShaderManager::loadShaderFile(const std::filesystem::path &filePath) {
-  // Check if it's a shader file (common extensions)
-  auto extension = filePath.extension().string();
-  std::transform(extension.begin(), extension.end(), extension.begin(),
-                 ::tolower);
+ShaderProgram* ShaderManager::createShaderProgram(const std::string &name,
+                                                  std::string_view defineBlock) {
+  const auto *source = getShaderSource(name);
+  if (!source) {
+    LOG_ERROR("Unknown shader: {}", name);
+    return nullptr;
+  }
+  return m_shaderProgramCache.get(*source, defineBlock);
+}
+
+ShaderProgramHandle ShaderManager::createShaderProgramAsync(
+    const std::string &name, const std::vector<ShaderDefine> &defines) {
+  const auto *source = getShaderSource(name);
+  if (!source) {
+    LOG_ERROR("Unknown shader: {}", name);
+    return {};
+  }
+  return m_shaderProgramCache.getAsync(*source, defines);
+}
+
+ShaderProgramHandle
+ShaderManager::createShaderProgramAsync(const std::string &name,
+                                        std::string_view defineBlock) {
+  const auto *source = getShaderSource(name);
+  if (!source) {
+    LOG_ERROR("Unknown shader: {}", name);
+    return {};
+  }
+  return m_shaderProgramCache.getAsync(*source, defineBlock);
+}
+
+std::vector<ShaderProgramHandle> ShaderManager::precompileShaderPrograms(
+    const std::string &name,
+    const std::vector<std::vector<ShaderDefine>> &variants) {
+  const auto *source = getShaderSource(name);
+  if (!source) {
+    LOG_ERROR("Unknown shader: {}", name);
+    return {};
+  }
+  std::vector<ShaderVariant> shaderVariants;
+  shaderVariants.reserve(variants.size());
+  for (const auto &defines : variants) {
+    shaderVariants.push_back({*source, defines});
+  }
+  return m_shaderProgramCache.precompile(shaderVariants);
+}
 
-  static const std::vector<std::string> shaderExtensions = {
-      ".vert", ".frag", ".geom", ".comp", ".tesc", ".tese", ".glsl"};
+void ShaderManager::update() {
+  if (m_watcher) {
+    auto files = m_watcher->poll();
+    if (!files.empty()) {
+      reload(files);
+    }
+  }
+  m_shaderProgramCache.update();
+}
 
-  if (std::find(shaderExtensions.begin(), shaderExtensions.end(), extension) ==
-      shaderExtensions.end()) {
+void ShaderManager::enableHotReload() {
+  if (m_watcher) {
     return;
   }
+  m_watcher = std::make_unique<ShaderWatcher>();
+  for (const auto &directory : m_directories) {
+    m_watcher->watch(directory);
+  }
+  LOG_INFO("Shader hot-reload enabled for {} directories",
+           m_directories.size());
+}
 
+void ShaderManager::reload(const std::vector<std::filesystem::path> &files) {
+  // Shader files created since the directory was indexed
+  for (const auto &file : files) {
+    auto type = getShaderType(file);
+    auto name = file.filename().string();
+    if (type && !m_index.contains(name)) {
+      std::error_code ec;
+      auto mtime = std::filesystem::last_write_time(file, ec);
+      m_index.emplace(name, IndexEntry{file, *type, mtime});
+      LOG_INFO("Indexed new shader: {}", name);
+    }
+  }
+
+  std::vector<std::string> affected;
+  for (const auto &[name, dependencies] : m_dependencies) {
+    for (const auto &file : files) {
+      if (dependencies.contains(file)) {
+        affected.push_back(name);
+        break;
+      }
+    }
+  }
+
+  for (const auto &name : affected) {
+    auto indexed = m_index.find(name);
+    if (indexed == m_index.end()) {
+      continue;
+    }
+    std::error_code ec;
+    indexed->second.mtime =
+        std::filesystem::last_write_time(indexed->second.path, ec);
+    const auto &source = loadShaderFile(name, indexed->second);
+    m_shaderProgramCache.reload(source);
+  }
+}
+
+void ShaderManager::finish() { m_shaderProgramCache.finish(); }
+
+void ShaderManager::enableProgramBinaryCache(
+    const std::filesystem::path &directory, uintmax_t maxSize) {
+  m_shaderProgramCache.setBinaryCache(
+      std::make_unique<ProgramBinaryCache>(directory, maxSize));
+}
+
+const ShaderSource& ShaderManager::loadShaderFile(const std::string &name,
+                                                  const IndexEntry &entry) {
   // Read the shader source
-  std::string source = File::readText(filePath);
+  std::string source = File::readText(entry.path);
 
   // Resolve includes
   m_includer.process(source);
 
-  // Determine shader type from extension using a lookup table
-  static const std::unordered_map<std::string, GLenum> extToType = {
-      {".vert", GL_VERTEX_SHADER},
-      {".frag", GL_FRAGMENT_SHADER},
-      {".geom", GL_GEOMETRY_SHADER},
-      {".comp", GL_COMPUTE_SHADER},
-      {".tesc", GL_TESS_CONTROL_SHADER},
-      {".tese", GL_TESS_EVALUATION_SHADER},
-      {".glsl", GL_INVALID_ENUM} // Generic GLSL, type must be specified later
-  };
-
-  auto it = extToType.find(extension);
-  GLenum shaderType = (it != extToType.end()) ? it->second : GL_FRAGMENT_SHADER;
+  // Record what the source depends on, hot-reload matches changed files
+  // against it
+  std::error_code ec;
+  auto &dependencies = m_dependencies[name];
+  dependencies = m_includer.getIncludedFiles();
+  dependencies.insert(std::filesystem::weakly_canonical(entry.path, ec));
 
-  // Store with filename as key
-  std::string filename = filePath.filename().string();
-  ShaderSource src{filename, std::move(source), shaderType};
-  m_shaderSources.emplace(filename, std::move(src));
+  // Hashed once, program variants are keyed by it
+  uint64_t hash = hashFnv1a(source);
+  ShaderSource src{name, std::move(source), entry.type, hash};
+  return m_shaderSources.insert_or_assign(name, std::move(src)).first->second;
 }
@@ -1,12 +1,20 @@
 #pragma once
 
 #include <filesystem>
+#include <memory>
+#include <set>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
+#include <glad/gl.h>
+
+#include "paimon/rendering/shader_archive.h"
 #include "paimon/rendering/shader_source.h"
 #include "paimon/rendering/shader_includer.h"
 #include "paimon/rendering/shader_program_cache.h"
+#include "paimon/rendering/shader_watcher.h"
 
 namespace paimon {
 
@@ -29,11 +37,35 @@ public:
   ShaderManager& operator=(const ShaderManager&) = delete;
 
   /**
-   * @brief Load all shader files from a directory
+   * @brief Index the shader files of a directory
+   * Only names, types and modification times are recorded, sources are read
+   * and preprocessed the first time a program uses them
    * @param directory Directory containing shader files
    */
   void load(const std::filesystem::path &directory);
 
+  /**
+   * @brief Map a packed shader archive
+   * Indexed directories take precedence over the archive
+   * @param path Archive written by writeArchive
+   * @return True if the archive was mapped
+   */
+  bool loadArchive(const std::filesystem::path &path);
+
+  /**
+   * @brief Pack every indexed shader, preprocessed, into an archive
+   * @param path Archive to write
+   * @return True if the archive was written
+   */
+  bool writeArchive(const std::filesystem::path &path);
+
+  /**
+   * @brief Get a shader source, loading it on first use
+   * @param name Shader file name
+   * @return Pointer to the source, nullptr for unknown shaders
+   */
+  const ShaderSource* getShaderSource(const std::string &name);
+
   /**
    * @brief Create or get cached shader program with defines
    * @param source Shader source
@@ -43,16 +75,129 @@ public:
   ShaderProgram* createShaderProgram(const std::string &name,
                                      const std::vector<ShaderDefine>& defines = {});
 
+  /**
+   * @brief Create or get cached shader program from a define block
+   * @param name Shader source name
+   * @param defineBlock #define lines, see ShaderFeatureSet
+   * @return Pointer to shader program
+   */
+  ShaderProgram* createShaderProgram(const std::string &name,
+                                     std::string_view defineBlock);
+
+  /**
+   * @brief Get a shader program without blocking on its compilation
+   * @param name Shader source name
+   * @param defines Shader defines/macros
+   * @return Handle resolving to the program once it is compiled
+   */
+  ShaderProgramHandle
+  createShaderProgramAsync(const std::string &name,
+                           const std::vector<ShaderDefine> &defines = {});
+
+  /**
+   * @brief Get a shader program from a define block without blocking
+   * @param name Shader source name
+   * @param defineBlock #define lines, see ShaderFeatureSet
+   * @return Handle resolving to the program once it is compiled
+   */
+  ShaderProgramHandle createShaderProgramAsync(const std::string &name,
+                                               std::string_view defineBlock);
+
+  /**
+   * @brief Compile shader program variants in the background for warmup
+   * @param name Shader source name
+   * @param variants Define combinations to compile
+   * @return Handles of the variants, in order
+   */
+  std::vector<ShaderProgramHandle> precompileShaderPrograms(
+      const std::string &name,
+      const std::vector<std::vector<ShaderDefine>> &variants);
+
+  /**
+   * @brief Deliver shader programs compiled in the background
+   * With hot-reload enabled, changed shader files are also picked up here
+   * Call once per frame on the GL thread
+   */
+  void update();
+
+  /**
+   * @brief Watch the indexed directories and reload shaders when they change
+   * Only the variants of sources that include a changed file are recompiled
+   */
+  void enableHotReload();
+
+  /**
+   * @brief Reload the sources depending on changed files
+   * @param files Canonical paths of the changed files
+   */
+  void reload(const std::vector<std::filesystem::path> &files);
+
+  /**
+   * @brief Block until every background compile has finished
+   */
+  void finish();
+
+  /**
+   * @brief Persist compiled shader programs in a directory
+   * @param directory Cache directory, created on first use
+   * @param maxSize Size limit of the directory in bytes
+   */
+  void enableProgramBinaryCache(
+      const std::filesystem::path &directory,
+      uintmax_t maxSize = ProgramBinaryCache::DefaultMaxSize);
+
+  /**
+   * @brief Get the program binary cache
+   * @return Pointer to the cache, nullptr when disabled
+   */
+  ProgramBinaryCache* getProgramBinaryCache() const {
+    return m_shaderProgramCache.getBinaryCache();
+  }
+
+  /**
+   * @brief Get compile and link telemetry of the program variants
+   * @return Build times, source sizes, variant counts and lookup hit rate
+   */
+  ShaderProgramCacheStats getProgramCacheStats() const {
+    return m_shaderProgramCache.getStats();
+  }
+
 private:
+  /// Shader file found by a directory scan
+  struct IndexEntry {
+    std::filesystem::path path;
+    GLenum type = GL_INVALID_ENUM;
+    std::filesystem::file_time_type mtime;
+  };
 
   /**
-   * @brief Load a single shader file
-   * @param filePath Path to the shader file
+   * @brief Read and preprocess an indexed shader file
+   * @param name Shader file name
+   * @param entry Index entry of the file
+   * @return The loaded source
    */
-  void loadShaderFile(const std::filesystem::path &filePath);
+  const ShaderSource& loadShaderFile(const std::string &name,
+                                     const IndexEntry &entry);
 
 private:
-  /// Map of shader filename to base shader source
+  /// Indexed directories, watched by hot-reload
+  std::vector<std::filesystem::path> m_directories;
+
+  /// Map of shader filename to indexed shader file
+  std::unordered_map<std::string, IndexEntry> m_index;
+
+  /// Map of loaded shader filename to the canonical paths of its file and
+  /// every file it includes
+  std::unordered_map<std::string, std::set<std::filesystem::path>>
+      m_dependencies;
+
+  /// File watcher, nullptr unless hot-reload is enabled
+  std::unique_ptr<ShaderWatcher> m_watcher;
+
+  /// Packed sources, used for names missing from the index
+  ShaderArchive m_archive;
+
+  /// Map of shader filename to base shader source, filled on first use
   std::unordered_map<std::string, ShaderSource> m_shaderSources;
 
   /// Shader includer for processing #include directives
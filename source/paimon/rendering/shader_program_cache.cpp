@@ -1,95 +1,450 @@
 #include "paimon/rendering/shader_program_cache.h"
 
-#include <regex>
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <optional>
 
 #include "paimon/core/hash.h"
 #include "paimon/core/log_system.h"
+#include "paimon/rendering/graphics_pipeline.h"
+#include "paimon/rendering/shader_includer.h"
 
 using namespace paimon;
 
+namespace {
+
+// Log the errors of a program that failed to compile or link
+void logProgramErrors(const ShaderProgram *program) {
+  LOG_ERROR("Failed to create shader program");
+  if (program) {
+    std::string infoLog = program->get_info_log();
+    if (!infoLog.empty()) {
+      LOG_ERROR("Shader compilation error:\n{}", infoLog);
+    }
+  }
+}
+
+double getElapsedMs(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(
+             std::chrono::steady_clock::now() - start)
+      .count();
+}
+
+// Concatenated #define lines of a define list
+std::string createDefineBlock(const std::vector<ShaderDefine> &defines) {
+  std::string defineBlock;
+  for (const auto &define : defines) {
+    defineBlock += define.getSource();
+  }
+  return defineBlock;
+}
+
+} // namespace
+
+size_t ShaderProgramCache::KeyHash::operator()(const KeyView &key) const {
+  std::size_t hash = std::hash<std::string_view>()(key.name);
+  hashCombine(hash, key.sourceHash, key.defineBlock);
+  return hash;
+}
+
+size_t ShaderProgramCache::ProgramSourceHash::operator()(
+    const ProgramSource &source) const {
+  std::size_t hash = std::hash<std::string>()(source.source);
+  hashCombine(hash, source.type);
+  return hash;
+}
+
 ShaderProgram *
 ShaderProgramCache::get(const ShaderSource &source,
-                     const std::vector<ShaderDefine> &defines) {
-  // Compute hash for the defines
-  std::size_t hash = createHash(source, defines);
+                        const std::vector<ShaderDefine> &defines) {
+  return get(source, createDefineBlock(defines));
+}
+
+ShaderProgram *ShaderProgramCache::get(const ShaderSource &source,
+                                       std::string_view defineBlock) {
+  KeyView key(source.name, getSourceHash(source), defineBlock);
+
+  // Check if the variant exists in cache
+  auto it = m_variants.find(key);
+  if (it != m_variants.end()) {
+    ++m_hits;
+    // Requested with getAsync before, finish that compile instead of
+    // starting another one
+    if (it->second.job) {
+      m_compiler.wait(*it->second.job);
+      it = m_variants.find(key);
+      if (it == m_variants.end()) {
+        return nullptr;
+      }
+    }
+    const auto *program = it->second.program;
+    return program ? program->second.program.get() : nullptr;
+  }
+
+  ++m_misses;
+  ShaderProgramKey ownedKey{source.name, key.sourceHash,
+                            std::string(defineBlock)};
+  auto &variant = m_variants[std::move(ownedKey)];
+  ProgramSource programSource{source.type,
+                              createVariantSource(source, defineBlock)};
+  variant.sourceSize = programSource.source.size();
 
-  // Check if program exists in cache
-  auto it = m_cache.find(hash);
-  if (it != m_cache.end()) {
-    return it->second.get();
+  // Another variant compiled the same text already
+  auto shared = m_programs.find(programSource);
+  if (shared != m_programs.end()) {
+    attach(variant, *shared);
+    return shared->second.program.get();
   }
 
   // Create new shader program
-  auto program = createShaderProgram(source, defines);
-  if (!program || !program->is_valid()) {
-    LOG_ERROR("Failed to create shader program");
-    if (program) {
-      std::string infoLog = program->get_info_log();
-      if (!infoLog.empty()) {
-        LOG_ERROR("Shader compilation error:\n{}", infoLog);
+  auto program = createShaderProgram(variant, programSource);
+  return insert(variant, std::move(programSource), std::move(program));
+}
+
+ShaderProgramHandle
+ShaderProgramCache::getAsync(const ShaderSource &source,
+                             const std::vector<ShaderDefine> &defines) {
+  return getAsync(source, createDefineBlock(defines));
+}
+
+ShaderProgramHandle
+ShaderProgramCache::getAsync(const ShaderSource &source,
+                             std::string_view defineBlock) {
+  KeyView key(source.name, getSourceHash(source), defineBlock);
+
+  auto it = m_variants.find(key);
+  if (it != m_variants.end()) {
+    ++m_hits;
+    auto &variant = it->second;
+    if (!variant.state) {
+      variant.state = std::make_shared<ShaderProgramHandle::State>();
+      variant.state->program =
+          variant.program ? variant.program->second.program.get() : nullptr;
+      variant.state->ready = !variant.job;
+    }
+    return ShaderProgramHandle(variant.state);
+  }
+
+  ++m_misses;
+  ShaderProgramKey ownedKey{source.name, key.sourceHash,
+                            std::string(defineBlock)};
+  auto &variant = m_variants[ownedKey];
+  variant.state = std::make_shared<ShaderProgramHandle::State>();
+  ShaderProgramHandle handle(variant.state);
+
+  ProgramSource programSource{source.type,
+                              createVariantSource(source, defineBlock)};
+  variant.sourceSize = programSource.source.size();
+  auto shared = m_programs.find(programSource);
+  if (shared != m_programs.end()) {
+    attach(variant, *shared);
+    variant.state->ready = true;
+    return handle;
+  }
+
+  compileAsync(ownedKey, variant, std::move(programSource));
+  LOG_DEBUG("Compiling shader program {} in the background", source.name);
+  return handle;
+}
+
+std::vector<ShaderProgramHandle>
+ShaderProgramCache::precompile(const std::vector<ShaderVariant> &variants) {
+  std::vector<ShaderProgramHandle> handles;
+  handles.reserve(variants.size());
+  for (const auto &variant : variants) {
+    handles.push_back(getAsync(variant.source, variant.defines));
+  }
+  return handles;
+}
+
+void ShaderProgramCache::update() { m_compiler.update(); }
+
+void ShaderProgramCache::finish() { m_compiler.waitAll(); }
+
+size_t ShaderProgramCache::reload(const ShaderSource &source) {
+  auto sourceHash = getSourceHash(source);
+
+  std::vector<ShaderProgramKey> outdated;
+  for (const auto &[key, variant] : m_variants) {
+    if (key.name == source.name && key.sourceHash != sourceHash) {
+      outdated.push_back(key);
+    }
+  }
+
+  size_t count = 0;
+  for (auto &key : outdated) {
+    ShaderProgramKey newKey{key.name, sourceHash, key.defineBlock};
+    if (m_variants.contains(newKey)) {
+      continue; // requested for the new source already
+    }
+
+    // Rekey in place, the variant keeps its program and handle until the
+    // new program is accepted
+    auto node = m_variants.extract(key);
+    node.key() = newKey;
+    auto &variant = m_variants.insert(std::move(node)).position->second;
+
+    ProgramSource programSource{
+        source.type, createVariantSource(source, newKey.defineBlock)};
+    variant.sourceSize = programSource.source.size();
+    auto shared = m_programs.find(programSource);
+    if (shared != m_programs.end()) {
+      // Reverted to a version still in use by another variant
+      variant.job.reset();
+      ++variant.generation;
+      insert(variant, std::move(programSource), nullptr);
+    } else {
+      compileAsync(newKey, variant, std::move(programSource));
+    }
+    ++count;
+  }
+
+  if (count > 0) {
+    LOG_INFO("Reloading {} variants of shader {}", count, source.name);
+  }
+  return count;
+}
+
+void ShaderProgramCache::clear() {
+  // Background compiles would land in the cleared cache otherwise
+  m_compiler.waitAll();
+  for (auto &[key, variant] : m_variants) {
+    if (variant.state) {
+      variant.state->program = nullptr;
+    }
+  }
+  m_variants.clear();
+  m_programs.clear();
+}
+
+uint64_t ShaderProgramCache::getSourceHash(const ShaderSource &source) {
+  return source.hash != 0 ? source.hash : hashFnv1a(source.source);
+}
+
+void ShaderProgramCache::compileAsync(const ShaderProgramKey &key,
+                                      Variant &variant,
+                                      ProgramSource source) {
+  auto generation = ++variant.generation;
+
+  // Loading a cached binary is cheap enough to do right away
+  std::optional<ProgramBinaryKey> binaryKey;
+  if (m_binaryCache && m_binaryCache->isSupported()) {
+    auto start = std::chrono::steady_clock::now();
+    binaryKey = m_binaryCache->createKey(source.type, source.source);
+    if (auto program = m_binaryCache->load(*binaryKey)) {
+      variant.job.reset();
+      recordBuild(variant, {.totalMs = getElapsedMs(start)}, true);
+      insert(variant, std::move(source), std::move(program));
+      return;
+    }
+  }
+
+  auto type = source.type;
+  auto text = source.source;
+  variant.job = m_compiler.compile(
+      type, std::move(text), binaryKey.has_value(),
+      [this, key, generation, binaryKey, source = std::move(source)](
+          std::unique_ptr<ShaderProgram> program,
+          const ShaderBuildTimes &times) mutable {
+        // The variant was cleared, reloaded again or rekeyed meanwhile
+        auto it = m_variants.find(key);
+        if (it == m_variants.end() || it->second.generation != generation) {
+          return;
+        }
+        it->second.job.reset();
+        recordBuild(it->second, times, false);
+        if (binaryKey && m_binaryCache && program->is_linked()) {
+          m_binaryCache->store(*binaryKey, *program);
+        }
+        insert(it->second, std::move(source), std::move(program));
+      });
+}
+
+ShaderProgram *
+ShaderProgramCache::insert(Variant &variant, ProgramSource source,
+                           std::unique_ptr<ShaderProgram> program) {
+  if (variant.state) {
+    variant.state->ready = true;
+  }
+
+  // A program of the same text may have been compiled meanwhile, it is
+  // shared and the new one dropped
+  auto shared = m_programs.find(source);
+  if (shared == m_programs.end()) {
+    // A program that compiled but failed to link is no better than none
+    if (!program || !program->is_linked()) {
+      logProgramErrors(program.get());
+      if (variant.program) {
+        LOG_WARN("Keeping the previous shader program");
+        return variant.program->second.program.get();
       }
+      return nullptr;
     }
-    return nullptr;
+
+    // Check for warnings/info
+    std::string infoLog = program->get_info_log();
+    if (!infoLog.empty()) {
+      LOG_INFO("Shader program info log:\n{}", infoLog);
+    }
+
+    shared = m_programs.emplace(std::move(source), Program{std::move(program)})
+                 .first;
   }
 
-  // Check for warnings/info
-  std::string infoLog = program->get_info_log();
-  if (!infoLog.empty()) {
-    LOG_INFO("Shader program info log:\n{}", infoLog);
+  auto *previous = variant.program;
+  if (previous && previous != &*shared) {
+    // Pipelines hold the old program, they may only switch when no other
+    // variant still uses it
+    if (previous->second.users > 1) {
+      LOG_WARN("Reloaded shader program is shared, pipelines keep the "
+               "previous one until they are recreated");
+    } else if (!GraphicsPipeline::replaceProgram(
+                   *previous->second.program, *shared->second.program)) {
+      LOG_WARN("Reloaded shader program rejected, keeping the previous one");
+      if (shared->second.users == 0) {
+        m_programs.erase(shared);
+      }
+      return previous->second.program.get();
+    }
+    detach(variant);
   }
 
-  ShaderProgram *ptr = program.get();
-  m_cache[hash] = std::move(program);
+  if (variant.program != &*shared) {
+    attach(variant, *shared);
+  }
 
   LOG_DEBUG("Created and cached shader program (cache size: {})",
-            m_cache.size());
+            m_programs.size());
 
-  return ptr;
+  return shared->second.program.get();
 }
 
-void ShaderProgramCache::clear() { m_cache.clear(); }
+void ShaderProgramCache::attach(Variant &variant,
+                                Programs::value_type &program) {
+  ++program.second.users;
+  variant.program = &program;
+  if (variant.state) {
+    variant.state->program = program.second.program.get();
+  }
+}
 
-std::size_t
-ShaderProgramCache::createHash(const ShaderSource &source,
-                     const std::vector<ShaderDefine> &defines) const {
-  
-  std::size_t hash = std::hash<std::string>()(source.name);
-  for (const auto &define : defines) {
-    hashCombine(hash, define.getHash());
+void ShaderProgramCache::detach(Variant &variant) {
+  auto *program = variant.program;
+  if (!program) {
+    return;
+  }
+  variant.program = nullptr;
+  if (--program->second.users == 0) {
+    m_programs.erase(m_programs.find(program->first));
   }
-  return hash;
 }
 
-std::unique_ptr<ShaderProgram> ShaderProgramCache::createShaderProgram(
-    const ShaderSource &source,
-    const std::vector<ShaderDefine> &defines) const {
+std::string
+ShaderProgramCache::createVariantSource(const ShaderSource &source,
+                                        std::string_view defineBlock) const {
 
   std::string variantSource = source.source;
-
-  // Build define block
-  std::string defineBlock;
-  for (const auto &define : defines) {
-    defineBlock += define.getSource();
-  }
+  std::string variantDefines(defineBlock);
 
   // Insert defines after #version line
-  static const std::regex versionPattern(R"(^[ \t]*#version\s+\d+[^\n]*)");
-  std::smatch match;
-
-  if (std::regex_search(variantSource, match, versionPattern)) {
-    // Insert defines after #version line
-    size_t insertPos = match.position() + match.length();
-    // Find the end of the line
-    size_t newlinePos = variantSource.find('\n', insertPos);
-    if (newlinePos != std::string::npos) {
-      variantSource.insert(newlinePos + 1, defineBlock);
-    } else {
-      variantSource += "\n" + defineBlock;
+  size_t insertPos = 0;
+  int versionLine = 0;
+  if (ShaderIncluder::findVersion(variantSource, insertPos, versionLine)) {
+    if (variantSource[insertPos - 1] != '\n') {
+      variantSource.insert(insertPos++, "\n");
+    }
+    // Number the following lines as in the file again
+    if (!variantDefines.empty()) {
+      variantDefines += std::format("#line {} 0\n", versionLine + 1);
     }
+    variantSource.insert(insertPos, variantDefines);
   } else {
     // No #version, insert at beginning
-    variantSource.insert(0, defineBlock + "\n");
+    variantSource.insert(0, variantDefines + "\n");
   }
 
-  return std::make_unique<ShaderProgram>(source.type, variantSource);
-}
\ No newline at end of file
+  return variantSource;
+}
+
+std::unique_ptr<ShaderProgram>
+ShaderProgramCache::createShaderProgram(Variant &variant,
+                                        const ProgramSource &source) const {
+  // Built on this thread anyway, the constructor waits on each step to time
+  // the compile and the link apart
+  auto start = std::chrono::steady_clock::now();
+  ShaderBuildTimes times;
+  if (!m_binaryCache || !m_binaryCache->isSupported()) {
+    auto program = std::make_unique<ShaderProgram>(source.type, source.source,
+                                                   false, &times);
+    times.totalMs = getElapsedMs(start);
+    recordBuild(variant, times, false);
+    return program;
+  }
+
+  // The key covers the final source, a warm start links nothing
+  auto key = m_binaryCache->createKey(source.type, source.source);
+  if (auto program = m_binaryCache->load(key)) {
+    LOG_DEBUG("Loaded shader program from the binary cache");
+    recordBuild(variant, {.totalMs = getElapsedMs(start)}, true);
+    return program;
+  }
+
+  auto program = std::make_unique<ShaderProgram>(source.type, source.source,
+                                                 /*retrievable=*/true, &times);
+  bool linked = program->is_linked();
+  times.totalMs = getElapsedMs(start);
+  recordBuild(variant, times, false);
+  if (linked) {
+    m_binaryCache->store(key, *program);
+  }
+  return program;
+}
+
+void ShaderProgramCache::recordBuild(Variant &variant,
+                                     const ShaderBuildTimes &times,
+                                     bool binaryLoad) {
+  ++variant.buildCount;
+  if (binaryLoad) {
+    ++variant.binaryLoads;
+  }
+  variant.lastBuild = times;
+  variant.totalBuild.totalMs += times.totalMs;
+  variant.totalBuild.compileMs += times.compileMs;
+  variant.totalBuild.linkMs += times.linkMs;
+}
+
+ShaderProgramCacheStats ShaderProgramCache::getStats() const {
+  ShaderProgramCacheStats stats;
+  stats.hits = m_hits;
+  stats.misses = m_misses;
+  stats.programCount = m_programs.size();
+  stats.variants.reserve(m_variants.size());
+  for (const auto &[key, variant] : m_variants) {
+    auto &variantStats = stats.variants.emplace_back();
+    variantStats.name = key.name;
+    variantStats.defineBlock = key.defineBlock;
+    variantStats.sourceSize = variant.sourceSize;
+    variantStats.buildCount = variant.buildCount;
+    variantStats.binaryLoads = variant.binaryLoads;
+    variantStats.lastBuildMs = variant.lastBuild.totalMs;
+    variantStats.totalBuildMs = variant.totalBuild.totalMs;
+    variantStats.lastCompileMs = variant.lastBuild.compileMs;
+    variantStats.lastLinkMs = variant.lastBuild.linkMs;
+    variantStats.totalCompileMs = variant.totalBuild.compileMs;
+    variantStats.totalLinkMs = variant.totalBuild.linkMs;
+    variantStats.linked =
+        variant.program && variant.program->second.program->is_linked();
+    variantStats.shared =
+        variant.program && variant.program->second.users > 1;
+
+    stats.totalBuildMs += variant.totalBuild.totalMs;
+    ++stats.variantCounts[key.name];
+  }
+
+  std::sort(stats.variants.begin(), stats.variants.end(),
+            [](const auto &a, const auto &b) {
+              return a.totalBuildMs > b.totalBuildMs;
+            });
+  return stats;
+}
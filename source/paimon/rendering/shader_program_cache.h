@@ -1,15 +1,99 @@
 #pragma once
 
+#include <cstdint>
+#include <map>
 #include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include "paimon/opengl/shader_program.h"
+#include "paimon/rendering/program_binary_cache.h"
+#include "paimon/rendering/shader_compiler.h"
 #include "paimon/rendering/shader_source.h"
 
 namespace paimon {
 
-// ShaderProgramCache manages shader program objects for a single shader source
-// with different define combinations
+// Handle to a shader program variant that may still be compiling. Draws can
+// keep using a generic variant through getOr() until this one is ready.
+class ShaderProgramHandle {
+public:
+  ShaderProgramHandle() = default;
+
+  // False for a default constructed handle
+  bool isValid() const { return m_state != nullptr; }
+
+  // True once compilation has finished, successfully or not
+  bool isReady() const { return m_state && m_state->ready; }
+
+  // The program, nullptr while compiling or when compilation failed
+  ShaderProgram *get() const { return m_state ? m_state->program : nullptr; }
+
+  // The program when it is ready, the fallback until then
+  ShaderProgram *getOr(ShaderProgram *fallback) const {
+    auto *program = get();
+    return program ? program : fallback;
+  }
+
+private:
+  friend class ShaderProgramCache;
+
+  struct State {
+    ShaderProgram *program = nullptr;
+    bool ready = false;
+  };
+
+  explicit ShaderProgramHandle(std::shared_ptr<State> state)
+      : m_state(std::move(state)) {}
+
+  std::shared_ptr<State> m_state;
+};
+
+// Full identity of a program variant: the source name, a hash of its
+// preprocessed text and the ordered define block. Editing a source changes
+// its hash, so an edited source never hits programs of its previous version.
+struct ShaderProgramKey {
+  std::string name;
+  uint64_t sourceHash = 0;
+  std::string defineBlock;
+
+  bool operator==(const ShaderProgramKey &) const = default;
+};
+
+// Build statistics of one program variant
+struct ShaderVariantStats {
+  std::string name;
+  std::string defineBlock;
+  size_t sourceSize = 0;     // preprocessed source with the defines, bytes
+  uint32_t buildCount = 0;   // compiles and binary loads, reloads included
+  uint32_t binaryLoads = 0;  // builds served by the program binary cache
+  double lastBuildMs = 0.0;  // wall time of the last compile and link
+  double totalBuildMs = 0.0;
+  // Split of the build time, zero for builds the driver compiled in parallel
+  // and for binary loads, see ShaderBuildTimes
+  double lastCompileMs = 0.0;
+  double lastLinkMs = 0.0;
+  double totalCompileMs = 0.0;
+  double totalLinkMs = 0.0;
+  bool linked = false;
+  bool shared = false; // program also used by another variant
+};
+
+// Snapshot of the cache, for finding variant explosions and slow shaders
+struct ShaderProgramCacheStats {
+  uint64_t hits = 0;   // lookups of a variant requested before
+  uint64_t misses = 0; // lookups creating a variant
+  size_t programCount = 0;
+  double totalBuildMs = 0.0;
+  std::map<std::string, size_t> variantCounts; // per base shader
+  std::vector<ShaderVariantStats> variants;    // slowest first
+};
+
+// ShaderProgramCache manages shader program objects for shader sources with
+// different define combinations. Variants whose final source text is equal,
+// e.g. identical sources under different names, share one compiled program.
 class ShaderProgramCache {
 public:
   ShaderProgramCache() = default;
@@ -19,29 +103,178 @@ public:
   ShaderProgramCache(const ShaderProgramCache &) = delete;
   ShaderProgramCache &operator=(const ShaderProgramCache &) = delete;
 
-  // Get or create shader program with given defines
+  // Get or create shader program with given defines, a variant still
+  // compiling in the background is finished first
   ShaderProgram *get(const ShaderSource &source,
                      const std::vector<ShaderDefine> &defines);
 
-  // Clear the cache
+  // Same with the defines as a block of #define lines, as generated at
+  // compile time by ShaderFeatureSet
+  ShaderProgram *get(const ShaderSource &source, std::string_view defineBlock);
+
+  // Get the shader program with given defines without blocking, compiling it
+  // in the background when it is not cached yet
+  ShaderProgramHandle getAsync(const ShaderSource &source,
+                               const std::vector<ShaderDefine> &defines);
+
+  ShaderProgramHandle getAsync(const ShaderSource &source,
+                               std::string_view defineBlock);
+
+  // Start compiling every variant in the background, for warmup before the
+  // variants are first drawn
+  std::vector<ShaderProgramHandle>
+  precompile(const std::vector<ShaderVariant> &variants);
+
+  // Deliver finished background compiles, call once per frame on the GL
+  // thread
+  void update();
+
+  // Block until every background compile has finished
+  void finish();
+
+  // Recompile every variant requested so far of a changed source in the
+  // background. The variants are keyed by the new source right away but keep
+  // their program until the new one links and the pipelines using it
+  // validate. Returns the number of variants recompiling.
+  size_t reload(const ShaderSource &source);
+
+  // Clear the cache, handles returned so far resolve to nullptr
   void clear();
 
   // Get cache statistics
-  size_t getCacheSize() const { return m_cache.size(); }
+  size_t getCacheSize() const { return m_variants.size(); }
+  size_t getProgramCount() const { return m_programs.size(); }
+  size_t getPendingCount() const { return m_compiler.getPendingCount(); }
+
+  // Per variant build times and lookup counts since startup
+  ShaderProgramCacheStats getStats() const;
+
+  // Persist linked programs on disk, new variants are loaded from it before
+  // compiling. Pass nullptr to disable.
+  void setBinaryCache(std::unique_ptr<ProgramBinaryCache> binaryCache) {
+    m_binaryCache = std::move(binaryCache);
+  }
+
+  ProgramBinaryCache *getBinaryCache() const { return m_binaryCache.get(); }
 
 private:
-  // Compute hash from defines
-  std::size_t createHash(const ShaderSource &source,
-                     const std::vector<ShaderDefine> &defines) const;
+  // Key without owned strings, lookups of cached variants allocate nothing
+  struct KeyView {
+    std::string_view name;
+    uint64_t sourceHash = 0;
+    std::string_view defineBlock;
+
+    KeyView(std::string_view name, uint64_t sourceHash,
+            std::string_view defineBlock)
+        : name(name), sourceHash(sourceHash), defineBlock(defineBlock) {}
+    KeyView(const ShaderProgramKey &key)
+        : KeyView(key.name, key.sourceHash, key.defineBlock) {}
+
+    bool operator==(const KeyView &) const = default;
+  };
+
+  struct KeyHash {
+    using is_transparent = void;
+    size_t operator()(const KeyView &key) const;
+  };
+
+  struct KeyEqual {
+    using is_transparent = void;
+    bool operator()(const KeyView &a, const KeyView &b) const {
+      return a == b;
+    }
+  };
+
+  // Exact text and stage a program is compiled from
+  struct ProgramSource {
+    GLenum type = GL_INVALID_ENUM;
+    std::string source;
+
+    bool operator==(const ProgramSource &) const = default;
+  };
+
+  struct ProgramSourceHash {
+    size_t operator()(const ProgramSource &source) const;
+  };
+
+  // Compiled program, shared by every variant with the same source
+  struct Program {
+    std::unique_ptr<ShaderProgram> program;
+    size_t users = 0;
+  };
+
+  using Programs =
+      std::unordered_map<ProgramSource, Program, ProgramSourceHash>;
+
+  struct Variant {
+    // Entry of the program in m_programs, nullptr while compiling for the
+    // first time or when compilation failed
+    Programs::value_type *program = nullptr;
+
+    // Handle state, created by the first getAsync
+    std::shared_ptr<ShaderProgramHandle::State> state;
+
+    // Background compile, results of older compiles are dropped
+    std::optional<uint64_t> job;
+    uint64_t generation = 0;
 
-  // Create a new shader program
+    // Telemetry, see ShaderVariantStats
+    size_t sourceSize = 0;
+    uint32_t buildCount = 0;
+    uint32_t binaryLoads = 0;
+    ShaderBuildTimes lastBuild;
+    ShaderBuildTimes totalBuild;
+  };
+
+  using Variants =
+      std::unordered_map<ShaderProgramKey, Variant, KeyHash, KeyEqual>;
+
+  // Hash of a preprocessed source, computed once when it is loaded
+  static uint64_t getSourceHash(const ShaderSource &source);
+
+  // Source with the define block inserted after #version
+  std::string createVariantSource(const ShaderSource &source,
+                                  std::string_view defineBlock) const;
+
+  // Compile a program for a variant on the calling thread, through the
+  // binary cache
   std::unique_ptr<ShaderProgram>
-  createShaderProgram(const ShaderSource &source,
-                     const std::vector<ShaderDefine> &defines) const;
+  createShaderProgram(Variant &variant, const ProgramSource &source) const;
+
+  // Account a build of a variant's program
+  static void recordBuild(Variant &variant, const ShaderBuildTimes &times,
+                          bool binaryLoad);
+
+  // Compile a variant in the background, the result goes through insert
+  void compileAsync(const ShaderProgramKey &key, Variant &variant,
+                    ProgramSource source);
+
+  // Deliver a compiled program to a variant. A variant that had a program
+  // before is only switched once the pipelines accept the new one. Returns
+  // the program of the variant.
+  ShaderProgram *insert(Variant &variant, ProgramSource source,
+                        std::unique_ptr<ShaderProgram> program);
+
+  // Point a variant at the shared program of a source
+  void attach(Variant &variant, Programs::value_type &program);
+
+  // Drop a variant's use of its program, destroying it with the last user
+  void detach(Variant &variant);
 
 private:
-  // Cache uses hash value as key
-  std::unordered_map<std::size_t, std::unique_ptr<ShaderProgram>> m_cache;
+  // Every variant requested, compiled, compiling or failed
+  Variants m_variants;
+
+  // Compiled programs keyed by their exact source
+  Programs m_programs;
+
+  uint64_t m_hits = 0;
+  uint64_t m_misses = 0;
+
+  std::unique_ptr<ProgramBinaryCache> m_binaryCache;
+
+  // Destroyed first, its worker stops before the cache goes away
+  ShaderCompiler m_compiler;
 };
 
-} // namespace paimon
\ No newline at end of file
+} // namespace paimon
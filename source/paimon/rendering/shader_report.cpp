@@ -0,0 +1,60 @@
+#include "paimon/rendering/shader_report.h"
+
+#include <fstream>
+
+#include <nlohmann/json.hpp>
+
+#include "paimon/core/log_system.h"
+#include "paimon/rendering/shader_manager.h"
+
+namespace paimon {
+
+std::string dumpShaderReport(const ShaderManager &shaderManager) {
+  auto stats = shaderManager.getProgramCacheStats();
+
+  nlohmann::json variants = nlohmann::json::array();
+  for (const auto &variant : stats.variants) {
+    variants.push_back({
+        {"name", variant.name},
+        {"defines", variant.defineBlock},
+        {"source_bytes", variant.sourceSize},
+        {"builds", variant.buildCount},
+        {"binary_loads", variant.binaryLoads},
+        {"last_build_ms", variant.lastBuildMs},
+        {"total_build_ms", variant.totalBuildMs},
+        {"last_compile_ms", variant.lastCompileMs},
+        {"last_link_ms", variant.lastLinkMs},
+        {"total_compile_ms", variant.totalCompileMs},
+        {"total_link_ms", variant.totalLinkMs},
+        {"linked", variant.linked},
+        {"shared", variant.shared},
+    });
+  }
+
+  auto lookups = stats.hits + stats.misses;
+  nlohmann::json report = {
+      {"hits", stats.hits},
+      {"misses", stats.misses},
+      {"hit_rate", lookups > 0 ? double(stats.hits) / double(lookups) : 0.0},
+      {"programs", stats.programCount},
+      {"total_build_ms", stats.totalBuildMs},
+      {"variant_counts", stats.variantCounts},
+      {"variants", std::move(variants)},
+  };
+  return report.dump(2);
+}
+
+bool writeShaderReport(const ShaderManager &shaderManager,
+                       const std::filesystem::path &filepath) {
+  std::ofstream file(filepath);
+  if (!file) {
+    LOG_ERROR("Failed to open shader report file: {}", filepath.string());
+    return false;
+  }
+
+  file << dumpShaderReport(shaderManager) << '\n';
+  LOG_INFO("Wrote shader report to {}", filepath.string());
+  return true;
+}
+
+} // namespace paimon
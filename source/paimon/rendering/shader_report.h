@@ -0,0 +1,18 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+
+namespace paimon {
+
+class ShaderManager;
+
+// Machine-readable snapshot of the shader program variants and their build
+// times, as an indented JSON document
+std::string dumpShaderReport(const ShaderManager &shaderManager);
+
+// Write the report to a file, returns false on failure
+bool writeShaderReport(const ShaderManager &shaderManager,
+                       const std::filesystem::path &filepath);
+
+} // namespace paimon
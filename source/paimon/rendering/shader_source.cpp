@@ -3,8 +3,8 @@
 using namespace paimon;
 
 ShaderDefine::ShaderDefine(const std::string &name) {
-  m_hash = std::hash<std::string>()(name);
   m_source = std::format("#define {} \n", name);
+  m_hash = std::hash<std::string>()(m_source);
 }
 
 std::size_t ShaderDefine::getHash() const {
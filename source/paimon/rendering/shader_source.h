@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <format>
 #include <string>
 #include <type_traits>
@@ -13,6 +14,8 @@ struct ShaderSource {
   std::string name;
   std::string source;
   GLenum type;
+  // FNV-1a of source, 0 when not computed yet
+  uint64_t hash = 0;
 };
 
 class ShaderDefine {
@@ -22,8 +25,8 @@ public:
   template<class T>
     requires std::is_arithmetic_v<T>
   ShaderDefine(const std::string &name, const T &value) {
-    m_hash = std::hash<std::string>()(name) ^ std::hash<std::string>()(value);
     m_source = std::format("#define {} {} \n", name, value);
+    m_hash = std::hash<std::string>()(m_source);
   }
 
   std::size_t getHash() const;
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "paimon/rendering/shader_manager.h"
+#include "paimon/rendering/shader_program_cache.h"
+
+namespace paimon {
+
+// Feature bits of a shader variant, bit i enables the i-th define of the
+// shader's feature set
+using ShaderVariantKey = uint32_t;
+
+// Define blocks of every variant of a feature set, generated at compile time.
+// A feature set is a struct naming its shader and its defines in bit order:
+//
+//   struct PbrFeatures {
+//     static constexpr std::string_view Shader = "pbr.frag";
+//     enum : ShaderVariantKey { NormalMap = 1 << 0, AlphaMask = 1 << 1 };
+//     static constexpr std::array<std::string_view, 2> Defines = {
+//         "HAS_NORMAL_MAP", "ALPHA_MASK"};
+//   };
+template <typename Features> class ShaderFeatureSet {
+public:
+  static constexpr size_t FeatureCount = Features::Defines.size();
+  static constexpr size_t VariantCount = size_t(1) << FeatureCount;
+
+  // Every variant is a table entry, keep feature sets small
+  static_assert(FeatureCount <= 8, "Too many features for a variant table");
+
+  // Mask of the keys that name a variant
+  static constexpr ShaderVariantKey AllFeatures =
+      static_cast<ShaderVariantKey>(VariantCount - 1);
+
+  // Defines of a variant, one line each, in the format of ShaderDefine
+  static constexpr std::string_view getDefineBlock(ShaderVariantKey key) {
+    const auto &block = s_blocks[key & AllFeatures];
+    return {block.data.data(), block.size};
+  }
+
+private:
+  static constexpr std::string_view Prefix = "#define ";
+  static constexpr std::string_view Suffix = " \n";
+
+  // Length of the block enabling every feature
+  static constexpr size_t BlockCapacity = [] {
+    size_t capacity = 0;
+    for (auto define : Features::Defines) {
+      capacity += Prefix.size() + define.size() + Suffix.size();
+    }
+    return capacity;
+  }();
+
+  struct Block {
+    std::array<char, BlockCapacity> data{};
+    size_t size = 0;
+
+    constexpr void append(std::string_view text) {
+      for (char c : text) {
+        data[size++] = c;
+      }
+    }
+  };
+
+  static constexpr std::array<Block, VariantCount> s_blocks = [] {
+    std::array<Block, VariantCount> blocks{};
+    for (size_t key = 0; key < VariantCount; ++key) {
+      for (size_t i = 0; i < FeatureCount; ++i) {
+        if (key & (size_t(1) << i)) {
+          blocks[key].append(Prefix);
+          blocks[key].append(Features::Defines[i]);
+          blocks[key].append(Suffix);
+        }
+      }
+    }
+    return blocks;
+  }();
+};
+
+// Flat table of the program variants of a shader indexed by feature bits.
+// Variants are requested once, selecting one per draw is an array index.
+template <typename Features> class ShaderVariantTable {
+public:
+  using FeatureSet = ShaderFeatureSet<Features>;
+  static constexpr size_t VariantCount = FeatureSet::VariantCount;
+
+  // Compile a variant in the background, a variant requested before keeps
+  // its handle
+  const ShaderProgramHandle &request(ShaderManager &shaderManager,
+                                     ShaderVariantKey key) {
+    auto &handle = m_handles[key & FeatureSet::AllFeatures];
+    if (!handle.isValid()) {
+      handle = shaderManager.createShaderProgramAsync(
+          std::string(Features::Shader), FeatureSet::getDefineBlock(key));
+    }
+    return handle;
+  }
+
+  // Get a variant, compiling it on the calling thread when needed. A
+  // variant compiling in the background is finished first.
+  ShaderProgram *get(ShaderManager &shaderManager, ShaderVariantKey key) {
+    const auto &handle = m_handles[key & FeatureSet::AllFeatures];
+    if (handle.isReady()) {
+      return handle.get();
+    }
+    return shaderManager.createShaderProgram(std::string(Features::Shader),
+                                             FeatureSet::getDefineBlock(key));
+  }
+
+  // Request every variant in the background, for warmup
+  void precompile(ShaderManager &shaderManager) {
+    for (ShaderVariantKey key = 0; key < VariantCount; ++key) {
+      request(shaderManager, key);
+    }
+  }
+
+  // Handle of a variant, invalid until requested
+  const ShaderProgramHandle &operator[](ShaderVariantKey key) const {
+    return m_handles[key & FeatureSet::AllFeatures];
+  }
+
+private:
+  std::array<ShaderProgramHandle, VariantCount> m_handles;
+};
+
+} // namespace paimon
@@ -0,0 +1,160 @@
+#include "paimon/rendering/shader_watcher.h"
+
+#include <algorithm>
+
+#include "paimon/core/log_system.h"
+
+#ifdef PAIMON_OS_UNIX
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+using namespace paimon;
+
+#ifdef PAIMON_OS_UNIX
+
+ShaderWatcher::ShaderWatcher() {
+  m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (m_fd < 0) {
+    LOG_ERROR("ShaderWatcher: inotify_init1 failed");
+  }
+}
+
+ShaderWatcher::~ShaderWatcher() {
+  if (m_fd >= 0) {
+    close(m_fd);
+  }
+}
+
+bool ShaderWatcher::watch(const std::filesystem::path &directory) {
+  if (m_fd < 0) {
+    return false;
+  }
+
+  std::error_code ec;
+  auto root = std::filesystem::canonical(directory, ec);
+  if (ec || !addWatch(root)) {
+    return false;
+  }
+  for (const auto &entry :
+       std::filesystem::recursive_directory_iterator(root, ec)) {
+    if (entry.is_directory(ec)) {
+      addWatch(entry.path());
+    }
+  }
+  return true;
+}
+
+std::vector<std::filesystem::path> ShaderWatcher::poll() {
+  std::vector<std::filesystem::path> changed;
+  if (m_fd < 0) {
+    return changed;
+  }
+
+  alignas(inotify_event) char buffer[16 * 1024];
+  while (true) {
+    auto length = read(m_fd, buffer, sizeof(buffer));
+    if (length <= 0) {
+      break; // EAGAIN, nothing pending
+    }
+
+    for (ssize_t offset = 0; offset < length;) {
+      const auto *event =
+          reinterpret_cast<const inotify_event *>(buffer + offset);
+      offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+      auto it = m_watches.find(event->wd);
+      if (it == m_watches.end() || event->len == 0) {
+        continue;
+      }
+      auto path = it->second / event->name;
+
+      if (event->mask & IN_ISDIR) {
+        // Watch directories created after the initial scan
+        if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+          watch(path);
+        }
+        continue;
+      }
+      // A created file may still be empty or half written, it is reported
+      // once the writer closes it or renames it into place
+      if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) {
+        changed.push_back(std::move(path));
+      }
+    }
+  }
+
+  // Editors often write a file more than once per save
+  std::sort(changed.begin(), changed.end());
+  changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+  return changed;
+}
+
+bool ShaderWatcher::addWatch(const std::filesystem::path &directory) {
+  // Close-after-write and renames, editors that save through a temporary file
+  // replace the original with a rename. Creation is only watched to pick up
+  // new directories.
+  int wd = inotify_add_watch(m_fd, directory.c_str(),
+                             IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+  if (wd < 0) {
+    LOG_WARN("ShaderWatcher: cannot watch {}", directory.string());
+    return false;
+  }
+  m_watches[wd] = directory;
+  return true;
+}
+
+#else
+
+namespace {
+constexpr auto ScanInterval = std::chrono::milliseconds(500);
+} // namespace
+
+ShaderWatcher::ShaderWatcher() = default;
+
+ShaderWatcher::~ShaderWatcher() = default;
+
+bool ShaderWatcher::watch(const std::filesystem::path &directory) {
+  std::error_code ec;
+  auto root = std::filesystem::canonical(directory, ec);
+  if (ec) {
+    return false;
+  }
+  m_directories.push_back(root);
+  for (const auto &entry :
+       std::filesystem::recursive_directory_iterator(root, ec)) {
+    if (entry.is_regular_file(ec)) {
+      m_mtimes[entry.path()] = entry.last_write_time(ec);
+    }
+  }
+  m_lastScan = std::chrono::steady_clock::now();
+  return true;
+}
+
+std::vector<std::filesystem::path> ShaderWatcher::poll() {
+  std::vector<std::filesystem::path> changed;
+  auto now = std::chrono::steady_clock::now();
+  if (now - m_lastScan < ScanInterval) {
+    return changed;
+  }
+  m_lastScan = now;
+
+  std::error_code ec;
+  for (const auto &directory : m_directories) {
+    for (const auto &entry :
+         std::filesystem::recursive_directory_iterator(directory, ec)) {
+      if (!entry.is_regular_file(ec)) {
+        continue;
+      }
+      auto mtime = entry.last_write_time(ec);
+      auto [it, inserted] = m_mtimes.try_emplace(entry.path(), mtime);
+      if (inserted || it->second != mtime) {
+        it->second = mtime;
+        changed.push_back(entry.path());
+      }
+    }
+  }
+  return changed;
+}
+
+#endif
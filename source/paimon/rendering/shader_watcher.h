@@ -0,0 +1,44 @@
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include "paimon/core/macro.h"
+
+namespace paimon {
+
+// ShaderWatcher reports files modified under watched directories. Linux uses
+// inotify and poll() only drains pending events, other platforms compare
+// modification times at a fixed interval.
+class ShaderWatcher {
+public:
+  ShaderWatcher();
+  ~ShaderWatcher();
+
+  // Delete copy constructor and assignment
+  ShaderWatcher(const ShaderWatcher &) = delete;
+  ShaderWatcher &operator=(const ShaderWatcher &) = delete;
+
+  // Watch a directory and its subdirectories
+  bool watch(const std::filesystem::path &directory);
+
+  // Canonical paths of files written since the last call, never blocks
+  std::vector<std::filesystem::path> poll();
+
+private:
+#ifdef PAIMON_OS_UNIX
+  bool addWatch(const std::filesystem::path &directory);
+
+  int m_fd = -1;
+  std::unordered_map<int, std::filesystem::path> m_watches;
+#else
+  std::vector<std::filesystem::path> m_directories;
+  std::map<std::filesystem::path, std::filesystem::file_time_type> m_mtimes;
+  std::chrono::steady_clock::time_point m_lastScan;
+#endif
+};
+
+} // namespace paimon
@@ -0,0 +1,240 @@
+#include "paimon/rendering/texture_upload_queue.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#include <glad/gl.h>
+
+#include "paimon/core/log_system.h"
+
+namespace paimon {
+
+namespace {
+// Pixel unpack offsets are kept aligned for every upload format
+constexpr size_t stagingAlignment = 256;
+
+size_t alignUp(size_t value, size_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+} // namespace
+
+TextureUploadQueue::~TextureUploadQueue() {
+  {
+    std::lock_guard lock(m_mutex);
+    m_stop = true;
+  }
+  m_condition.notify_all();
+  if (m_worker.joinable()) {
+    m_worker.join();
+  }
+}
+
+void TextureUploadQueue::enqueue(TextureUploadRequest request,
+                                 Callback callback) {
+  if (request.width <= 0 || request.height <= 0 || request.components < 1 ||
+      request.components > 4 ||
+      request.pixels.size() < static_cast<size_t>(request.width) *
+                                  request.height * request.components) {
+    LOG_ERROR("TextureUploadQueue: invalid {}x{} image with {} components",
+              request.width, request.height, request.components);
+    return;
+  }
+
+  if (!m_initialized) {
+    initialize();
+  }
+
+  auto job = std::make_unique<Job>();
+  job->size = alignUp(static_cast<size_t>(request.width) * request.height * 4,
+                      stagingAlignment);
+  job->request = std::move(request);
+  job->callback = std::move(callback);
+  m_pending.push_back(std::move(job));
+}
+
+void TextureUploadQueue::update() {
+  if (!m_initialized) {
+    return;
+  }
+
+  // Retire uploads whose fence has signaled, in submission order
+  while (!m_inFlight.empty()) {
+    auto& inFlight = m_inFlight.front();
+    auto status = inFlight.fence.client_wait(0, 0);
+    if (status == GL_TIMEOUT_EXPIRED) {
+      break;
+    }
+    if (status == GL_WAIT_FAILED) {
+      LOG_ERROR("TextureUploadQueue: fence wait failed");
+    }
+
+    const auto& job = *inFlight.job;
+    if (job.ringAllocation) {
+      m_stagingRing.release(*job.ringAllocation);
+    }
+    if (job.callback) {
+      job.callback(std::move(inFlight.texture));
+    }
+    m_inFlight.pop_front();
+  }
+
+  // Submit staged uploads, at least one per frame so that images larger than
+  // the budget still make progress
+  size_t submittedBytes = 0;
+  while (true) {
+    std::unique_ptr<Job> job;
+    {
+      std::lock_guard lock(m_mutex);
+      if (m_staged.empty() ||
+          (submittedBytes > 0 &&
+           submittedBytes + m_staged.front()->size > m_frameBudget)) {
+        break;
+      }
+      job = std::move(m_staged.front());
+      m_staged.pop_front();
+    }
+
+    auto texture = submit(*job);
+    submittedBytes += job->size;
+
+    // The fence is inserted after the copy commands
+    m_inFlight.push_back(InFlight{std::move(job), std::move(texture)});
+  }
+
+  // Reserve staging space and hand pending jobs to the worker
+  bool notify = false;
+  while (!m_pending.empty()) {
+    auto& job = *m_pending.front();
+    if (job.size > m_stagingRing.getCapacity()) {
+      // Too large for the ring, stage in client memory instead
+      job.heapStaging.resize(job.size);
+      job.staging = job.heapStaging.data();
+    } else {
+      auto allocation = m_stagingRing.allocate(job.size);
+      if (!allocation) {
+        break; // ring is full until earlier uploads retire
+      }
+      job.ringAllocation = allocation;
+      job.staging = m_stagingData + allocation->offset;
+    }
+
+    {
+      std::lock_guard lock(m_mutex);
+      m_toStage.push_back(std::move(m_pending.front()));
+      ++m_staging;
+    }
+    m_pending.pop_front();
+    notify = true;
+  }
+  if (notify) {
+    m_condition.notify_one();
+  }
+}
+
+const std::shared_ptr<Texture>& TextureUploadQueue::getFallbackTexture() {
+  if (!m_fallbackTexture) {
+    const uint8_t white[4] = {255, 255, 255, 255};
+    m_fallbackTexture = std::make_shared<Texture>(GL_TEXTURE_2D);
+    m_fallbackTexture->set_storage_2d(1, GL_RGBA8, 1, 1);
+    m_fallbackTexture->set_sub_image_2d(0, 0, 0, 1, 1, GL_RGBA,
+                                        GL_UNSIGNED_BYTE, white);
+  }
+  return m_fallbackTexture;
+}
+
+size_t TextureUploadQueue::getPendingCount() const {
+  std::lock_guard lock(m_mutex);
+  return m_pending.size() + m_staging + m_staged.size() + m_inFlight.size();
+}
+
+void TextureUploadQueue::initialize() {
+  constexpr GLbitfield flags =
+      GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+  m_stagingBuffer = std::make_unique<Buffer>();
+  auto stagingSize = static_cast<GLsizeiptr>(m_stagingRing.getCapacity());
+  m_stagingBuffer->set_storage(stagingSize, nullptr, flags);
+  m_stagingData = static_cast<uint8_t*>(
+      m_stagingBuffer->map_range(0, stagingSize, flags));
+  if (!m_stagingData) {
+    LOG_ERROR("TextureUploadQueue: failed to map staging buffer, uploads "
+              "fall back to client memory");
+    m_stagingRing.reset(0);
+  }
+
+  m_worker = std::thread(&TextureUploadQueue::workerLoop, this);
+  m_initialized = true;
+
+  LOG_INFO("TextureUploadQueue: initialized with {} MiB staging ring",
+           m_stagingRing.getCapacity() >> 20);
+}
+
+std::shared_ptr<Texture> TextureUploadQueue::submit(const Job& job) const {
+  const auto& request = job.request;
+  auto width = static_cast<unsigned>(request.width);
+  auto height = static_cast<unsigned>(request.height);
+  auto levels = static_cast<GLsizei>(std::bit_width(std::max(width, height)));
+
+  auto texture = std::make_shared<Texture>(GL_TEXTURE_2D);
+  texture->set_storage_2d(levels, GL_RGBA8, request.width, request.height);
+
+  if (job.ringAllocation) {
+    // Source the copy from the staging ring
+    auto offset = static_cast<uintptr_t>(job.ringAllocation->offset);
+    m_stagingBuffer->bind(GL_PIXEL_UNPACK_BUFFER);
+    texture->set_sub_image_2d(0, 0, 0, request.width, request.height, GL_RGBA,
+                              GL_UNSIGNED_BYTE,
+                              reinterpret_cast<const void*>(offset));
+    Buffer::unbind(GL_PIXEL_UNPACK_BUFFER);
+  } else {
+    texture->set_sub_image_2d(0, 0, 0, request.width, request.height, GL_RGBA,
+                              GL_UNSIGNED_BYTE, job.heapStaging.data());
+  }
+
+  texture->generate_mipmap();
+  return texture;
+}
+
+void TextureUploadQueue::workerLoop() {
+  while (true) {
+    std::unique_ptr<Job> job;
+    {
+      std::unique_lock lock(m_mutex);
+      m_condition.wait(lock, [this] { return m_stop || !m_toStage.empty(); });
+      if (m_stop) {
+        return;
+      }
+      job = std::move(m_toStage.front());
+      m_toStage.pop_front();
+    }
+
+    // Expand to RGBA8, missing channels read as they would from R8/RG8/RGB8
+    auto& request = job->request;
+    auto pixelCount = static_cast<size_t>(request.width) * request.height;
+    const auto* src = request.pixels.data();
+    auto* dst = job->staging;
+    if (request.components == 4) {
+      std::memcpy(dst, src, pixelCount * 4);
+    } else {
+      for (size_t i = 0; i < pixelCount; ++i) {
+        for (int c = 0; c < 4; ++c) {
+          dst[i * 4 + c] = c < request.components
+                               ? src[i * request.components + c]
+                               : (c == 3 ? 255 : 0);
+        }
+      }
+    }
+
+    // The source pixels are no longer needed
+    request.pixels = {};
+
+    {
+      std::lock_guard lock(m_mutex);
+      m_staged.push_back(std::move(job));
+      --m_staging;
+    }
+  }
+}
+
+} // namespace paimon
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "paimon/opengl/base/object.h"
+#include "paimon/opengl/buffer.h"
+#include "paimon/opengl/texture.h"
+#include "paimon/rendering/ring_allocator.h"
+
+namespace paimon {
+
+// Decoded 8-bit image with 1 to 4 components per pixel
+struct TextureUploadRequest {
+  int width = 0;
+  int height = 0;
+  int components = 4;
+  std::vector<uint8_t> pixels;
+};
+
+// TextureUploadQueue streams textures to the GPU without blocking the render
+// loop. A worker thread converts pixels straight into a persistently mapped
+// staging ring, update() submits staged uploads within a per-frame byte
+// budget, and completion is reported once the upload fence has signaled.
+class TextureUploadQueue {
+public:
+  using Callback = std::function<void(std::shared_ptr<Texture>)>;
+
+  static constexpr size_t DefaultStagingSize = 64u << 20;
+  static constexpr size_t DefaultFrameBudget = 16u << 20;
+
+  TextureUploadQueue() = default;
+  ~TextureUploadQueue();
+
+  // Delete copy constructor and assignment
+  TextureUploadQueue(const TextureUploadQueue&) = delete;
+  TextureUploadQueue& operator=(const TextureUploadQueue&) = delete;
+
+  // Queue an upload, the callback runs on the GL thread from update() once
+  // the texture contents are resident
+  void enqueue(TextureUploadRequest request, Callback callback);
+
+  // Retire finished uploads, submit staged ones and hand new work to the
+  // worker, call once per frame on the GL thread
+  void update();
+
+  // 1x1 white texture to show while an upload is in flight
+  const std::shared_ptr<Texture>& getFallbackTexture();
+
+  void setFrameBudget(size_t bytes) { m_frameBudget = bytes; }
+
+  // Number of uploads not completed yet
+  size_t getPendingCount() const;
+
+private:
+  struct Job {
+    TextureUploadRequest request;
+    Callback callback;
+
+    size_t size = 0;                  // staging size, RGBA8 rounded up
+    std::optional<RingAllocator::Allocation> ringAllocation; // if it fit
+    std::vector<uint8_t> heapStaging; // used when larger than the ring
+    uint8_t* staging = nullptr;
+  };
+
+  struct InFlight {
+    std::unique_ptr<Job> job;
+    std::shared_ptr<Texture> texture;
+    SyncObject fence;
+  };
+
+  void initialize();
+
+  // Create the texture and copy the staged pixels into it
+  std::shared_ptr<Texture> submit(const Job& job) const;
+
+  void workerLoop();
+
+private:
+  bool m_initialized = false;
+  std::shared_ptr<Texture> m_fallbackTexture;
+
+  // Persistently mapped staging ring, space is released in FIFO order as
+  // fences retire
+  std::unique_ptr<Buffer> m_stagingBuffer;
+  uint8_t* m_stagingData = nullptr;
+  RingAllocator m_stagingRing{DefaultStagingSize};
+
+  size_t m_frameBudget = DefaultFrameBudget;
+
+  // GL thread only
+  std::deque<std::unique_ptr<Job>> m_pending;
+  std::deque<InFlight> m_inFlight;
+
+  // Shared with the worker
+  mutable std::mutex m_mutex;
+  std::condition_variable m_condition;
+  std::deque<std::unique_ptr<Job>> m_toStage;
+  std::deque<std::unique_ptr<Job>> m_staged;
+  size_t m_staging = 0; // jobs handed to the worker and not staged yet
+  bool m_stop = false;
+  std::thread m_worker;
+};
+
+} // namespace paimon
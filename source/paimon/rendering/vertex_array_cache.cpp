@@ -1,22 +1,17 @@
 #include "paimon/rendering/vertex_array_cache.h"
 
-#include "paimon/core/hash.h"
 #include "paimon/core/log_system.h"
 
 namespace paimon {
 
-VertexArray* VertexArrayCache::get(const VertexInputState& state) {
-  // Compute hash from VertexInputState
-  std::size_t hash = createHash(state);
-
+VertexArray* VertexArrayCache::get(const VertexInputLayout& layout) {
   // Check if vertex array already exists in cache
-  auto it = m_cache.find(hash);
-  if (it != m_cache.end()) {
-    return it->second.get();
+  if (layout.id < m_cache.size() && m_cache[layout.id]) {
+    return m_cache[layout.id].get();
   }
 
   // Create new vertex array
-  auto vertexArray = createVertexArray(state);
+  auto vertexArray = createVertexArray(layout.state);
   if (!vertexArray) {
     LOG_ERROR("Failed to create vertex array");
     return nullptr;
@@ -28,45 +23,26 @@ VertexArray* VertexArrayCache::get(const VertexInputState& state) {
     return nullptr;
   }
 
+  if (layout.id >= m_cache.size()) {
+    m_cache.resize(layout.id + 1);
+  }
+
   VertexArray* ptr = vertexArray.get();
-  m_cache[hash] = std::move(vertexArray);
+  m_cache[layout.id] = std::move(vertexArray);
+  ++m_cacheSize;
 
-  LOG_INFO("Created and cached new vertex array with hash {} (cache size: {})", 
-           hash, m_cache.size());
+  LOG_INFO("Created and cached new vertex array for layout {} (cache size: {})", 
+           layout.id, m_cacheSize);
 
   return ptr;
 }
 
 void VertexArrayCache::clear() {
   m_cache.clear();
+  m_cacheSize = 0;
   LOG_INFO("Vertex array cache cleared");
 }
 
-std::size_t VertexArrayCache::createHash(const VertexInputState& state) const {
-  std::size_t hash = 0;
-
-  // Hash bindings
-  for (const auto& binding : state.bindings) {
-    hashCombine(hash, 
-                binding.binding, 
-                binding.stride, 
-                binding.divisor);
-  }
-
-  // Hash attributes
-  for (const auto& attribute : state.attributes) {
-    hashCombine(hash,
-                attribute.location,
-                attribute.binding,
-                attribute.format,
-                attribute.size,
-                attribute.offset,
-                attribute.normalized);
-  }
-
-  return hash;
-}
-
 std::unique_ptr<VertexArray> VertexArrayCache::createVertexArray(
     const VertexInputState& state) const {
   auto vertexArray = std::make_unique<VertexArray>();
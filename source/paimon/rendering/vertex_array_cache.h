@@ -1,14 +1,15 @@
 #pragma once
 
 #include <memory>
-#include <unordered_map>
+#include <vector>
 
 #include "paimon/opengl/state/vertex_input.h"
 #include "paimon/opengl/vertex_array.h"
+#include "paimon/rendering/vertex_input_layout.h"
 
 namespace paimon {
 
-// VertexArrayCache manages vertex array objects based on vertex input configurations
+// VertexArrayCache manages vertex array objects based on interned vertex input layouts
 class VertexArrayCache {
 public:
   VertexArrayCache() = default;
@@ -18,25 +19,23 @@ public:
   VertexArrayCache(const VertexArrayCache&) = delete;
   VertexArrayCache& operator=(const VertexArrayCache&) = delete;
 
-  // Get or create a vertex array based on VertexInputState
-  VertexArray* get(const VertexInputState& state);
+  // Get or create the vertex array of a layout
+  VertexArray* get(const VertexInputLayout& layout);
 
   // Clear the cache
   void clear();
 
   // Get cache statistics
-  size_t getCacheSize() const { return m_cache.size(); }
+  size_t getCacheSize() const { return m_cacheSize; }
 
 private:
-  // Compute hash from VertexInputState
-  std::size_t createHash(const VertexInputState& state) const;
-
   // Create a new vertex array from VertexInputState
   std::unique_ptr<VertexArray> createVertexArray(const VertexInputState& state) const;
 
 private:
-  // Cache uses hash value as key
-  std::unordered_map<std::size_t, std::unique_ptr<VertexArray>> m_cache;
+  // Indexed by layout id, so a lookup is a bounds check and a load
+  std::vector<std::unique_ptr<VertexArray>> m_cache;
+  size_t m_cacheSize = 0;
 };
 
 } // namespace paimon
@@ -0,0 +1,58 @@
+#include "paimon/rendering/vertex_input_layout.h"
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "paimon/core/hash.h"
+#include "paimon/core/log_system.h"
+
+namespace paimon {
+
+namespace {
+
+std::size_t createHash(const VertexInputState& state) {
+  std::size_t hash = 0;
+  for (const auto& binding : state.bindings) {
+    hashCombine(hash, binding.binding, binding.stride, binding.divisor);
+  }
+  for (const auto& attribute : state.attributes) {
+    hashCombine(hash, attribute.location, attribute.binding, attribute.format,
+                attribute.size, attribute.offset, attribute.normalized);
+  }
+  return hash;
+}
+
+} // namespace
+
+const VertexInputLayout* VertexInputLayout::intern(const VertexInputState& state) {
+  // Pipelines may be created from any thread holding a context, the table is
+  // locked. Layouts are keyed by hash and compared to resolve collisions, ids
+  // stay dense.
+  static std::mutex mutex;
+  static std::unordered_multimap<std::size_t,
+                                 std::unique_ptr<VertexInputLayout>>
+      layouts;
+
+  auto hash = createHash(state);
+  std::lock_guard lock(mutex);
+
+  auto [first, last] = layouts.equal_range(hash);
+  for (auto it = first; it != last; ++it) {
+    if (it->second->state == state) {
+      return it->second.get();
+    }
+  }
+
+  auto layout = std::make_unique<VertexInputLayout>();
+  layout->id = static_cast<uint32_t>(layouts.size());
+  layout->state = state;
+  auto* result = layouts.emplace(hash, std::move(layout))->second.get();
+
+  LOG_DEBUG("Interned vertex input layout {} ({} bindings, {} attributes)",
+            result->id, state.bindings.size(), state.attributes.size());
+
+  return result;
+}
+
+} // namespace paimon
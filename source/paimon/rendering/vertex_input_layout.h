@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+
+#include "paimon/opengl/state/vertex_input.h"
+
+namespace paimon {
+
+// Interned vertex input layout, pipelines with equal VertexInputStates share
+// one layout and its id indexes the per-context vertex array table
+struct VertexInputLayout {
+  uint32_t id = 0;
+  VertexInputState state;
+
+  // Get or create the layout for a state, the pointer stays valid for the
+  // lifetime of the program. Safe to call from any thread.
+  static const VertexInputLayout* intern(const VertexInputState& state);
+};
+
+} // namespace paimon
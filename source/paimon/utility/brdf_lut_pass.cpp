@@ -14,7 +14,8 @@ BRDFLUTPass::BRDFLUTPass(RenderContext &renderContext)
     : m_renderContext(renderContext) {
   
   // Create quad primitive
-  m_primitive = sg::Primitive::createQuad();
+  m_primitive = sg::Primitive::createQuad(
+      Application::getInstance().getGeometryPool());
   
   // Get shader programs
   auto &shaderManager = Application::getInstance().getShaderManager();
@@ -73,29 +74,25 @@ void BRDFLUTPass::execute(uint32_t lutSize) {
       *m_brdfLUT, AttachmentLoadOp::Clear, AttachmentStoreOp::Store,
       ClearValue::Color(0.0f, 0.0f, 0.0f, 1.0f));
   renderingInfo.depthAttachment.emplace(
-      *m_depthTexture, AttachmentLoadOp::Clear, AttachmentStoreOp::Store,
+      *m_depthTexture, AttachmentLoadOp::Clear, AttachmentStoreOp::DontCare,
       ClearValue::DepthStencil(1.0f, 0));
   
   m_renderContext.beginRendering(renderingInfo);
   m_renderContext.bindPipeline(*m_pipeline);
   
-  // Bind vertex buffers
-  if (m_primitive->positions) {
-    m_renderContext.bindVertexBuffer(0, *m_primitive->positions, 0, sizeof(glm::vec3));
-  }
-  if (m_primitive->texcoords) {
-    m_renderContext.bindVertexBuffer(2, *m_primitive->texcoords, 0, sizeof(glm::vec2));
-  }
-  
-  // Bind index buffer if present
-  if (m_primitive->hasIndices()) {
-    m_renderContext.bindIndexBuffer(*m_primitive->indices, m_primitive->indexType);
-  }
+  // Bind vertex and index buffers of the geometry pool page
+  Application::getInstance().getGeometryPool().bind(m_renderContext,
+                                                    m_primitive->page);
 
   if (m_primitive->hasIndices()) {
-    m_renderContext.drawElements(m_primitive->indexCount, nullptr);
+    m_renderContext.drawElementsBaseVertex(
+        m_primitive->indexCount,
+        reinterpret_cast<const void *>(m_primitive->firstIndex *
+                                       sizeof(uint32_t)),
+        m_primitive->baseVertex);
   } else {
-    m_renderContext.drawArrays(0, m_primitive->vertexCount);
+    m_renderContext.drawArrays(m_primitive->baseVertex,
+                               m_primitive->vertexCount);
   }
   
   m_renderContext.endRendering();
@@ -14,7 +14,8 @@ using namespace paimon;
 EquirectangularToCubemapPass::EquirectangularToCubemapPass(RenderContext &renderContext)
     : m_renderContext(renderContext) {
   // Create cube primitive
-  m_primitive = sg::Primitive::createCube();
+  m_primitive = sg::Primitive::createCube(
+      Application::getInstance().getGeometryPool());
   
   // Get shader programs
   auto &shaderManager = Application::getInstance().getShaderManager();
@@ -51,12 +52,8 @@ EquirectangularToCubemapPass::EquirectangularToCubemapPass(RenderContext &render
     LOG_ERROR("Failed to validate equirectangular to cubemap pipeline");
   }
   
-  m_sampler = std::make_unique<Sampler>();
-  m_sampler->set(GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-  m_sampler->set(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-  m_sampler->set(GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-  m_sampler->set(GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-  m_sampler->set(GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+  m_sampler = Application::getInstance().getSamplerCache().get(
+      SamplerDescriptor::clampToEdge());
 
   // Create uniform buffer
   m_transform_ubo.set_storage(sizeof(CubemapTransformUBO), nullptr, GL_DYNAMIC_STORAGE_BIT);
@@ -105,21 +102,25 @@ void EquirectangularToCubemapPass::execute(
         *m_cubemap, 0, i, AttachmentLoadOp::Clear, AttachmentStoreOp::Store,
         ClearValue::Color(0.0f, 0.0f, 0.0f, 1.0f));
     renderingInfo.depthAttachment.emplace(
-        *m_depthTexture, AttachmentLoadOp::Clear, AttachmentStoreOp::Store,
+        *m_depthTexture, AttachmentLoadOp::Clear, AttachmentStoreOp::DontCare,
         ClearValue::DepthStencil(1.0f, 0));
     
     m_renderContext.beginRendering(renderingInfo);
 
     m_renderContext.bindPipeline(*m_pipeline);
 
-    m_renderContext.bindVertexBuffer(0, *m_primitive->positions, 0, sizeof(glm::vec3));
-    m_renderContext.bindIndexBuffer(*m_primitive->indices, m_primitive->indexType);
+    Application::getInstance().getGeometryPool().bind(m_renderContext,
+                                                      m_primitive->page);
 
     m_renderContext.bindUniformBuffer(0, m_transform_ubo);
   
     m_renderContext.bindTexture(0, equirectangular, *m_sampler);
 
-    m_renderContext.drawElements(m_primitive->indexCount, nullptr);
+    m_renderContext.drawElementsBaseVertex(
+        m_primitive->indexCount,
+        reinterpret_cast<const void *>(m_primitive->firstIndex *
+                                       sizeof(uint32_t)),
+        m_primitive->baseVertex);
 
     m_renderContext.endRendering();
   }  
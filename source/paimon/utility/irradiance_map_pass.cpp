@@ -17,7 +17,8 @@ IrradianceMapPass::IrradianceMapPass(RenderContext &renderContext)
     : m_renderContext(renderContext) {
   
   // Create cube primitive
-  m_primitive = sg::Primitive::createCube();
+  m_primitive = sg::Primitive::createCube(
+      Application::getInstance().getGeometryPool());
   
   // Create UBO for view-projection matrices
   m_ubo = std::make_unique<Buffer>();
@@ -58,12 +59,8 @@ IrradianceMapPass::IrradianceMapPass(RenderContext &renderContext)
     LOG_ERROR("Failed to validate irradiance map pipeline");
   }
 
-  m_sampler = std::make_unique<Sampler>();
-  m_sampler->set(GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-  m_sampler->set(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-  m_sampler->set(GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-  m_sampler->set(GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-  m_sampler->set(GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+  m_sampler = Application::getInstance().getSamplerCache().get(
+      SamplerDescriptor::clampToEdge());
 
   m_irradianceMap = std::make_shared<Texture>(GL_TEXTURE_CUBE_MAP);
   m_depthTexture = std::make_unique<Texture>(GL_TEXTURE_2D);
@@ -108,7 +105,7 @@ void IrradianceMapPass::execute(
         *m_irradianceMap, 0, i, AttachmentLoadOp::Clear, AttachmentStoreOp::Store,
         ClearValue::Color(0.0f, 0.0f, 0.0f, 1.0f));
     renderingInfo.depthAttachment.emplace(
-        *m_depthTexture, AttachmentLoadOp::Clear, AttachmentStoreOp::Store,
+        *m_depthTexture, AttachmentLoadOp::Clear, AttachmentStoreOp::DontCare,
         ClearValue::DepthStencil(1.0f, 0));
     
     m_renderContext.beginRendering(renderingInfo);
@@ -120,20 +117,19 @@ void IrradianceMapPass::execute(
   // Bind uniform buffer
   m_renderContext.bindUniformBuffer(0, *m_ubo);
   
-  // Bind vertex buffer
-  if (m_primitive->positions) {
-    m_renderContext.bindVertexBuffer(0, *m_primitive->positions, 0, sizeof(glm::vec3));
-  }
-  
-  // Bind index buffer if present
-  if (m_primitive->hasIndices()) {
-    m_renderContext.bindIndexBuffer(*m_primitive->indices, m_primitive->indexType);
-  }
+  // Bind vertex and index buffers of the geometry pool page
+  Application::getInstance().getGeometryPool().bind(m_renderContext,
+                                                    m_primitive->page);
 
     if (m_primitive->hasIndices()) {
-      m_renderContext.drawElements(m_primitive->indexCount, nullptr);
+      m_renderContext.drawElementsBaseVertex(
+          m_primitive->indexCount,
+          reinterpret_cast<const void *>(m_primitive->firstIndex *
+                                         sizeof(uint32_t)),
+          m_primitive->baseVertex);
     } else {
-      m_renderContext.drawArrays(0, m_primitive->vertexCount);
+      m_renderContext.drawArrays(m_primitive->baseVertex,
+                                 m_primitive->vertexCount);
     }
     
     m_renderContext.endRendering();
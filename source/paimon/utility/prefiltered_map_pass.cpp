@@ -18,7 +18,8 @@ PrefilteredMapPass::PrefilteredMapPass(RenderContext &renderContext)
     : m_renderContext(renderContext) {
 
   // Create cube primitive
-  m_primitive = sg::Primitive::createCube();
+  m_primitive = sg::Primitive::createCube(
+      Application::getInstance().getGeometryPool());
 
   // Create UBO for view-projection matrices
   m_ubo = std::make_unique<Buffer>();
@@ -64,12 +65,8 @@ PrefilteredMapPass::PrefilteredMapPass(RenderContext &renderContext)
     LOG_ERROR("Failed to validate prefiltered map pipeline");
   }
 
-  m_sampler = std::make_unique<Sampler>();
-  m_sampler->set(GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-  m_sampler->set(GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-  m_sampler->set(GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-  m_sampler->set(GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-  m_sampler->set(GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+  m_sampler = Application::getInstance().getSamplerCache().get(
+      SamplerDescriptor::clampToEdge());
 
   m_prefilteredMap = std::make_shared<Texture>(GL_TEXTURE_CUBE_MAP);
   m_depthTexture = std::make_unique<Texture>(GL_TEXTURE_2D);
@@ -148,7 +145,7 @@ void PrefilteredMapPass::execute(const Texture &envCubemap,
           *m_prefilteredMap, mip, i, AttachmentLoadOp::Clear,
           AttachmentStoreOp::Store, ClearValue::Color(0.0f, 0.0f, 0.0f, 1.0f));
       renderingInfo.depthAttachment.emplace(
-          *m_depthTexture, AttachmentLoadOp::Clear, AttachmentStoreOp::Store,
+          *m_depthTexture, AttachmentLoadOp::Clear, AttachmentStoreOp::DontCare,
           ClearValue::DepthStencil(1.0f, 0));
 
       m_renderContext.beginRendering(renderingInfo);
@@ -159,12 +156,13 @@ void PrefilteredMapPass::execute(const Texture &envCubemap,
       m_renderContext.bindUniformBuffer(0, *m_ubo);
       m_renderContext.bindUniformBuffer(1, *m_paramsUbo);
 
-      m_renderContext.bindVertexBuffer(0, *m_primitive->positions, 0,
-                                       sizeof(glm::vec3));
-
-      m_renderContext.bindIndexBuffer(*m_primitive->indices,
-                                      m_primitive->indexType);
-      m_renderContext.drawElements(m_primitive->indexCount, nullptr);
+      Application::getInstance().getGeometryPool().bind(m_renderContext,
+                                                        m_primitive->page);
+      m_renderContext.drawElementsBaseVertex(
+          m_primitive->indexCount,
+          reinterpret_cast<const void *>(m_primitive->firstIndex *
+                                         sizeof(uint32_t)),
+          m_primitive->baseVertex);
 
       m_renderContext.endRendering();
     }
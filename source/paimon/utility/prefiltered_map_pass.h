@@ -37,7 +37,7 @@ private:
   std::unique_ptr<sg::Primitive> m_primitive;
   std::unique_ptr<GraphicsPipeline> m_pipeline;
 
-  std::unique_ptr<Sampler> m_sampler;
+  std::shared_ptr<const Sampler> m_sampler;
 
   std::shared_ptr<Texture> m_prefilteredMap;
   std::unique_ptr<Texture> m_depthTexture;